@@ -12,8 +12,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <random>
+#include <set>
+#include <vector>
+#include <algorithm>
 #include "../../src/ordinal.h"
 #include "../../src/matrix.h"
+#include "../../src/matrixview.h"
+#include "../../src/sparsecardinal.h"
+#include "../../src/adjacency.h"
+#include "../../src/automorphisms.h"
+#include "../../src/domainfilter.h"
+#include "../../src/graphhomomorphism.h"
+#include "../../src/quotient.h"
+#include "../../src/parallelencoding.h"
+#include "../../src/solutionfile.h"
 #include "../../src/pairindexedscalar.h"
 #include "../../src/minisatsolver.h"
 #include "../../src/manipulators.h"
@@ -30,11 +42,9 @@ int main (int argc, char** argv) {
   // Get arguments
   if ( argc < 3 ) {
     cerr << "Insufficient arguments." << endl;
-    cerr << argv[0] << " <inputfile.mtx> <outputfile.sltn>" << endl;
+    cerr << argv[0] << " <inputfile.mtxb|inputfile.graphml|inputfile.mtx> <outputfile.sltb>" << endl;
     exit(1);
   }
-  ifstream fin(argv[1]);
-  ofstream fout(argv[2]);
 
   MinisatSolver solver;
 
@@ -44,94 +54,138 @@ int main (int argc, char** argv) {
   const int height = 20;
   const int highColor = 1; // used when the code tries to "simplify" the image
 
-  // Read the incidence matrix
+  // Read the incidence matrix: mapped from .mtxb, or parsed from
+  // GraphML or a text .mtx file
   cout << timestamp << " Reading incidence matrix" << endl;
-  int order;
-  fin >> order;
+  const Adjacency incidences = Adjacency::load(argv[1]);
+  const int order = incidences.order();
   cout << "Order is " << order << endl;
-  bool incidences[order][order];
-  for ( int row = 0; row < order; row++ ) {
-    for ( int col = 0; col < order; col++ ) {
-      if ( !fin ) {
-	throw std::runtime_error("Error reading incidence matrix from stream. "
-				 "Corrupted file? "
-				 "Incorrect dimension specification? "
-				 "Non-integer values?");
-      }
-      fin >> incidences[row][col];
-    }
-  }
-
-  // Establish the constraints
-  cout << timestamp << " Establishing basic morphism constraints." << endl;
-  Matrix<Cardinal> morphism(&solver, height, width, 0, order);
-
-  cout << timestamp << " Basic morphism constraints established." << endl;
-  cout << timestamp << " Establishing graph coloring constraints." << endl;
 
-  // Establish horizontally oriented constraints
+  // Solutions go to a binary file, one packed record each.  It is
+  // created up front, so that it exists (with no records) even when
+  // there is no solution.
+  SolutionWriter solutions(argv[2], height, width, max(order-1, 0));
+
+  // Colors with the same neighbors are interchangeable, so cells only
+  // take the smallest color of each class; any coloring found is
+  // then a coloring of the whole target graph as it is.
+  const NeighborhoodQuotient classes(incidences);
+  cout << classes.order() << " classes of interchangeable colors" << endl;
+
+  // Colors allowed in each cell.  The top and bottom rows use at most
+  // color 2 and the middle rows at most color 1; every cell then needs
+  // a compatible color in each neighboring cell, so filter the cell
+  // domains to arc consistency before allocating anything.  Cells of
+  // the periodic top and bottom rows are indexed by their column in
+  // the period.
+  const int topWidth = min(topPeriod, width);
+  const int bottomWidth = min(bottomPeriod, width);
+  auto cellIndex = [&] (int row, int col) {
+    if ( row == 0 ) return col % topWidth;
+    if ( row == height-1 ) return topWidth + (height-2)*width + col % bottomWidth;
+    return topWidth + (row-1)*width + col;
+  };
+
+  cout << timestamp << " Filtering cell domains." << endl;
+  // Colors that may sit next to each color, for the domain filtering
+  // and the support clauses alike
+  const GraphHomomorphism homomorphism(incidences);
+  DomainFilter filter(topWidth + (height-2)*width + bottomWidth, order);
   for ( int row = 0; row < height; row++ ) {
-    for ( int col = 0; col < width-1; col++ ) {
-      for ( int thisColor = 0; thisColor < order; thisColor++ ) {
-	Clause rightClause;
-	Clause leftClause;
-	for ( int otherColor = 0; otherColor < order; otherColor++ ) {
-	  if ( incidences[thisColor][otherColor] ) {
-	    rightClause |= morphism[row][col+1] == otherColor;
-	    leftClause  |= morphism[row][col]   == otherColor;
-	  }
-	}
-	solver.require(implication(morphism[row][col]   == thisColor, rightClause));
-	solver.require(implication(morphism[row][col+1] == thisColor, leftClause));
-      }
+    int limit = order-1;
+    if ( row == 0 || row == height-1 ) limit = 2;
+    if ( row == height/2-1 || row == height/2 ) limit = 1;
+    for ( int col = 0; col < width; col++ ) {
+      filter.restrict(cellIndex(row, col), classes.representatives());
+      filter.bound(cellIndex(row, col), 0, limit);
     }
   }
-
-  // Establish vertically oriented constraints
-  for ( int row = 0; row < height-1; row++ ) {
+  const int adjacent = filter.addRelation(homomorphism.neighborMatrix());
+  for ( int row = 0; row < height; row++ ) {
     for ( int col = 0; col < width; col++ ) {
-      for ( int thisColor = 0; thisColor < order; thisColor++ ) {
-	Clause downClause;
-	Clause upClause;
-	for ( int otherColor = 0; otherColor < order; otherColor++ ) {
-	  if ( incidences[thisColor][otherColor] ) {
-	    downClause |= morphism[row+1][col] == otherColor;
-	    upClause   |= morphism[row]  [col] == otherColor;
-	  }
-	}
-	solver.require(implication(morphism[row]  [col] == thisColor, downClause));
-	solver.require(implication(morphism[row+1][col] == thisColor, upClause));
-      }
+      if ( col < width-1 ) filter.relate(cellIndex(row, col), cellIndex(row, col+1), adjacent);
+      if ( row < height-1 ) filter.relate(cellIndex(row, col), cellIndex(row+1, col), adjacent);
     }
   }
+  if ( !filter.propagate() ) {
+    cout << timestamp << " UNSATISFIABLE (some cell has no possible colors)" << endl;
+    return 0;
+  }
+  cout << filter.numRemoved() << " cell colors filtered out" << endl;
+
+  // Establish the constraints
+  cout << timestamp << " Establishing basic morphism constraints." << endl;
 
-  // // Make the grid periodic horizontally.
-  // for ( int row = 0; row < height; row++ ) {
-  //   for ( int col = 0; col < width; col++ ) {
-  //     solver.require(morphism[row][col] == morphism[row][col+width]);
-  //   }
-  // }
+  // The top and bottom rows are periodic with a much tighter period, so
+  // only one period of each is allocated; periodic views repeat it
+  // across the width of the grid.
+  Matrix<SparseCardinal> topCells(&solver, 1, topWidth, [&] (int row, int col) {
+      return filter.domain(cellIndex(0, col));
+    });
+  Matrix<SparseCardinal> middleCells(&solver, height-2, width, [&] (int row, int col) {
+      return filter.domain(cellIndex(row+1, col));
+    });
+  Matrix<SparseCardinal> bottomCells(&solver, 1, bottomWidth, [&] (int row, int col) {
+      return filter.domain(cellIndex(height-1, col));
+    });
+  MatrixView<SparseCardinal> top = topCells.periodicCols(topCells.width(), width);
+  MatrixView<SparseCardinal> bottom = bottomCells.periodicCols(bottomCells.width(), width);
+
+  // Cell (row, col) of the morphism
+  auto morphism = [&] (int row, int col) -> const SparseCardinal& {
+    if ( row == 0 ) return top[0][col];
+    if ( row == height-1 ) return bottom[0][col];
+    return middleCells.at_unchecked(row-1, col);
+  };
 
-  // Make the top and bottom of the grids periodic with a much tighter period
-  for ( int col = 0; col < width-topPeriod; col++ ) {
-    solver.require(morphism[0][col] == morphism[0][col+topPeriod]);
-  }
+  cout << timestamp << " Basic morphism constraints established." << endl;
 
-  // Make the top and bottom of the grids periodic with a much tighter period
-  for ( int col = 0; col < width-bottomPeriod; col++ ) {
-    solver.require(morphism[height-1][col] == morphism[height-1][col+bottomPeriod]);
+  // Automorphisms of the target that keep the color limits above (and
+  // the choice of representatives) map solutions to solutions, so
+  // keep only the lexicographically least of each family, reading the
+  // allocated cells top to bottom.
+  cout << timestamp << " Breaking value symmetries." << endl;
+  vector<int> limitClasses(order);
+  for ( int color = 0; color < order; color++ ) {
+    limitClasses[color] = (color <= 1 ? 0 : color <= 2 ? 1 : 2) + 
+      (classes.representative(color) == color ? 0 : 3);
   }
-
-  for ( int col = 0; col < width; col++ ) {
-    for ( int row = height/2-1; row < height/2+1; row++ ) {
-      solver.require(morphism[row][col] <= 1);
+  const Automorphisms automorphisms(incidences, limitClasses);
+  cout << automorphisms.size() << " symmetries, from " 
+       << automorphisms.generators().size() << " generators" << endl;
+  vector<SparseCardinal> cellOrder;
+  for ( const Matrix<SparseCardinal>* cells : { &topCells, &middleCells, &bottomCells } ) {
+    for ( unsigned int row = 0; row < cells->height(); row++ ) {
+      for ( unsigned int col = 0; col < cells->width(); col++ ) {
+	cellOrder.push_back(cells->at_unchecked(row, col));
+      }
     }
   }
+  solver.require(valueSymmetryBreaking(&solver, cellOrder, automorphisms));
+  cout << timestamp << " Establishing graph coloring constraints." << endl;
 
-  for ( int col = 0; col < width; col++ ) {
-    solver.require(morphism[0][col] <= 2);
-    solver.require(morphism[height-1][col] <= 2);
-  }
+  // Neighboring cells take adjacent colors, by support clauses built
+  // from the target's neighbor lists.  Within a periodic row, one
+  // period of neighboring pairs covers them all.
+  solver.require(homomorphism.grid(top.restrict(0, 0, 1, min(width, (int)topCells.width()+1))));
+  solver.require(homomorphism.grid(bottom.restrict(0, 0, 1, min(width, (int)bottomCells.width()+1))));
+
+  // The middle rows' horizontal constraints and all the vertically
+  // oriented constraints are generated in parallel, a band of rows
+  // per thread.
+  requireRows(&solver, height, [&] (int row) {
+      Requirement req;
+      if ( row > 0 && row < height-1 ) {
+	req &= homomorphism.horizontalEdges(morphism, row, width);
+      }
+      if ( row < height-1 ) {
+	req &= homomorphism.verticalEdges(morphism, row, width);
+      }
+      return req;
+    });
+
+  // The bounds on the middle, top and bottom rows are part of the
+  // cell domains above.
 
   cout << timestamp << " constraints established.  Solving." << endl;
 
@@ -141,27 +195,36 @@ int main (int argc, char** argv) {
     return 0;
   }
 
-  fout << height << " " << width << endl;
-  fout << morphism << endl << endl;
+  auto colorAt = [&] (int row, int col) { return morphism(row, col).modelValue(); };
+  solutions.writeCells(colorAt);
 
   cout << timestamp << " initial solution found.  Optimizing." << endl;
 
   // Location of a  cell that must be at most highColor.
-  Cardinal reqRow(&solver, 1, height-1);
-  Cardinal reqCol(&solver, 0, width);
-  solver.require(morphism[reqRow][reqCol] <= highColor);
+  // Rows are numbered within middleCells, so inner row r is r-1 here.
+  vector<int> innerRows;
+  for ( int row = 0; row < height-2; row++ ) innerRows.push_back(row);
+  vector<int> allCols;
+  for ( int col = 0; col < width; col++ ) allCols.push_back(col);
+  SparseCardinal reqRow(&solver, innerRows);
+  SparseCardinal reqCol(&solver, allCols);
+  solver.require(middleCells[reqRow][reqCol] <= highColor);
 
   cout << timestamp << " Optimization constraints established.  Beginning solve loop." << endl;
   // Now try and force specific cells to be at most highColor
   while ( true ) {
     for ( int row = 1; row < height-1; row++ ) {
       for ( int col = 0; col < width; col++ ) {
-  	auto val = morphism[row][col].modelValue();
+  	auto val = morphism(row, col).modelValue();
   	if ( val <= highColor ) {
-	  solver.require(morphism[row][col] <= highColor);
+	  // As unit requirements, so that the solver can fold them
+	  // into later clauses.
+	  for ( int color = highColor+1; color < order; color++ ) {
+	    solver.require(morphism(row, col) != color);
+	  }
 
   	  // Also make sure that some new cell must be at most highcolor.
-  	  solver.require(reqRow != row | reqCol != col);
+  	  solver.require(reqRow != row-1 | reqCol != col);
   	}
       }
     }
@@ -171,8 +234,7 @@ int main (int argc, char** argv) {
     }
 
     cout << timestamp << " Solution found" << endl;
-    fout << height << " " << width << endl;
-    fout << morphism << endl << endl;
+    solutions.writeCells(colorAt);
   }
 
   cout << timestamp << " All solutions found." << endl;
@@ -13,6 +13,7 @@
 #include <stdlib.h>
 #include <random>
 #include "../../src/cardinal.h"
+#include "../../src/alldifferent.h"
 #include "../../src/matrix.h"
 #include "../../src/minisatsolver.h"
 #include "../../src/manipulators.h"
@@ -66,34 +67,30 @@ int main (int argc, char** argv) {
 
   // In any row, no two elements may be equal
   for ( int row = 0; row < 9; row++ ) {
-    for ( int elem1 = 0; elem1 < 9; elem1++ ) {
-      for ( int elem2 = elem1+1; elem2 < 9; elem2++ ) {
-	solver.require(puzzle[row][elem1] != puzzle[row][elem2]);
-      }
+    vector<Cardinal> cells;
+    for ( int col = 0; col < 9; col++ ) {
+      cells.push_back(puzzle[row][col]);
     }
+    solver.require(allDifferent(cells));
   }
 
   // In any column, no two elements may be equal
   for ( int col = 0; col < 9; col++ ) {
-    for ( int elem1 = 0; elem1 < 9; elem1++ ) {
-      for ( int elem2 = elem1+1; elem2 < 9; elem2++ ) {
-	solver.require(puzzle[elem1][col] != puzzle[elem2][col]);
-      }
+    vector<Cardinal> cells;
+    for ( int row = 0; row < 9; row++ ) {
+      cells.push_back(puzzle[row][col]);
     }
+    solver.require(allDifferent(cells));
   }
   
   // In any 3x3 square, no two elements may be equal
   for ( int boxRow = 0; boxRow < 9; boxRow += 3 ) {
     for ( int boxCol = 0; boxCol < 9; boxCol += 3 ) {
-      for ( int boxIdx1 = 0; boxIdx1 < 9; boxIdx1++ ) {
-	for ( int boxIdx2 = boxIdx1+1; boxIdx2 < 9; boxIdx2++ ) {
-	  int row1 = boxRow + boxIdx1/3;
-	  int col1 = boxCol + boxIdx1%3;
-	  int row2 = boxRow + boxIdx2/3;
-	  int col2 = boxCol + boxIdx2%3;
-	  solver.require(puzzle[row1][col1] != puzzle[row2][col2]);
-	}
+      vector<Cardinal> cells;
+      for ( int boxIdx = 0; boxIdx < 9; boxIdx++ ) {
+	cells.push_back(puzzle[boxRow + boxIdx/3][boxCol + boxIdx%3]);
       }
+      solver.require(allDifferent(cells));
     }
   }
 
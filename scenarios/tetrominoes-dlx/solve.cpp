@@ -0,0 +1,58 @@
+// Solve.cpp
+//
+// Tiles a 5x8 grid with two each of the five free tetrominoes, as the
+// tetrominoes scenario does, but by dancing links instead of SAT:
+// prints the first five tilings, then counts them all on every
+// hardware thread.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "../../src/pattern.h"
+#include "../../src/tiling.h"
+#include "../../src/manipulators.h"
+using namespace std;
+
+const string pieces[5] = {
+  "x x ; x x ;",     // Box
+  "x x x ; . x . ;", // Tee
+  "x x x x ;",       // Straight
+  "x x x ; x . . ;", // Ell
+  "x x . ; . x x ;", // Skew
+};
+/////////////////////////////////////////////////////////////////////
+//
+//  main
+//
+int main (int argc, char** argv) {
+  cout << timestamp << " Establishing exact cover problem" << endl;
+
+  // Pieces 2k and 2k+1 are copies of the same tetromino, each with its
+  // own color, as in the tetrominoes scenario.
+  vector<Pattern> tetrominoes;
+  for ( int piece = 0; piece < 10; piece++ ) {
+    tetrominoes.push_back(Pattern(pieces[piece/2]));
+  }
+  Tiling tiling(tetrominoes, 5, 8);
+
+  cout << timestamp << " " << tiling.problem().numRows() << " placements" << endl;
+
+  const int numSolns = 5;
+  int found = 0;
+  tiling.problem().solve([&] (const vector<int>& rows) {
+      cout << timestamp << " Solution " << found << " found: " << endl;
+      Array2d<int> labels = tiling.labels(rows);
+      for ( int row = 0; row < tiling.height(); row++ ) {
+	for ( int col = 0; col < tiling.width(); col++ ) {
+	  cout << labels[row][col] << " ";
+	}
+	cout << endl;
+      }
+      cout << endl;
+      return ++found < numSolns;
+    });
+
+  cout << timestamp << " First " << found << " solutions found.  Counting all of them." << endl;
+  unsigned long count = tiling.problem().count(0);
+  cout << timestamp << " Done.  " << count << " solutions in all." << endl;
+}
@@ -14,33 +14,18 @@
 #include <random>
 #include "../../src/cardinal.h"
 #include "../../src/matrix.h"
-#include "../../src/matrixview.h"
-#include "../../src/pairindexedscalar.h"
+#include "../../src/pattern.h"
+#include "../../src/placements.h"
 #include "../../src/minisatsolver.h"
 #include "../../src/manipulators.h"
 using namespace std;
 
-const string pieces[5][2] = {
-  {
-    "XX  ", // Box
-    "XX  ",
-  }, 
-  {
-    "XXX ", // Tee
-    " X  ",
-  }, 
-  {
-    "XXXX", // Straight
-    "    ",
-  }, 
-  {
-    "XXX ", // Ell
-    "X   ",
-  }, 
-  {
-    "XX  ", // Skew
-    " XX ",
-  },
+const string pieces[5] = {
+  "x x ; x x ;",     // Box
+  "x x x ; . x . ;", // Tee
+  "x x x x ;",       // Straight
+  "x x x ; x . . ;", // Ell
+  "x x . ; . x x ;", // Skew
 };
 /////////////////////////////////////////////////////////////////////
 //
@@ -58,40 +43,15 @@ int main (int argc, char** argv) {
 			  5, 8, 
 			  0, 10);
 
-  // Setup requirements for each piece
+  // Setup requirements for each piece.  Only the placements that fit
+  // on the board get a selector, one per distinct orientation and
+  // position; the piece takes exactly one of them, and marks the cells
+  // it covers with its color.
+  auto cell = [&] (int row, int col) -> const Cardinal& { return puzzle[row][col]; };
   for ( int piece = 0; piece < 10; piece++ ) {
-    // "row" and "col" refer to the upper-left corner of the piece
-    // we're placing.  The bounds, [0,9) large enough to express all
-    // positions in a 5x8 (or 8x5 as below) grid.
-    Cardinal row(&solver,0,9);
-    Cardinal col(&solver,0,9);
-
-    // "transform" selects which transform of the piece is being used.
-    Cardinal transform(&solver,0,8);
-
-    // Loop through all the possible transforms and set up the requisite condition for each.
-    for ( int transCount = 0; transCount < 8; transCount++ ) {
-      //  Transforming the board is easier than transforming the
-      //  pieces, so we transform the board.
-      auto view = (transCount & 0x1) ? puzzle.reflectV() : puzzle;
-      view      = (transCount & 0x2) ? view.reflectH()   : view;
-      view      = (transCount & 0x4) ? view.transpose()  : view;
-
-      // Build the requirement for the given piece to be in the given position
-      Requirement req;
-
-      // i and j index individual squares of the piece; a piece is an
-      // array of two strings of length 4, hence the bounds on i and j
-      for ( int i = 0; i < 2; i++ ) {
-	for ( int j = 0; j < 4; j++ ) {
-	  if ( pieces[piece/2][i][j] == 'X' ) {
-	    req &= view[row+i][col+j] == piece;
-	  }
-	}
-      }
-
-      solver.require(implication(transform == transCount, req));
-    }
+    Placements placements(&solver, Pattern(pieces[piece/2]), puzzle.height(), puzzle.width());
+    solver.require(placements.exactlyOne());
+    solver.require(placements.cover(cell, piece));
   }
 
   cout << timestamp << " Constraints established" << endl;
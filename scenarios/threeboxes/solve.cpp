@@ -12,9 +12,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <random>
+#include <algorithm>
+#include "../../src/adjacency.h"
+#include "../../src/graphhomomorphism.h"
 #include "../../src/ordinal.h"
 #include "../../src/matrix.h"
+#include "../../src/compactmatrix.h"
 #include "../../src/pairindexedscalar.h"
+#include "../../src/solutionfile.h"
 #include "../../src/minisatsolver.h"
 #include "../../src/manipulators.h"
 #include "../../src/ordinaladdexpr.h"
@@ -30,11 +35,9 @@ int main (int argc, char** argv) {
   // Get arguments
   if ( argc < 3 ) {
     cerr << "Insufficient arguments." << endl;
-    cerr << argv[0] << " <inputfile.mtx> <outputfile.sltn>" << endl;
+    cerr << argv[0] << " <inputfile.mtxb|inputfile.mtx> <outputfile.sltb>" << endl;
     exit(1);
   }
-  ifstream fin(argv[1]);
-  ofstream fout(argv[2]);
 
   MinisatSolver solver;
 
@@ -47,64 +50,25 @@ int main (int argc, char** argv) {
 
   // Read the incidence matrix
   cout << timestamp << " Reading incidence matrix" << endl;
-  int order;
-  fin >> order;
+  const Adjacency incidences = Adjacency::load(argv[1]);
+  const int order = incidences.order();
   cout << "Order is " << order << endl;
-  bool incidences[order][order];
-  for ( int row = 0; row < order; row++ ) {
-    for ( int col = 0; col < order; col++ ) {
-      if ( !fin ) {
-	throw std::runtime_error("Error reading incidence matrix from stream. "
-				 "Corrupted file? "
-				 "Incorrect dimension specification? "
-				 "Non-integer values?");
-      }
-      fin >> incidences[row][col];
-    }
-  }
+
+  // Solutions go to a binary file, one packed record each.  It is
+  // created up front, so that it exists (with no records) even when
+  // there is no solution.  Cells take values in [0, order).
+  SolutionWriter solutions(argv[2], height, width, max(order-1, 0));
 
   // Establish the constraints
   cout << timestamp << " Establishing basic morphism constraints." << endl;
-  Matrix<Scalar> morphism(&solver, height, width, 0, order);
+  CompactMatrix<Scalar> morphism(&solver, height, width, 0, order);
 
   cout << timestamp << " Basic morphism constraints established." << endl;
   cout << timestamp << " Establishing graph coloring constraints." << endl;
 
-  // Establish horizontally oriented constraints
-  for ( int row = 0; row < height; row++ ) {
-    for ( int col = 0; col < width-1; col++ ) {
-      for ( int thisColor = 0; thisColor < order; thisColor++ ) {
-	Requirement rightClause = Clause();
-	Requirement leftClause = Clause();
-	for ( int otherColor = 0; otherColor < order; otherColor++ ) {
-	  if ( incidences[thisColor][otherColor] ) {
-	    rightClause |= morphism[row][col+1] == otherColor;
-	    leftClause  |= morphism[row][col]   == otherColor;
-	  }
-	}
-	solver.require(implication(morphism[row][col]   == thisColor, rightClause));
-	solver.require(implication(morphism[row][col+1] == thisColor, leftClause));
-      }
-    }
-  }
-
-  // Establish vertically oriented constraints
-  for ( int row = 0; row < height-1; row++ ) {
-    for ( int col = 0; col < width; col++ ) {
-      for ( int thisColor = 0; thisColor < order; thisColor++ ) {
-	Requirement downClause = Clause();
-	Requirement upClause = Clause();
-	for ( int otherColor = 0; otherColor < order; otherColor++ ) {
-	  if ( incidences[thisColor][otherColor] ) {
-	    downClause |= morphism[row+1][col] == otherColor;
-	    upClause   |= morphism[row]  [col] == otherColor;
-	  }
-	}
-	solver.require(implication(morphism[row]  [col] == thisColor, downClause));
-	solver.require(implication(morphism[row+1][col] == thisColor, upClause));
-      }
-    }
-  }
+  // Establish horizontally and vertically oriented constraints:
+  // neighboring cells take adjacent colors.
+  solver.require(GraphHomomorphism(incidences).grid(morphism));
 
   // // Make the grid periodic horizontally.
   // for ( int row = 0; row < height; row++ ) {
@@ -142,8 +106,7 @@ int main (int argc, char** argv) {
     return 0;
   }
 
-  fout << height << " " << width << endl;
-  fout << morphism << endl << endl;
+  solutions.write(morphism);
 
   cout << timestamp << " initial solution found.  Optimizing." << endl;
 
@@ -172,8 +135,7 @@ int main (int argc, char** argv) {
     }
 
     cout << timestamp << " Solution found" << endl;
-    fout << height << " " << width << endl;
-    fout << morphism << endl << endl;
+    solutions.write(morphism);
   }
 
   cout << timestamp << " All solutions found." << endl;
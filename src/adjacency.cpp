@@ -0,0 +1,260 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of Adjacency.
+
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "adjacency.h"
+#include "graphml.h"
+
+using namespace std;
+
+namespace {
+struct Header {
+  char magic[4];
+  uint32_t version;
+  uint64_t order;
+  uint64_t wordsPerRow;
+};
+static_assert(sizeof(Header) == 24, "unexpected .mtxb header padding");
+
+const char magic[4] = { 'M', 'T', 'X', 'B' };
+const uint32_t version = 1;
+
+int wordsFor(int order) {
+  return (order + Adjacency::bitsPerWord - 1) / Adjacency::bitsPerWord;
+}
+
+bool endsWith(const string& text, const string& suffix) {
+  return text.size() >= suffix.size() && 
+    text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+[[noreturn]] void systemError(const string& path, const string& what) {
+  throw runtime_error(path + ": " + what + ": " + strerror(errno));
+}
+
+// Unmaps a read-only file mapping
+struct Mapping {
+  void* address;
+  size_t length;
+  ~Mapping() { munmap(address, length); }
+};
+}
+
+Adjacency::Adjacency() :
+  mOrder(0),
+  mWordsPerRow(0),
+  mWords(nullptr)
+{
+  ; // This function has no body, just an initializer list.
+}
+
+Adjacency::Adjacency(const vector<vector<bool> >& incidences) :
+  mOrder(incidences.size()),
+  mWordsPerRow(wordsFor(incidences.size()))
+{
+  auto words = make_shared<vector<word_type> >(size_t(mOrder)*mWordsPerRow, 0);
+  for ( int src = 0; src < mOrder; src++ ) {
+    if ( incidences[src].size() != incidences.size() ) {
+      throw invalid_argument("Incidence matrix is not square");
+    }
+    for ( int dst = 0; dst < mOrder; dst++ ) {
+      if ( incidences[src][dst] ) {
+	(*words)[size_t(src)*mWordsPerRow + dst/bitsPerWord] |= word_type(1) << (dst % bitsPerWord);
+      }
+    }
+  }
+  mWords = words->data();
+  mStorage = words;
+}
+
+Adjacency Adjacency::load(const string& path) {
+  if ( endsWith(path, ".mtxb") ) {
+    return map(path);
+  }
+
+  ifstream in(path);
+  if ( !in ) {
+    throw runtime_error("Cannot open " + path);
+  }
+  if ( endsWith(path, ".graphml") ) {
+    return Adjacency(GraphML(in).incidences());
+  }
+  return readMatrix(in);
+}
+
+Adjacency Adjacency::map(const string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if ( fd < 0 ) {
+    systemError(path, "cannot open");
+  }
+  struct stat info;
+  if ( fstat(fd, &info) != 0 ) {
+    close(fd);
+    systemError(path, "cannot stat");
+  }
+  size_t length = info.st_size;
+  if ( length < sizeof(Header) ) {
+    close(fd);
+    throw runtime_error(path + ": truncated .mtxb header");
+  }
+  void* address = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if ( address == MAP_FAILED ) {
+    systemError(path, "cannot map");
+  }
+  shared_ptr<Mapping> mapping(new Mapping{address, length});
+
+  const Header* header = static_cast<const Header*>(address);
+  if ( memcmp(header->magic, magic, sizeof(magic)) != 0 ) {
+    throw runtime_error(path + ": not an .mtxb file");
+  }
+  if ( header->version != version ) {
+    throw runtime_error(path + ": unsupported .mtxb version");
+  }
+  if ( header->order > uint64_t(INT32_MAX) || 
+       header->wordsPerRow != uint64_t(wordsFor(header->order)) ) {
+    throw runtime_error(path + ": inconsistent .mtxb header");
+  }
+  if ( (length - sizeof(Header)) / sizeof(word_type) / max<uint64_t>(header->wordsPerRow, 1) < header->order ) {
+    throw runtime_error(path + ": truncated .mtxb rows");
+  }
+
+  Adjacency result;
+  result.mOrder = header->order;
+  result.mWordsPerRow = header->wordsPerRow;
+  result.mWords = reinterpret_cast<const word_type*>(header + 1);
+  result.mStorage = mapping;
+
+  // Bits past the order would otherwise show up as neighbors.
+  if ( result.mOrder % bitsPerWord != 0 ) {
+    const word_type padding = ~word_type(0) << (result.mOrder % bitsPerWord);
+    for ( int src = 0; src < result.mOrder; src++ ) {
+      if ( result.row(src)[result.mWordsPerRow-1] & padding ) {
+	throw runtime_error(path + ": .mtxb row padding is not zero");
+      }
+    }
+  }
+  return result;
+}
+
+Adjacency Adjacency::readMatrix(istream& in) {
+  int order;
+  in >> order;
+  if ( !in || order < 0 ) {
+    throw runtime_error("Error reading incidence matrix order from stream.");
+  }
+  vector<vector<bool> > incidences(order, vector<bool>(order));
+  for ( int row = 0; row < order; row++ ) {
+    for ( int col = 0; col < order; col++ ) {
+      int incident;
+      in >> incident;
+      if ( !in ) {
+	throw runtime_error("Error reading incidence matrix from stream. "
+			    "Corrupted file? "
+			    "Incorrect dimension specification? "
+			    "Non-integer values?");
+      }
+      incidences[row][col] = (incident != 0);
+    }
+  }
+  return Adjacency(incidences);
+}
+
+void Adjacency::write(ostream& out) const {
+  Header header;
+  memcpy(header.magic, magic, sizeof(magic));
+  header.version = version;
+  header.order = mOrder;
+  header.wordsPerRow = mWordsPerRow;
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char*>(mWords), sizeof(word_type)*size_t(mOrder)*mWordsPerRow);
+}
+
+int Adjacency::order() const {
+  return mOrder;
+}
+
+int Adjacency::wordsPerRow() const {
+  return mWordsPerRow;
+}
+
+bool Adjacency::adjacent(int src, int dst) const {
+  checkVertex(dst);
+  return (row(src)[dst/bitsPerWord] >> (dst % bitsPerWord)) & 1;
+}
+
+int Adjacency::degree(int src) const {
+  const word_type* words = row(src);
+  int result = 0;
+  for ( int index = 0; index < mWordsPerRow; index++ ) {
+    result += __builtin_popcountll(words[index]);
+  }
+  return result;
+}
+
+const Adjacency::word_type* Adjacency::row(int src) const {
+  checkVertex(src);
+  return mWords + size_t(src)*mWordsPerRow;
+}
+
+vector<int> Adjacency::neighbors(int src) const {
+  vector<int> result;
+  result.reserve(degree(src));
+  forEachNeighbor(src, [&] (int dst) { result.push_back(dst); });
+  return result;
+}
+
+vector<vector<bool> > Adjacency::incidences() const {
+  vector<vector<bool> > result(mOrder, vector<bool>(mOrder));
+  for ( int src = 0; src < mOrder; src++ ) {
+    forEachNeighbor(src, [&] (int dst) { result[src][dst] = true; });
+  }
+  return result;
+}
+
+Adjacency Adjacency::transpose() const {
+  vector<vector<bool> > reversed(mOrder, vector<bool>(mOrder));
+  for ( int src = 0; src < mOrder; src++ ) {
+    forEachNeighbor(src, [&] (int dst) { reversed[dst][src] = true; });
+  }
+  return Adjacency(reversed);
+}
+
+void Adjacency::checkVertex(int vertex) const {
+  if ( vertex < 0 || vertex >= mOrder ) {
+    ostringstream sout;
+    sout << "Vertex " << vertex << " out of range for a graph of order " << mOrder;
+    throw out_of_range(sout.str());
+  }
+}
@@ -0,0 +1,115 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// A graph's adjacency matrix as packed bitset rows.
+//
+// Row src holds bit dst of word dst/64 when src -> dst is an edge;
+// bits past the order are zero.  Neighbors are visited a word at a
+// time and degrees are popcounts, so dense target graphs cost one bit
+// per entry rather than a bool (or a stream extraction) each.
+//
+// An Adjacency is read from any of the formats in data/:
+//
+//  * .mtxb: the binary format below, mapped read-only with mmap and
+//    used in place.  Nothing is parsed or copied; loading only checks
+//    the padding bits of each row's last word, so it touches one word
+//    per row.
+//  * .graphml: parsed with GraphML.
+//  * .mtx (anything else): the text incidence matrix.
+//
+// The .mtxb layout is a 24-byte header -- the magic "MTXB", a uint32
+// version (1), a uint64 order and a uint64 words-per-row -- followed
+// by order * words-per-row uint64 row words, all in native byte order.
+//
+// Copies share the underlying storage, which is never modified.
+
+#ifndef ADJACENCY_H
+#define ADJACENCY_H
+
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Adjacency {
+public:
+  typedef std::uint64_t word_type;
+  static const int bitsPerWord = 64;
+
+  // The empty graph
+  Adjacency();
+  explicit Adjacency(const std::vector<std::vector<bool> >& incidences);
+
+  // Read by file suffix, as above.  Throw std::runtime_error on
+  // unreadable or malformed files.
+  static Adjacency load(const std::string& path);
+  static Adjacency map(const std::string& path);
+  static Adjacency readMatrix(std::istream& in);
+
+  // Write the .mtxb format
+  void write(std::ostream& out) const;
+
+  int order() const;
+  int wordsPerRow() const;
+
+  bool adjacent(int src, int dst) const;
+  int degree(int src) const;
+
+  // The packed words of a row
+  const word_type* row(int src) const;
+
+  // Calls visit(dst) for each dst adjacent from src, in increasing order
+  template<class Visitor>
+  void forEachNeighbor(int src, Visitor visit) const;
+  std::vector<int> neighbors(int src) const;
+
+  std::vector<std::vector<bool> > incidences() const;
+
+  // The graph with every edge reversed
+  Adjacency transpose() const;
+
+private:
+  void checkVertex(int vertex) const;
+
+  int mOrder;
+  int mWordsPerRow;
+  const word_type* mWords;
+  // Owns mWords: a vector for graphs built in memory, or a mapping
+  std::shared_ptr<const void> mStorage;
+};
+
+template<class Visitor>
+void Adjacency::forEachNeighbor(int src, Visitor visit) const {
+  const word_type* words = row(src);
+  for ( int index = 0; index < mWordsPerRow; index++ ) {
+    word_type word = words[index];
+    while ( word != 0 ) {
+      visit(index*bitsPerWord + __builtin_ctzll(word));
+      word &= word - 1;
+    }
+  }
+}
+
+#endif // ADJACENCY_H
@@ -0,0 +1,113 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of allDifferent()
+
+#include <algorithm>
+#include <stdexcept>
+#include "alldifferent.h"
+#include "pseudoboolean.h"
+
+using namespace std;
+
+Requirement allDifferent(const vector<Cardinal>& cards, bool hallIntervals) {
+  Requirement result;
+
+  if ( cards.empty() ) {
+    return result;
+  }
+
+  Solver* solver = cards.front().solver();
+  int lo = cards.front().min();
+  int hi = cards.front().max();
+  for ( const Cardinal& card : cards ) {
+    if ( card.solver() != solver ) {
+      throw invalid_argument("allDifferent requires all Cardinals to share a solver.");
+    }
+    lo = std::min(lo, card.min());
+    hi = std::max(hi, card.max());
+  }
+
+  // The pigeonhole principle, up front.
+  if ( hi - lo < cards.size() ) {
+    return Clause(); // FALSE
+  }
+
+  // Each value is taken at most once.
+  for ( int value = lo; value < hi; value++ ) {
+    vector<Literal> takers;
+    for ( const Cardinal& card : cards ) {
+      Atom atm = card == value;
+      if ( atm.isLiteral() ) {
+	takers.push_back(atm.getLiteral());
+      }
+    }
+    result &= atMostOne(solver, takers);
+  }
+
+  // If there are exactly as many values as Cardinals, every value must
+  // be taken by someone.
+  if ( hi - lo == cards.size() ) {
+    for ( int value = lo; value < hi; value++ ) {
+      Clause someoneTakes;
+      for ( const Cardinal& card : cards ) {
+	someoneTakes |= card == value;
+      }
+      result &= move(someoneTakes);
+    }
+  }
+
+  if ( !hallIntervals ) {
+    return result;
+  }
+
+  // Hall intervals: at most (last-first+1) Cardinals take values in
+  // [first, last].  Intervals of one value are handled above, and
+  // intervals at least as wide as the group are trivial.
+  for ( int first = lo; first < hi; first++ ) {
+    for ( int last = first+1; last < hi && last-first+1 < cards.size(); last++ ) {
+      PseudoBoolean inInterval(solver);
+
+      for ( const Cardinal& card : cards ) {
+	int start = std::max(first, card.min());
+	int end   = std::min(last+1, card.max());
+	if ( start >= end ) {
+	  continue;
+	}
+
+	// One literal standing for "card is in the interval".  Only the
+	// implication into it is needed for an upper bound.
+	Literal inside(solver->newVars(1));
+	for ( int value = start; value < end; value++ ) {
+	  result &= implication(card == value, inside);
+	}
+	inInterval.add(1, inside);
+      }
+
+      result &= inInterval <= last-first+1;
+    }
+  }
+
+  return result;
+}
@@ -0,0 +1,62 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// The AllDifferent global constraint over Cardinals.
+//
+// Requiring every pair of Cardinals in a group to be nonequal costs a
+// clause per shared value per pair, i.e., quadratically many clauses.
+// allDifferent() instead requires, for each value, that at most one
+// Cardinal take that value, using a sequential at-most-one encoding
+// (linear in the number of Cardinals) when there are enough of them
+// to make it pay off.
+//
+// When the Cardinals together can take exactly as many values as there
+// are Cardinals, the group must be a permutation, so "each value is
+// used" clauses are added too; these propagate much better in
+// Latin-square-like problems.  Optionally, Hall-interval clauses (at
+// most k Cardinals take values in any interval of k values) can be
+// added as well.
+
+#ifndef ALLDIFFERENT_H
+#define ALLDIFFERENT_H
+
+#include <vector>
+#include "requirement.h"
+#include "cardinal.h"
+
+// Auxiliary variables are allocated through the solver of the
+// Cardinals, which must all share one solver.
+Requirement allDifferent(const std::vector<Cardinal>& cards, bool hallIntervals = false);
+
+// Any other container (or view) of Cardinals that supports range-for.
+template<class Container>
+Requirement allDifferent(const Container& container, bool hallIntervals = false) {
+  std::vector<Cardinal> cards;
+  for ( const Cardinal& card : container ) {
+    cards.push_back(card);
+  }
+  return allDifferent(cards, hallIntervals);
+}
+
+#endif // ALLDIFFERENT_H
@@ -38,11 +38,17 @@
 #include <stdexcept>
 #include <initializer_list>
 
-template<typename _return_type, typename _size_type = std::vector<int>::size_type>
+// Returned by the first subscript of a 2d container; the second
+// subscript calls the accessor.  Containers supply their own small
+// accessor types so that double indexing inlines to plain arithmetic;
+// the std::function default remains for ad hoc closures.
+template<typename _return_type, 
+	 typename _size_type = std::vector<int>::size_type,
+	 typename _functor_type = std::function<_return_type(_size_type)> >
 class SubscriptWrapper {
 public:
   typedef _size_type size_type;
-  typedef std::function<_return_type(_size_type)> functor_type;
+  typedef _functor_type functor_type;
   
   SubscriptWrapper(const functor_type functor);
 
@@ -52,18 +58,31 @@ private:
   functor_type functor;
 };
 
-template<typename return_type, typename size_type>
-SubscriptWrapper<return_type, size_type>::SubscriptWrapper(const functor_type _functor) :
+template<typename return_type, typename size_type, typename functor_type>
+SubscriptWrapper<return_type, size_type, functor_type>::SubscriptWrapper(const functor_type _functor) :
   functor(_functor)
 {
 
 }
 
-template<typename return_type, typename size_type>
-return_type SubscriptWrapper<return_type, size_type>::operator[](size_type index) const {
+template<typename return_type, typename size_type, typename functor_type>
+inline return_type SubscriptWrapper<return_type, size_type, functor_type>::operator[](size_type index) const {
   return functor(index);
 }
 
+// Accessor for one row of a row-major vector.
+template<typename vector_type, typename return_type>
+struct VectorRowAccess {
+  typedef typename std::vector<int>::size_type size_type;
+
+  vector_type* data;
+  size_type offset;
+
+  return_type operator()(size_type col) const {
+    return (*data)[offset + col];
+  }
+};
+
 template<class T>
 class Array2d {
 public:
@@ -76,8 +95,13 @@ public:
   Array2d(size_type height, size_type width);
   Array2d(std::initializer_list<std::initializer_list<T>> initList);
 
-  SubscriptWrapper<reference, size_type> operator[] (size_type row);
-  SubscriptWrapper<const_reference, size_type> operator[] (size_type row) const;
+  typedef SubscriptWrapper<reference, size_type, 
+			   VectorRowAccess<std::vector<T>, reference> > row_type;
+  typedef SubscriptWrapper<const_reference, size_type, 
+			   VectorRowAccess<const std::vector<T>, const_reference> > const_row_type;
+
+  row_type operator[] (size_type row);
+  const_row_type operator[] (size_type row) const;
 
   void swap(Array2d<T>& other);
 
@@ -130,22 +154,15 @@ Array2d<T>::Array2d(std::initializer_list<std::initializer_list<T>> initList) :
 
 
 template<class T>
-SubscriptWrapper<typename Array2d<T>::reference, typename Array2d<T>::size_type> 
-Array2d<T>::operator[] (size_type row) {
+typename Array2d<T>::row_type Array2d<T>::operator[] (size_type row) {
   // Return an object whose subscript operator returns row*width + col
-  auto lambda = [=] (size_type col)  -> reference {
-    return this->m_data.begin()[row*this->m_width + col];
-  };
-  return SubscriptWrapper<reference, size_type>(lambda);
+  return row_type({&m_data, row*m_width});
 }
 
 template<class T>
-SubscriptWrapper<typename Array2d<T>::const_reference, typename Array2d<T>::size_type> Array2d<T>::operator[] (size_type row) const {
+typename Array2d<T>::const_row_type Array2d<T>::operator[] (size_type row) const {
   // Return an object whose subscript operator returns row*width + col
-  auto lambda = [=] (size_type col)  -> const_reference {
-    return this->m_data.begin()[row*this->m_width + col];
-  };
-  return SubscriptWrapper<const_reference, size_type>(lambda);
+  return const_row_type({&m_data, row*m_width});
 }
 
 
@@ -0,0 +1,311 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of Automorphisms: partition refinement and the
+// first-path search.
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include "automorphisms.h"
+
+using namespace std;
+
+namespace {
+// An ordered partition of the vertices
+typedef vector<vector<int> > Partition;
+
+// Smallest vertex of each set, with path compression
+class DisjointSets {
+public:
+  explicit DisjointSets(int size) : mParent(size) {
+    iota(mParent.begin(), mParent.end(), 0);
+  }
+  int find(int element) {
+    while ( mParent[element] != element ) {
+      mParent[element] = mParent[mParent[element]];
+      element = mParent[element];
+    }
+    return element;
+  }
+  void unite(int lhs, int rhs) {
+    lhs = find(lhs);
+    rhs = find(rhs);
+    if ( lhs < rhs ) swap(lhs, rhs);
+    mParent[lhs] = rhs;
+  }
+private:
+  vector<int> mParent;
+};
+
+class Search {
+public:
+  Search(const Adjacency& graph, const vector<int>& colors);
+
+  // Generators, the smallest vertex of each orbit, and the group order
+  void run(vector<Permutation>& generators, vector<int>& orbits, double& size);
+
+private:
+  struct Level {
+    Partition partition;
+    int target;  // first non-singleton cell, or -1 at the leaf
+    int vertex;  // the vertex individualized from it
+  };
+
+  void refine(Partition& cells) const;
+  Partition individualize(const Partition& cells, int target, int vertex) const;
+  bool matches(int level, const Partition& other, Permutation& result) const;
+  int count(const Adjacency& graph, int vertex, const vector<Adjacency::word_type>& mask) const;
+
+  const Adjacency& mGraph;
+  const Adjacency mReversed;
+  const vector<int>& mColors;
+  vector<Level> mPath;
+};
+
+Search::Search(const Adjacency& graph, const vector<int>& colors) :
+  mGraph(graph),
+  mReversed(graph.transpose()),
+  mColors(colors)
+{
+  ; // This function has no body, just an initializer list.
+}
+
+int Search::count(const Adjacency& graph, int vertex, const vector<Adjacency::word_type>& mask) const {
+  const Adjacency::word_type* row = graph.row(vertex);
+  int result = 0;
+  for ( int index = 0; index < graph.wordsPerRow(); index++ ) {
+    result += __builtin_popcountll(row[index] & mask[index]);
+  }
+  return result;
+}
+
+// Split cells by the number of successors and predecessors in each
+// cell in turn, until nothing splits.  The pieces of a cell stay in
+// place, in increasing order of their counts, so the result depends
+// only on the graph's structure and not on its vertex labels.
+void Search::refine(Partition& cells) const {
+  bool changed = true;
+  while ( changed ) {
+    changed = false;
+    for ( unsigned int splitter = 0; splitter < cells.size(); splitter++ ) {
+      vector<Adjacency::word_type> mask(mGraph.wordsPerRow(), 0);
+      for ( int vertex : cells[splitter] ) {
+	mask[vertex / Adjacency::bitsPerWord] |= Adjacency::word_type(1) << (vertex % Adjacency::bitsPerWord);
+      }
+
+      Partition next;
+      next.reserve(cells.size());
+      for ( const vector<int>& cell : cells ) {
+	if ( cell.size() == 1 ) {
+	  next.push_back(cell);
+	  continue;
+	}
+	map<pair<int, int>, vector<int> > pieces;
+	for ( int vertex : cell ) {
+	  pieces[make_pair(count(mGraph, vertex, mask), count(mReversed, vertex, mask))].push_back(vertex);
+	}
+	if ( pieces.size() > 1 ) {
+	  changed = true;
+	}
+	for ( auto& piece : pieces ) {
+	  next.push_back(move(piece.second));
+	}
+      }
+      cells.swap(next);
+    }
+  }
+}
+
+Partition Search::individualize(const Partition& cells, int target, int vertex) const {
+  Partition result;
+  result.reserve(cells.size()+1);
+  for ( unsigned int index = 0; index < cells.size(); index++ ) {
+    if ( (int)index != target ) {
+      result.push_back(cells[index]);
+      continue;
+    }
+    result.push_back(vector<int>(1, vertex));
+    vector<int> rest;
+    for ( int other : cells[index] ) {
+      if ( other != vertex ) {
+	rest.push_back(other);
+      }
+    }
+    result.push_back(rest);
+  }
+  refine(result);
+  return result;
+}
+
+// Whether some leaf below other matches the first path's leaf, given
+// that other corresponds to the first path's partition at level
+bool Search::matches(int level, const Partition& other, Permutation& result) const {
+  const Level& mine = mPath[level];
+  if ( mine.partition.size() != other.size() ) {
+    return false;
+  }
+  for ( unsigned int index = 0; index < other.size(); index++ ) {
+    if ( mine.partition[index].size() != other[index].size() ) {
+      return false;
+    }
+  }
+
+  if ( mine.target < 0 ) {
+    result.assign(mGraph.order(), 0);
+    for ( unsigned int index = 0; index < other.size(); index++ ) {
+      int vertex = mine.partition[index][0];
+      result[vertex] = other[index][0];
+      if ( mColors[vertex] != mColors[result[vertex]] ) {
+	return false;
+      }
+    }
+    return Automorphisms::isAutomorphism(mGraph, result);
+  }
+
+  for ( int vertex : other[mine.target] ) {
+    if ( matches(level+1, individualize(other, mine.target, vertex), result) ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Search::run(vector<Permutation>& generators, vector<int>& orbits, double& size) {
+  const int order = mGraph.order();
+
+  // The initial partition: the color classes, in order of color
+  map<int, vector<int> > byColor;
+  for ( int vertex = 0; vertex < order; vertex++ ) {
+    byColor[mColors[vertex]].push_back(vertex);
+  }
+  Partition cells;
+  for ( auto& colorClass : byColor ) {
+    cells.push_back(move(colorClass.second));
+  }
+  refine(cells);
+
+  // The first path
+  while ( true ) {
+    Level level = { cells, -1, -1 };
+    for ( unsigned int index = 0; index < cells.size(); index++ ) {
+      if ( cells[index].size() > 1 ) {
+	level.target = index;
+	level.vertex = *min_element(cells[index].begin(), cells[index].end());
+	break;
+      }
+    }
+    mPath.push_back(level);
+    if ( level.target < 0 ) {
+      break;
+    }
+    cells = individualize(cells, level.target, level.vertex);
+  }
+
+  // From the deepest level up, find the orbit of each level's vertex
+  // under the automorphisms fixing the vertices above it.
+  DisjointSets sets(order);
+  size = 1;
+  for ( int depth = (int)mPath.size()-2; depth >= 0; depth-- ) {
+    const Level& level = mPath[depth];
+    int orbitSize = 1;
+    for ( int vertex : level.partition[level.target] ) {
+      if ( vertex == level.vertex ) {
+	continue;
+      }
+      if ( sets.find(vertex) != sets.find(level.vertex) ) {
+	Permutation permutation;
+	if ( !matches(depth+1, individualize(level.partition, level.target, vertex), permutation) ) {
+	  continue;
+	}
+	generators.push_back(permutation);
+	for ( int moved = 0; moved < order; moved++ ) {
+	  sets.unite(moved, permutation[moved]);
+	}
+      }
+      orbitSize++;
+    }
+    size *= orbitSize;
+  }
+
+  orbits.resize(order);
+  for ( int vertex = 0; vertex < order; vertex++ ) {
+    orbits[vertex] = sets.find(vertex);
+  }
+}
+}
+
+Automorphisms::Automorphisms(const Adjacency& graph) :
+  Automorphisms(graph, vector<int>(graph.order(), 0))
+{
+  ; // This function has no body, just an initializer list.
+}
+
+Automorphisms::Automorphisms(const Adjacency& graph, const vector<int>& colors) {
+  if ( (int)colors.size() != graph.order() ) {
+    throw invalid_argument("Automorphisms: one color is needed per vertex");
+  }
+  Search(graph, colors).run(mGenerators, mOrbits, mSize);
+}
+
+const vector<Permutation>& Automorphisms::generators() const {
+  return mGenerators;
+}
+
+const vector<int>& Automorphisms::orbits() const {
+  return mOrbits;
+}
+
+double Automorphisms::size() const {
+  return mSize;
+}
+
+bool Automorphisms::isAutomorphism(const Adjacency& graph, const Permutation& permutation) {
+  const int order = graph.order();
+  if ( (int)permutation.size() != order ) {
+    return false;
+  }
+  vector<bool> seen(order, false);
+  for ( int image : permutation ) {
+    if ( image < 0 || image >= order || seen[image] ) {
+      return false;
+    }
+    seen[image] = true;
+  }
+
+  // A bijection mapping every edge to an edge maps the edges onto
+  // the edges.
+  for ( int src = 0; src < order; src++ ) {
+    bool preserved = true;
+    graph.forEachNeighbor(src, [&] (int dst) {
+	preserved = preserved && graph.adjacent(permutation[src], permutation[dst]);
+      });
+    if ( !preserved ) {
+      return false;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,160 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Automorphisms of target graphs, and value symmetry breaking.
+//
+// Automorphisms finds generators of the group of permutations of a
+// graph's vertices that preserve its edges (and, optionally, a vertex
+// coloring), by individualization and partition refinement:
+//
+//  * An ordered partition of the vertices is refined until every
+//    vertex in a cell has the same number of successors and
+//    predecessors in each cell (an equitable partition).
+//  * Individualizing a vertex -- moving it into a cell of its own --
+//    and refining again descends one level.  The first vertex of the
+//    first non-singleton cell is individualized until the partition
+//    is discrete, which gives the "first path".
+//  * At each level of the first path, from the deepest up, the other
+//    vertices of the cell are tried in place of the path's vertex, and
+//    a search below them looks for a leaf that matches the first
+//    path's leaf cell for cell.  Vertices already known to be in the
+//    same orbit are skipped.
+//
+// The generators found this way generate the whole group, and the
+// orbit sizes along the first path multiply to its order.  The search
+// is exponential in the worst case, but fast on the graphs in data/.
+//
+// A homomorphism into the graph stays a homomorphism when composed
+// with an automorphism, so a cell assignment can be required to be no
+// larger (lexicographically, in a fixed cell order) than its image
+// under each generator.  This lex-leader constraint keeps at least one
+// solution from each class of symmetric solutions, and prunes the
+// others during search.  Only automorphisms that also preserve every
+// other constraint on the values may be used, which is what the vertex
+// coloring is for.
+
+#ifndef AUTOMORPHISMS_H
+#define AUTOMORPHISMS_H
+
+#include <vector>
+#include "adjacency.h"
+#include "atom.h"
+#include "clause.h"
+#include "literal.h"
+#include "requirement.h"
+#include "solver.h"
+
+// A permutation of the vertices, as the image of each vertex
+typedef std::vector<int> Permutation;
+
+class Automorphisms {
+public:
+  explicit Automorphisms(const Adjacency& graph);
+  // Automorphisms mapping each vertex to a vertex of the same color
+  Automorphisms(const Adjacency& graph, const std::vector<int>& colors);
+
+  const std::vector<Permutation>& generators() const;
+
+  // The smallest vertex in each vertex's orbit
+  const std::vector<int>& orbits() const;
+
+  // Order of the group
+  double size() const;
+
+  static bool isAutomorphism(const Adjacency& graph, const Permutation& permutation);
+
+private:
+  std::vector<Permutation> mGenerators;
+  std::vector<int> mOrbits;
+  double mSize;
+};
+
+// Requires the values of cells to be lexicographically no larger than
+// their images under permutation.  Uses a new variable per cell, for
+// "all earlier cells are fixed by the permutation", unless the
+// permutation fixes no values.
+template<class Scalar>
+Requirement lexLeader(Solver* solver, 
+		      const std::vector<Scalar>& cells, 
+		      const Permutation& permutation);
+
+// The lex-leader constraint for each generator
+template<class Scalar>
+Requirement valueSymmetryBreaking(Solver* solver, 
+				  const std::vector<Scalar>& cells, 
+				  const Automorphisms& automorphisms);
+
+template<class Scalar>
+Requirement lexLeader(Solver* solver, 
+		      const std::vector<Scalar>& cells, 
+		      const Permutation& permutation) {
+  std::vector<int> lowered;
+  std::vector<int> fixed;
+  for ( unsigned int value = 0; value < permutation.size(); value++ ) {
+    if ( permutation[value] < (int)value ) {
+      lowered.push_back(value);
+    } else if ( permutation[value] == (int)value ) {
+      fixed.push_back(value);
+    }
+  }
+
+  Requirement result;
+  Atom fixedSoFar = Atom::truth;
+  for ( unsigned int index = 0; index < cells.size(); index++ ) {
+    // While the earlier cells are fixed, a value the permutation maps
+    // lower would make the image smaller.
+    for ( int value : lowered ) {
+      Clause clause = ~fixedSoFar;
+      clause |= cells[index] != value;
+      result &= clause;
+    }
+    if ( fixed.empty() || index+1 == cells.size() ) {
+      break;
+    }
+
+    // ... and a fixed value carries the tie on to the next cell.
+    Atom fixedNext(Literal(solver->newVars(1)));
+    for ( int value : fixed ) {
+      Clause clause = ~fixedSoFar;
+      clause |= cells[index] != value;
+      clause |= fixedNext;
+      result &= clause;
+    }
+    fixedSoFar = fixedNext;
+  }
+  return result;
+}
+
+template<class Scalar>
+Requirement valueSymmetryBreaking(Solver* solver, 
+				  const std::vector<Scalar>& cells, 
+				  const Automorphisms& automorphisms) {
+  Requirement result;
+  for ( const Permutation& generator : automorphisms.generators() ) {
+    result &= lexLeader(solver, cells, generator);
+  }
+  return result;
+}
+
+#endif // AUTOMORPHISMS_H
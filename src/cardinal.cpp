@@ -43,6 +43,17 @@ Cardinal::Cardinal(Solver* _solver, int _min, int _max) :
   mSolver->require(typeRequirement());
 }
 
+// A handle on a cardinal whose literals were already allocated
+// (and requirements registered) starting at startingVar.
+Cardinal::Cardinal(Solver* _solver, int _min, int _max, unsigned int _startingVar) :
+  mSolver(_solver),
+  mMin(_min),
+  mMax(_max),
+  inverted(false),
+  mStartingVar(_startingVar)
+{
+}
+
 // The corresponding requirement of being a cardinal --
 // must take a value between min and max, and cannot take two values simultaneously.
 Requirement Cardinal::typeRequirement() const {
@@ -83,6 +94,10 @@ unsigned int Cardinal::startingVar() const {
   return mStartingVar;
 }
 
+Solver* Cardinal::solver() const {
+  return mSolver;
+}
+
 // Negation. If idx is a Cardinal, then -idx returns a cardinal that is
 // equal to n iff idx is equal to -n.
 Cardinal Cardinal::operator-() const {
@@ -50,6 +50,10 @@ public:
   Cardinal(Solver* solver, 
 	   int min, 
 	   int max);
+  Cardinal(Solver* solver,
+	   int min,
+	   int max,
+	   unsigned int startingVar);
 
   Cardinal() = delete;
   Cardinal(const Cardinal& copy) = default;
@@ -105,6 +109,7 @@ public:
   int min() const;
   int max() const;
   unsigned int startingVar() const;
+  Solver* solver() const;
 
   // The value assigned in the model, after solving, if a solution is available.
   int modelValue() const;
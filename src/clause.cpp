@@ -79,6 +79,10 @@ Clause operator|(Clause lhs, Literal rhs) {
   return move(lhs);
 }
 
+bool Clause::isTruth() const {
+  return truthFlag;
+}
+
 // Concatenation of a clause and an atom
 Clause operator|(Atom lhs, Clause rhs) {
   rhs |= lhs;
@@ -129,7 +133,7 @@ Clause& Clause::operator|=(const Literal rhs) {
 // Concatenation of a clause and an atom
 Clause& Clause::operator|=(const Atom rhs) {
   // Truth dominates a disjunction
-  if ( *this == Clause::truth || rhs == Atom::truth ) {
+  if ( isTruth() || rhs == Atom::truth ) {
     return *this = Clause::truth;
   } 
   
@@ -146,7 +150,7 @@ Clause& Clause::operator|=(const Atom rhs) {
 
 // Concatenation of a clause and a clause
 Clause& Clause::operator|=(Clause rhs) {
-  if ( *this == Clause::truth || rhs == Clause::truth ) { // Truth dominates a disjunction
+  if ( isTruth() || rhs.isTruth() ) { // Truth dominates a disjunction
     return *this = Clause::truth;
   } else {
     splice(end(), rhs);
@@ -186,7 +190,7 @@ bool operator<(Clause rhs, Clause lhs)  {
 
 // Output a clause
 ostream& operator<<(ostream& out, Clause rhs) {
-  if ( rhs == Clause::truth ) {
+  if ( rhs.isTruth() ) {
     return out << "truth";
   }
 
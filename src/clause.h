@@ -72,6 +72,9 @@ public:
   Clause& operator|=(Atom rhs);
   Clause& operator|=(Literal rhs);
 
+  // Whether this is Clause::truth
+  bool isTruth() const;
+
   friend Clause     operator~(DualClause dual);
   friend DualClause operator~(Clause clause);
   friend bool operator==(Clause lhs, Clause rhs);
@@ -0,0 +1,99 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of ClauseBuffer
+
+#include "clausebuffer.h"
+
+using namespace std;
+
+ClauseBuffer::ClauseBuffer() :
+  mNumClauses(0)
+{
+}
+
+void ClauseBuffer::add(const Clause& clause) {
+  if ( clause.isTruth() ) {
+    return;
+  }
+
+  // Reserve the length, then fill it in.
+  size_t start = mData.size();
+  mData.push_back(0);
+  for ( auto lit : clause ) {
+    mData.push_back(pack(lit));
+  }
+  mData[start] = mData.size() - start - 1;
+  mNumClauses++;
+}
+
+void ClauseBuffer::add(const Requirement& req) {
+  for ( const Clause& clause : req ) {
+    add(clause);
+  }
+}
+
+ClauseBuffer& ClauseBuffer::operator&=(const Clause& clause) {
+  add(clause);
+  return *this;
+}
+
+ClauseBuffer& ClauseBuffer::operator&=(const Requirement& req) {
+  add(req);
+  return *this;
+}
+
+unsigned int ClauseBuffer::numClauses() const {
+  return mNumClauses;
+}
+
+bool ClauseBuffer::empty() const {
+  return mNumClauses == 0;
+}
+
+void ClauseBuffer::clear() {
+  mData.clear();
+  mNumClauses = 0;
+}
+
+int ClauseBuffer::pack(Literal lit) {
+  int code = lit.getVar() + 1;
+  return lit.isPos() ? code : -code;
+}
+
+Literal ClauseBuffer::unpack(int packed) {
+  return packed > 0 ? Literal(packed - 1, true) : Literal(-packed - 1, false);
+}
+
+Requirement ClauseBuffer::toRequirement() const {
+  Requirement result;
+  forEachClause([&] (const int* lits, int size) {
+      Clause clause;
+      for ( int i = 0; i < size; i++ ) {
+	clause |= unpack(lits[i]);
+      }
+      result &= clause;
+    });
+  return result;
+}
@@ -0,0 +1,79 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// A packed buffer of clauses.
+//
+// Requirements are lists of lists of Literals, which is convenient
+// while building but costs an allocation per clause and per literal.
+// A ClauseBuffer stores each clause as its length followed by its
+// literals (var+1, negated for negative literals) in one vector, so it
+// can be filled cheaply (e.g., by a worker thread) and handed to a
+// Solver in one go.
+
+#ifndef CLAUSEBUFFER_H
+#define CLAUSEBUFFER_H
+
+#include <vector>
+#include "literal.h"
+#include "clause.h"
+#include "requirement.h"
+
+class ClauseBuffer {
+public:
+  ClauseBuffer();
+
+  // Append clauses.  Truth is dropped, as in Requirement.
+  void add(const Clause& clause);
+  void add(const Requirement& req);
+  ClauseBuffer& operator&=(const Clause& clause);
+  ClauseBuffer& operator&=(const Requirement& req);
+
+  unsigned int numClauses() const;
+  bool empty() const;
+  void clear();
+
+  // Call f(const int* literals, int size) for each packed clause
+  template<class Function>
+  void forEachClause(Function f) const;
+
+  // Conversions between packed and ordinary literals
+  static int pack(Literal lit);
+  static Literal unpack(int packed);
+
+  // Unpack into an ordinary Requirement (for testing, primarily)
+  Requirement toRequirement() const;
+
+private:
+  std::vector<int> mData;
+  unsigned int mNumClauses;
+};
+
+template<class Function>
+void ClauseBuffer::forEachClause(Function f) const {
+  for ( size_t pos = 0; pos < mData.size(); pos += mData[pos] + 1 ) {
+    f(mData.data() + pos + 1, mData[pos]);
+  }
+}
+
+#endif // CLAUSEBUFFER_H
@@ -0,0 +1,261 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// A matrix of Scalars stored by position alone.
+//
+// Every cell of a Matrix shares the same solver and range, and the
+// cells' literals are allocated contiguously, so a cell is determined
+// by the first variable of the matrix and the number of literals per
+// cell.  CompactMatrix stores only that, and hands out lightweight
+// Scalar handles (built with the startingVar constructor) on access,
+// rather than keeping a Scalar object per cell.
+//
+// Scalar must provide the constructors Scalar(solver, min, max) and
+// Scalar(solver, min, max, startingVar), as Cardinal and Ordinal do.
+// Views (rotations etc.) are only available on Matrix.
+//
+
+#ifndef COMPACTMATRIX_H
+#define COMPACTMATRIX_H
+
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include "requirement.h"
+#include "solver.h"
+#include "cardinal.h"
+#include "grid.h"
+#include "matrix.h"
+
+template<typename Scalar = Cardinal>
+class CompactMatrix {
+public:
+  // Allocates the literals for every cell at once and registers the
+  // type requirements of the cells.
+  CompactMatrix(Solver* solver,
+		int height,
+		int width,
+		int min,
+		int max);
+
+  CompactMatrix() = delete;
+  CompactMatrix(const CompactMatrix& copy) = default;
+  CompactMatrix(CompactMatrix&& move) = default;
+  CompactMatrix& operator=(const CompactMatrix& copy) = default;
+  CompactMatrix& operator=(CompactMatrix&& move) = default;
+
+  // Accessors for one row, by int or by Scalar.  Cells are returned as
+  // handles, by value.
+  struct RowAccess {
+    const CompactMatrix* matrix;
+    int row;
+    Scalar operator()(int col) const;
+  };
+  struct PairIndexAccess {
+    const CompactMatrix* matrix;
+    Scalar row;
+    PairIndexedScalar<Scalar, CompactMatrix> operator()(Scalar col) const;
+  };
+  typedef SubscriptWrapper<Scalar, int, RowAccess> row_type;
+  typedef SubscriptWrapper<PairIndexedScalar<Scalar, CompactMatrix>, Scalar, PairIndexAccess> pair_row_type;
+
+  // Bounds-checked unless GRID_UNCHECKED is defined, as for Grid.
+  row_type operator[](int row) const;
+  pair_row_type operator[](Scalar row) const;
+
+  // Single-call access to a cell, checked and unchecked.
+  Scalar at(int row, int col) const;
+  Scalar at_unchecked(int row, int col) const;
+
+  Requirement typeRequirement() const;
+  unsigned int numLiterals() const;
+  Clause diffSolnReq() const;
+  DualClause currSolnReq() const;
+
+  unsigned int height() const;
+  unsigned int width() const;
+  int min() const;
+  int max() const;
+  Solver* solver() const;
+  unsigned int startingVar() const;
+
+private:
+  Solver* mSolver;
+  int mHeight;
+  int mWidth;
+  int mMin;
+  int mMax;
+  unsigned int mStride;
+  unsigned int mStartingVar;
+};
+
+template<typename Scalar>
+CompactMatrix<Scalar>::CompactMatrix(Solver* _solver,
+				     int _height,
+				     int _width,
+				     int _min,
+				     int _max) :
+  mSolver(_solver),
+  mHeight(_height),
+  mWidth(_width),
+  mMin(_min),
+  mMax(_max),
+  mStride(Scalar(_solver, _min, _max, 0).numLiterals()),
+  mStartingVar(0)
+{
+  if ( _height < 0 || _width < 0 ) {
+    std::ostringstream sout;
+    sout << "Invalid height or width " << _height << " and " << _width << " for CompactMatrix";
+    throw std::invalid_argument(sout.str());
+  }
+
+  mStartingVar = mSolver->newVars(mHeight*mWidth*mStride);
+  mSolver->require(typeRequirement());
+}
+
+template<typename Scalar>
+inline typename CompactMatrix<Scalar>::row_type CompactMatrix<Scalar>::operator[](int row) const {
+#ifndef GRID_UNCHECKED
+  if ( row < 0 || row >= mHeight ) {
+    throwGridIndexError("row", row, "height", mHeight);
+  }
+#endif
+
+  return row_type(RowAccess{this, row});
+}
+
+template<typename Scalar>
+inline Scalar CompactMatrix<Scalar>::RowAccess::operator()(int col) const {
+#ifndef GRID_UNCHECKED
+  if ( col < 0 || col >= matrix->mWidth ) {
+    throwGridIndexError("column", col, "width", matrix->mWidth);
+  }
+#endif
+
+  return matrix->at_unchecked(row, col);
+}
+
+template<typename Scalar>
+typename CompactMatrix<Scalar>::pair_row_type CompactMatrix<Scalar>::operator[](Scalar row) const {
+  return pair_row_type(PairIndexAccess{this, row});
+}
+
+template<typename Scalar>
+inline PairIndexedScalar<Scalar, CompactMatrix<Scalar> > 
+CompactMatrix<Scalar>::PairIndexAccess::operator()(Scalar col) const {
+  return PairIndexedScalar<Scalar, CompactMatrix>(matrix, row, col);
+}
+
+template<typename Scalar>
+inline Scalar CompactMatrix<Scalar>::at(int row, int col) const {
+  if ( row < 0 || row >= mHeight ) {
+    throwGridIndexError("row", row, "height", mHeight);
+  }
+  if ( col < 0 || col >= mWidth ) {
+    throwGridIndexError("column", col, "width", mWidth);
+  }
+  return at_unchecked(row, col);
+}
+
+template<typename Scalar>
+inline Scalar CompactMatrix<Scalar>::at_unchecked(int row, int col) const {
+  return Scalar(mSolver, mMin, mMax, mStartingVar + (row*mWidth + col)*mStride);
+}
+
+template<typename Scalar>
+Requirement CompactMatrix<Scalar>::typeRequirement() const {
+  Requirement result;
+  for ( int row = 0; row < mHeight; row++ ) {
+    for ( int col = 0; col < mWidth; col++ ) {
+      result &= at_unchecked(row, col).typeRequirement();
+    }
+  }
+  return result;
+}
+
+template<typename Scalar>
+unsigned int CompactMatrix<Scalar>::numLiterals() const {
+  return mHeight*mWidth*mStride;
+}
+
+template<typename Scalar>
+DualClause CompactMatrix<Scalar>::currSolnReq() const {
+  DualClause result;
+  for ( int row = 0; row < mHeight; row++ ) {
+    for ( int col = 0; col < mWidth; col++ ) {
+      result &= at_unchecked(row, col).currSolnReq();
+    }
+  }
+  return result;
+}
+
+template<typename Scalar>
+Clause CompactMatrix<Scalar>::diffSolnReq() const {
+  return ~currSolnReq();
+}
+
+template<typename Scalar>
+unsigned int CompactMatrix<Scalar>::height() const {
+  return mHeight;
+}
+
+template<typename Scalar>
+unsigned int CompactMatrix<Scalar>::width() const {
+  return mWidth;
+}
+
+template<typename Scalar>
+int CompactMatrix<Scalar>::min() const {
+  return mMin;
+}
+
+template<typename Scalar>
+int CompactMatrix<Scalar>::max() const {
+  return mMax;
+}
+
+template<typename Scalar>
+Solver* CompactMatrix<Scalar>::solver() const {
+  return mSolver;
+}
+
+template<typename Scalar>
+unsigned int CompactMatrix<Scalar>::startingVar() const {
+  return mStartingVar;
+}
+
+// Output operator
+template<class Scalar>
+std::ostream& operator<<(std::ostream& out, const CompactMatrix<Scalar>& matrix) {
+  for ( int i = 0; i < matrix.height(); i++) {
+    out << "    ";
+    for ( int j = 0; j < matrix.width(); j++ ) {
+      out << matrix.at_unchecked(i, j) << " ";
+    }
+    out << std::endl;
+  }
+  return out;
+}
+
+#endif // COMPACTMATRIX_H
@@ -0,0 +1,236 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of DomainFilter.
+
+#include <deque>
+#include <sstream>
+#include <stdexcept>
+#include "domainfilter.h"
+
+using namespace std;
+
+DomainFilter::DomainFilter(int numVariables, int numValues) :
+  mNumVariables(numVariables),
+  mNumValues(numValues),
+  mWordsPerDomain((numValues + Adjacency::bitsPerWord - 1) / Adjacency::bitsPerWord),
+  mArcsInto(numVariables < 0 ? 0 : numVariables)
+{
+  if ( numVariables < 0 || numValues < 0 ) {
+    ostringstream sout;
+    sout << "Invalid domain filter size " << numVariables << " x " << numValues;
+    throw invalid_argument(sout.str());
+  }
+
+  mDomains.assign((size_t)numVariables*mWordsPerDomain, ~word_type(0));
+  if ( numValues % Adjacency::bitsPerWord != 0 ) {
+    for ( int variable = 0; variable < numVariables; variable++ ) {
+      words(variable)[mWordsPerDomain-1] = (word_type(1) << (numValues % Adjacency::bitsPerWord)) - 1;
+    }
+  }
+}
+
+int DomainFilter::numVariables() const {
+  return mNumVariables;
+}
+
+int DomainFilter::numValues() const {
+  return mNumValues;
+}
+
+void DomainFilter::restrict(int variable, const vector<int>& values) {
+  checkVariable(variable);
+  vector<word_type> allowed(mWordsPerDomain, 0);
+  for ( int value : values ) {
+    if ( 0 <= value && value < mNumValues ) {
+      allowed[value / Adjacency::bitsPerWord] |= word_type(1) << (value % Adjacency::bitsPerWord);
+    }
+  }
+  word_type* domain = words(variable);
+  for ( int index = 0; index < mWordsPerDomain; index++ ) {
+    domain[index] &= allowed[index];
+  }
+}
+
+void DomainFilter::bound(int variable, int low, int high) {
+  checkVariable(variable);
+  for ( int value = 0; value < mNumValues; value++ ) {
+    if ( value < low || value > high ) {
+      remove(variable, value);
+    }
+  }
+}
+
+void DomainFilter::fix(int variable, int value) {
+  restrict(variable, vector<int>(1, value));
+}
+
+void DomainFilter::remove(int variable, int value) {
+  checkVariable(variable);
+  if ( 0 <= value && value < mNumValues ) {
+    words(variable)[value / Adjacency::bitsPerWord] &= ~(word_type(1) << (value % Adjacency::bitsPerWord));
+  }
+}
+
+int DomainFilter::addRelation(const Adjacency& relation) {
+  if ( relation.order() != mNumValues ) {
+    throw invalid_argument("DomainFilter: relation size differs from the number of values");
+  }
+  mRelations.push_back(relation);
+  mRelations.push_back(relation.transpose());
+  return mRelations.size()/2 - 1;
+}
+
+void DomainFilter::relate(int lhs, int rhs, int relation) {
+  checkVariable(lhs);
+  checkVariable(rhs);
+  if ( relation < 0 || 2*relation >= (int)mRelations.size() ) {
+    throw out_of_range("DomainFilter: no such relation");
+  }
+  mArcsInto[rhs].push_back(mArcs.size());
+  mArcs.push_back(Arc{ lhs, rhs, 2*relation });
+  mArcsInto[lhs].push_back(mArcs.size());
+  mArcs.push_back(Arc{ rhs, lhs, 2*relation+1 });
+}
+
+// Removes the values of arc.from without a support in arc.to.  Returns
+// whether anything was removed.
+bool DomainFilter::revise(const Arc& arc) {
+  const Adjacency& relation = mRelations[arc.relation];
+  word_type* from = words(arc.from);
+  const word_type* to = words(arc.to);
+  bool changed = false;
+  for ( int index = 0; index < mWordsPerDomain; index++ ) {
+    word_type remaining = from[index];
+    while ( remaining != 0 ) {
+      int bit = __builtin_ctzll(remaining);
+      remaining &= remaining - 1;
+
+      const word_type* supports = relation.row(index*Adjacency::bitsPerWord + bit);
+      bool supported = false;
+      for ( int other = 0; other < mWordsPerDomain && !supported; other++ ) {
+	supported = (supports[other] & to[other]) != 0;
+      }
+      if ( !supported ) {
+	from[index] &= ~(word_type(1) << bit);
+	changed = true;
+      }
+    }
+  }
+  return changed;
+}
+
+bool DomainFilter::propagate() {
+  // Every arc is checked once, then again whenever its target shrinks.
+  deque<int> pending;
+  vector<bool> queued(mArcs.size(), true);
+  for ( unsigned int arc = 0; arc < mArcs.size(); arc++ ) {
+    pending.push_back(arc);
+  }
+
+  while ( !pending.empty() ) {
+    int arc = pending.front();
+    pending.pop_front();
+    queued[arc] = false;
+
+    if ( !revise(mArcs[arc]) ) {
+      continue;
+    }
+    int changed = mArcs[arc].from;
+    if ( domainSize(changed) == 0 ) {
+      return false;
+    }
+    // The reverse of this arc (added alongside it) needs no recheck:
+    // every value it keeps in its target still has a support here.
+    for ( int into : mArcsInto[changed] ) {
+      if ( !queued[into] && into != (arc ^ 1) ) {
+	queued[into] = true;
+	pending.push_back(into);
+      }
+    }
+  }
+
+  for ( int variable = 0; variable < mNumVariables; variable++ ) {
+    if ( domainSize(variable) == 0 ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool DomainFilter::contains(int variable, int value) const {
+  checkVariable(variable);
+  if ( value < 0 || value >= mNumValues ) {
+    return false;
+  }
+  return (words(variable)[value / Adjacency::bitsPerWord] >> (value % Adjacency::bitsPerWord)) & 1;
+}
+
+int DomainFilter::domainSize(int variable) const {
+  checkVariable(variable);
+  const word_type* domain = words(variable);
+  int result = 0;
+  for ( int index = 0; index < mWordsPerDomain; index++ ) {
+    result += __builtin_popcountll(domain[index]);
+  }
+  return result;
+}
+
+vector<int> DomainFilter::domain(int variable) const {
+  checkVariable(variable);
+  vector<int> result;
+  const word_type* domain = words(variable);
+  for ( int index = 0; index < mWordsPerDomain; index++ ) {
+    word_type remaining = domain[index];
+    while ( remaining != 0 ) {
+      result.push_back(index*Adjacency::bitsPerWord + __builtin_ctzll(remaining));
+      remaining &= remaining - 1;
+    }
+  }
+  return result;
+}
+
+unsigned long DomainFilter::numRemoved() const {
+  unsigned long remaining = 0;
+  for ( int variable = 0; variable < mNumVariables; variable++ ) {
+    remaining += domainSize(variable);
+  }
+  return (unsigned long)mNumVariables*mNumValues - remaining;
+}
+
+DomainFilter::word_type* DomainFilter::words(int variable) {
+  return mDomains.data() + (size_t)variable*mWordsPerDomain;
+}
+
+const DomainFilter::word_type* DomainFilter::words(int variable) const {
+  return mDomains.data() + (size_t)variable*mWordsPerDomain;
+}
+
+void DomainFilter::checkVariable(int variable) const {
+  if ( variable < 0 || variable >= mNumVariables ) {
+    ostringstream sout;
+    sout << "Variable " << variable << " out of range for a filter of " << mNumVariables << " variables";
+    throw out_of_range(sout.str());
+  }
+}
@@ -0,0 +1,103 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Arc-consistency filtering of cell domains, before encoding.
+//
+// A DomainFilter holds a domain (a set of values in [0, numValues))
+// for each of a set of variables -- typically the cells of a grid --
+// and binary constraints between them, each given by a relation
+// matrix: lhs may take a only if rhs takes some b with
+// relation.adjacent(a, b).  propagate() removes every value without
+// such a support in some constraint, until nothing changes (AC-3, with
+// the domains as bitsets so that each support check is a few word
+// ANDs).
+//
+// The pruned domains are then used to build SparseCardinals, so the
+// values removed here get no literals and no clauses at all.  Unary
+// restrictions (fixed cells, bounds such as "the top row is at most
+// 2") are applied to the domains directly before propagating.
+
+#ifndef DOMAINFILTER_H
+#define DOMAINFILTER_H
+
+#include <vector>
+#include "adjacency.h"
+
+class DomainFilter {
+public:
+  typedef Adjacency::word_type word_type;
+
+  // Every variable starts with every value
+  DomainFilter(int numVariables, int numValues);
+
+  int numVariables() const;
+  int numValues() const;
+
+  // Unary restrictions
+  void restrict(int variable, const std::vector<int>& values);
+  void bound(int variable, int low, int high);
+  void fix(int variable, int value);
+  void remove(int variable, int value);
+
+  // Relations are numbered in the order they are added.  A relation
+  // must be numValues x numValues.
+  int addRelation(const Adjacency& relation);
+  // lhs and rhs take values related by relation, as above, and
+  // symmetrically rhs needs a support in lhs through the transpose
+  void relate(int lhs, int rhs, int relation);
+
+  // Prune to arc consistency.  Returns false if some domain is empty
+  // (the constraints are unsatisfiable).
+  bool propagate();
+
+  bool contains(int variable, int value) const;
+  int domainSize(int variable) const;
+  std::vector<int> domain(int variable) const;
+
+  // Values removed by restrictions and propagation, in total
+  unsigned long numRemoved() const;
+
+private:
+  struct Arc {
+    int from;
+    int to;
+    int relation;  // into mRelations; the transpose for the reverse arc
+  };
+
+  word_type* words(int variable);
+  const word_type* words(int variable) const;
+  bool revise(const Arc& arc);
+  void checkVariable(int variable) const;
+
+  int mNumVariables;
+  int mNumValues;
+  int mWordsPerDomain;
+  std::vector<word_type> mDomains;
+  std::vector<Adjacency> mRelations;
+  std::vector<Arc> mArcs;
+  // Arcs into each variable, by index in mArcs
+  std::vector<std::vector<int> > mArcsInto;
+};
+
+#endif // DOMAINFILTER_H
@@ -0,0 +1,326 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of ExactCover.
+
+#include <algorithm>
+#include <atomic>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include "exactcover.h"
+
+using namespace std;
+
+namespace {
+// The dancing links, as parallel arrays.  Node 0 is the root, nodes
+// 1..numColumns are the column headers and the rest are the row
+// entries.  Secondary column headers are left out of the root's list,
+// so the search never needs to cover them, but rows still remove each
+// other through them.
+class Links {
+public:
+  Links(int numPrimary, int numSecondary, const vector<vector<int> >& rows) :
+    mNumColumns(numPrimary + numSecondary)
+  {
+    for ( int node = 0; node <= mNumColumns; node++ ) {
+      bool listed = node <= numPrimary;
+      addNode(node, node, -1);
+      mLeft[node]  = listed ? (node == 0 ? numPrimary : node-1) : node;
+      mRight[node] = listed ? (node == numPrimary ? 0 : node+1) : node;
+    }
+    mSize.assign(mNumColumns+1, 0);
+
+    for ( unsigned int row = 0; row < rows.size(); row++ ) {
+      int first = -1;
+      for ( int column : rows[row] ) {
+	int header = column + 1;
+	int node = mColumn.size();
+	addNode(node, header, row);
+
+	// Append to the bottom of the column
+	mUp[node] = mUp[header];
+	mDown[node] = header;
+	mDown[mUp[header]] = node;
+	mUp[header] = node;
+	mSize[header]++;
+
+	// And to the end of the row
+	if ( first < 0 ) {
+	  first = node;
+	} else {
+	  mLeft[node] = mLeft[first];
+	  mRight[node] = first;
+	  mRight[mLeft[first]] = node;
+	  mLeft[first] = node;
+	}
+      }
+    }
+  }
+
+  // The primary column with the fewest rows; -1 if none is left (the
+  // current rows are a solution).
+  int choose() const {
+    int best = -1;
+    for ( int header = mRight[0]; header != 0; header = mRight[header] ) {
+      if ( best < 0 || mSize[header] < mSize[best] ) {
+	best = header;
+      }
+    }
+    return best;
+  }
+
+  void cover(int header) {
+    mRight[mLeft[header]] = mRight[header];
+    mLeft[mRight[header]] = mLeft[header];
+    for ( int row = mDown[header]; row != header; row = mDown[row] ) {
+      for ( int node = mRight[row]; node != row; node = mRight[node] ) {
+	mDown[mUp[node]] = mDown[node];
+	mUp[mDown[node]] = mUp[node];
+	mSize[mColumn[node]]--;
+      }
+    }
+  }
+
+  void uncover(int header) {
+    for ( int row = mUp[header]; row != header; row = mUp[row] ) {
+      for ( int node = mLeft[row]; node != row; node = mLeft[node] ) {
+	mSize[mColumn[node]]++;
+	mDown[mUp[node]] = node;
+	mUp[mDown[node]] = node;
+      }
+    }
+    mRight[mLeft[header]] = header;
+    mLeft[mRight[header]] = header;
+  }
+
+  // Take the row of a node: cover the node's other columns
+  void select(int node) {
+    for ( int other = mRight[node]; other != node; other = mRight[other] ) {
+      cover(mColumn[other]);
+    }
+  }
+
+  void deselect(int node) {
+    for ( int other = mLeft[node]; other != node; other = mLeft[other] ) {
+      uncover(mColumn[other]);
+    }
+  }
+
+  // The row entries of a column, top to bottom
+  vector<int> entries(int header) const {
+    vector<int> result;
+    for ( int node = mDown[header]; node != header; node = mDown[node] ) {
+      result.push_back(node);
+    }
+    return result;
+  }
+
+  // How many ways the search branches first
+  int numBranches() const {
+    int header = choose();
+    return header < 0 ? 1 : mSize[header];
+  }
+
+  int rowOf(int node) const {
+    return mRow[node];
+  }
+
+  // Visit every completion of partial; false if visit asked to stop
+  template<class Visitor>
+  bool search(vector<int>& partial, Visitor& visit) {
+    int header = choose();
+    if ( header < 0 ) {
+      return visit(partial);
+    }
+    if ( mSize[header] == 0 ) {
+      return true;
+    }
+
+    bool going = true;
+    cover(header);
+    for ( int node = mDown[header]; going && node != header; node = mDown[node] ) {
+      partial.push_back(mRow[node]);
+      select(node);
+      going = search(partial, visit);
+      deselect(node);
+      partial.pop_back();
+    }
+    uncover(header);
+    return going;
+  }
+
+private:
+  void addNode(int node, int column, int row) {
+    mLeft.push_back(node);
+    mRight.push_back(node);
+    mUp.push_back(node);
+    mDown.push_back(node);
+    mColumn.push_back(column);
+    mRow.push_back(row);
+  }
+
+  int mNumColumns;
+  vector<int> mLeft;
+  vector<int> mRight;
+  vector<int> mUp;
+  vector<int> mDown;
+  vector<int> mColumn;
+  vector<int> mRow;
+  vector<int> mSize;
+};
+
+// Runs visitor(branch, rows) over every solution, with the first
+// branching column's rows split across threads.  Solutions of each
+// branch are visited in search order, with their rows in the order
+// they were chosen.
+template<class BranchVisitor>
+void searchBranches(const Links& links, unsigned int numThreads, BranchVisitor visitor) {
+  const int header = links.choose();
+  if ( header < 0 ) {
+    vector<int> none;
+    visitor(0, none);
+    return;
+  }
+  const vector<int> branches = links.entries(header);
+
+  if ( numThreads == 0 ) {
+    numThreads = max(1u, thread::hardware_concurrency());
+  }
+  numThreads = max(1u, min(numThreads, (unsigned int)branches.size()));
+
+  atomic<unsigned int> next(0);
+  auto work = [&] () {
+    Links mine(links);
+    mine.cover(header);
+    for ( unsigned int branch = next++; branch < branches.size(); branch = next++ ) {
+      vector<int> partial(1, mine.rowOf(branches[branch]));
+      auto visit = [&] (const vector<int>& rows) {
+	visitor(branch, rows);
+	return true;
+      };
+      mine.select(branches[branch]);
+      mine.search(partial, visit);
+      mine.deselect(branches[branch]);
+    }
+  };
+
+  // The calling thread works too.
+  vector<thread> workers;
+  for ( unsigned int worker = 1; worker < numThreads; worker++ ) {
+    workers.emplace_back(work);
+  }
+  work();
+  for ( thread& worker : workers ) {
+    worker.join();
+  }
+}
+} // namespace
+
+ExactCover::ExactCover(int numPrimary, int numSecondary) :
+  mNumPrimary(numPrimary),
+  mNumSecondary(numSecondary)
+{
+  if ( numPrimary < 0 || numSecondary < 0 ) {
+    ostringstream sout;
+    sout << "Invalid exact cover columns " << numPrimary << " + " << numSecondary;
+    throw invalid_argument(sout.str());
+  }
+}
+
+int ExactCover::numPrimary() const {
+  return mNumPrimary;
+}
+
+int ExactCover::numColumns() const {
+  return mNumPrimary + mNumSecondary;
+}
+
+int ExactCover::numRows() const {
+  return mRows.size();
+}
+
+int ExactCover::addRow(const vector<int>& columns) {
+  vector<int> sorted(columns);
+  sort(sorted.begin(), sorted.end());
+  for ( unsigned int index = 0; index < sorted.size(); index++ ) {
+    if ( sorted[index] < 0 || sorted[index] >= numColumns() ) {
+      ostringstream sout;
+      sout << "Column " << sorted[index] << " out of range for " << numColumns() << " columns";
+      throw out_of_range(sout.str());
+    }
+    if ( index > 0 && sorted[index] == sorted[index-1] ) {
+      throw invalid_argument("ExactCover row covers a column twice");
+    }
+  }
+
+  mRows.push_back(columns);
+  return mRows.size() - 1;
+}
+
+const vector<int>& ExactCover::row(int index) const {
+  return mRows.at(index);
+}
+
+unsigned long ExactCover::solve(visitor_type visit) const {
+  Links links(mNumPrimary, mNumSecondary, mRows);
+  unsigned long numVisited = 0;
+  auto visitSorted = [&] (const vector<int>& rows) {
+    vector<int> sorted(rows);
+    sort(sorted.begin(), sorted.end());
+    numVisited++;
+    return visit(sorted);
+  };
+
+  vector<int> partial;
+  links.search(partial, visitSorted);
+  return numVisited;
+}
+
+vector<vector<int> > ExactCover::solutions(unsigned int numThreads) const {
+  Links links(mNumPrimary, mNumSecondary, mRows);
+  // Branches are filled in by different threads; each has its own list.
+  vector<vector<vector<int> > > byBranch(links.numBranches());
+  searchBranches(links, numThreads, [&] (unsigned int branch, const vector<int>& rows) {
+      byBranch[branch].push_back(rows);
+      sort(byBranch[branch].back().begin(), byBranch[branch].back().end());
+    });
+
+  vector<vector<int> > result;
+  for ( auto& branch : byBranch ) {
+    for ( auto& rows : branch ) {
+      result.push_back(move(rows));
+    }
+  }
+  return result;
+}
+
+unsigned long ExactCover::count(unsigned int numThreads) const {
+  Links links(mNumPrimary, mNumSecondary, mRows);
+  atomic<unsigned long> total(0);
+  searchBranches(links, numThreads, [&] (unsigned int branch, const vector<int>& rows) {
+      total++;
+    });
+  return total;
+}
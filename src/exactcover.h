@@ -0,0 +1,80 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Exact cover by dancing links (Knuth's Algorithm X).
+//
+// Given columns and rows that each cover some of the columns, find all
+// sets of rows that cover every primary column exactly once and every
+// secondary column at most once.  Tiling problems are the prime
+// example: one primary column per cell and per piece, and one row per
+// placement of a piece.
+//
+// For problems of this form, searching the cover directly is far
+// faster than enumerating SAT solutions one blocking clause at a
+// time: the links make each step undoable in constant time and nothing
+// is learned or stored between solutions.  The search always branches
+// on the primary column with the fewest remaining rows.
+//
+// count() and solutions() can split the search over the rows of the
+// first branching column, each worker thread taking whole branches
+// with its own copy of the links.  Solutions come back in the same
+// order whatever the number of threads.
+
+#ifndef EXACTCOVER_H
+#define EXACTCOVER_H
+
+#include <functional>
+#include <vector>
+
+class ExactCover {
+public:
+  // Columns [0, numPrimary) are primary, the rest secondary.
+  ExactCover(int numPrimary, int numSecondary = 0);
+
+  int numPrimary() const;
+  int numColumns() const;
+  int numRows() const;
+
+  // Add a row covering the given (distinct) columns.  Returns its
+  // index.
+  int addRow(const std::vector<int>& columns);
+  const std::vector<int>& row(int index) const;
+
+  // Call visit with each solution, as increasing row indices, until it
+  // returns false.  Returns the number of solutions visited.
+  typedef std::function<bool(const std::vector<int>& rows)> visitor_type;
+  unsigned long solve(visitor_type visit) const;
+
+  // All solutions, or just their number.  numThreads of 0 means one
+  // per hardware thread.
+  std::vector<std::vector<int> > solutions(unsigned int numThreads = 1) const;
+  unsigned long count(unsigned int numThreads = 1) const;
+
+private:
+  int mNumPrimary;
+  int mNumSecondary;
+  std::vector<std::vector<int> > mRows;
+};
+
+#endif // EXACTCOVER_H
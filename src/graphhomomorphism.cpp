@@ -0,0 +1,98 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of GraphHomomorphism's target neighbor lists.
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+#include "graphhomomorphism.h"
+
+using namespace std;
+
+GraphHomomorphism::GraphHomomorphism(const Adjacency& target) :
+  GraphHomomorphism(Graph(target))
+{
+  ; // This function has no body, just an initializer list.
+}
+
+GraphHomomorphism::GraphHomomorphism(const Graph& target) {
+  const int order = target.order();
+  mSuccessors.resize(order);
+  for ( int c = 0; c < order; c++ ) {
+    mSuccessors[c] = target.neighbors(c);
+  }
+
+  mPredecessors.assign(order, vector<int>());
+  for ( int c = 0; c < order; c++ ) {
+    for ( int d : mSuccessors[c] ) {
+      mPredecessors[d].push_back(c);
+    }
+  }
+
+  // Both lists are sorted, so the mutual neighbors are their intersection.
+  mNeighbors.assign(order, vector<int>());
+  for ( int c = 0; c < order; c++ ) {
+    set_intersection(mSuccessors[c].begin(), mSuccessors[c].end(),
+		     mPredecessors[c].begin(), mPredecessors[c].end(),
+		     back_inserter(mNeighbors[c]));
+  }
+}
+
+int GraphHomomorphism::order() const {
+  return mSuccessors.size();
+}
+
+const vector<int>& GraphHomomorphism::successors(int c) const {
+  checkVertex(c);
+  return mSuccessors[c];
+}
+
+const vector<int>& GraphHomomorphism::predecessors(int c) const {
+  checkVertex(c);
+  return mPredecessors[c];
+}
+
+const vector<int>& GraphHomomorphism::neighbors(int c) const {
+  checkVertex(c);
+  return mNeighbors[c];
+}
+
+Adjacency GraphHomomorphism::neighborMatrix() const {
+  vector<vector<bool> > matrix(order(), vector<bool>(order(), false));
+  for ( int c = 0; c < order(); c++ ) {
+    for ( int d : mNeighbors[c] ) {
+      matrix[c][d] = true;
+    }
+  }
+  return Adjacency(matrix);
+}
+
+void GraphHomomorphism::checkVertex(int c) const {
+  if ( c < 0 || c >= order() ) {
+    ostringstream sout;
+    sout << "Vertex " << c << " out of range for a target graph of order " << order();
+    throw out_of_range(sout.str());
+  }
+}
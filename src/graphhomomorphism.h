@@ -0,0 +1,202 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Constraints making a map into a target graph a homomorphism.
+//
+// A GraphHomomorphism is built once from the target graph, and lists
+// each target vertex's successors, predecessors and mutual neighbors.
+// It then emits support clauses for the edges of a source structure
+// whose vertices are Scalars valued in the target's vertices: for a
+// source arc u -> v,
+//
+//   u == c  implies  OR(v == d, for each d with c -> d), and
+//   v == d  implies  OR(u == c, for each c with c -> d).
+//
+// An undirected source edge (such as the 4-neighborhood of a grid)
+// must map to a pair of vertices adjacent both ways, so it uses the
+// mutual neighbors in both directions instead.
+//
+// Scalars may be Cardinals, SparseCardinals or Ordinals; values
+// outside a Scalar's domain fold to falsity, so only the values the
+// cells can actually take contribute clauses.
+
+#ifndef GRAPHHOMOMORPHISM_H
+#define GRAPHHOMOMORPHISM_H
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "adjacency.h"
+#include "clause.h"
+#include "graphs.h"
+#include "requirement.h"
+
+class GraphHomomorphism {
+public:
+  GraphHomomorphism() = delete;
+  explicit GraphHomomorphism(const Adjacency& target);
+  explicit GraphHomomorphism(const Graph& target);
+
+  int order() const;
+
+  // Vertices d with c -> d, with d -> c, and with both; each in
+  // increasing order
+  const std::vector<int>& successors(int c) const;
+  const std::vector<int>& predecessors(int c) const;
+  const std::vector<int>& neighbors(int c) const;
+
+  // The mutual neighbor relation as a matrix, e.g. for DomainFilter
+  Adjacency neighborMatrix() const;
+
+  // Source arc src -> dst, and undirected source edge lhs -- rhs
+  template<class Scalar>
+  Requirement arc(const Scalar& src, const Scalar& dst) const;
+  template<class Scalar>
+  Requirement edge(const Scalar& lhs, const Scalar& rhs) const;
+
+  // The 4-neighborhood of a height x width grid.  cell is any callable
+  // returning the Scalar at (row, col).  The per-row versions give the
+  // edges from (row, col) to (row, col+1), and to (row+1, col), for
+  // use with requireRows().
+  template<class CellAccess>
+  Requirement grid(CellAccess cell, int height, int width) const;
+  template<class CellAccess>
+  Requirement horizontalEdges(CellAccess cell, int row, int width) const;
+  template<class CellAccess>
+  Requirement verticalEdges(CellAccess cell, int row, int width) const;
+
+  // As above, for a grid that supports height(), width() and double
+  // indexing
+  template<class GridType>
+  Requirement grid(const GridType& grid) const;
+
+  // An arbitrary source graph whose vertex v maps to vertices[v].  Arcs
+  // present both ways are treated as undirected edges.
+  template<class Scalar>
+  Requirement graph(const Graph& source, const std::vector<Scalar>& vertices) const;
+
+private:
+  void checkVertex(int c) const;
+
+  // Support for the edge from lhs: lhs == c implies rhs takes one of
+  // adjacent[c]
+  template<class Scalar>
+  Requirement support(const Scalar& lhs, 
+		      const Scalar& rhs, 
+		      const std::vector<std::vector<int> >& adjacent) const;
+
+  std::vector<std::vector<int> > mSuccessors;
+  std::vector<std::vector<int> > mPredecessors;
+  std::vector<std::vector<int> > mNeighbors;
+};
+
+template<class Scalar>
+Requirement GraphHomomorphism::support(const Scalar& lhs, 
+				       const Scalar& rhs, 
+				       const std::vector<std::vector<int> >& adjacent) const {
+  Requirement result;
+  for ( unsigned int c = 0; c < adjacent.size(); c++ ) {
+    // Skip values outside the domain of lhs.
+    auto premise = lhs == (int)c;
+    if ( premise == decltype(premise)::falsity ) {
+      continue;
+    }
+
+    Requirement options = Clause();
+    for ( int d : adjacent[c] ) {
+      options |= rhs == d;
+    }
+    for ( Clause& clause : implication(premise, options) ) {
+      result &= std::move(clause);
+    }
+  }
+  return result;
+}
+
+template<class Scalar>
+Requirement GraphHomomorphism::arc(const Scalar& src, const Scalar& dst) const {
+  return support(src, dst, mSuccessors) & support(dst, src, mPredecessors);
+}
+
+template<class Scalar>
+Requirement GraphHomomorphism::edge(const Scalar& lhs, const Scalar& rhs) const {
+  return support(lhs, rhs, mNeighbors) & support(rhs, lhs, mNeighbors);
+}
+
+template<class CellAccess>
+Requirement GraphHomomorphism::grid(CellAccess cell, int height, int width) const {
+  Requirement result;
+  for ( int row = 0; row < height; row++ ) {
+    result &= horizontalEdges(cell, row, width);
+    if ( row+1 < height ) {
+      result &= verticalEdges(cell, row, width);
+    }
+  }
+  return result;
+}
+
+template<class CellAccess>
+Requirement GraphHomomorphism::horizontalEdges(CellAccess cell, int row, int width) const {
+  Requirement result;
+  for ( int col = 0; col+1 < width; col++ ) {
+    result &= edge(cell(row, col), cell(row, col+1));
+  }
+  return result;
+}
+
+template<class CellAccess>
+Requirement GraphHomomorphism::verticalEdges(CellAccess cell, int row, int width) const {
+  Requirement result;
+  for ( int col = 0; col < width; col++ ) {
+    result &= edge(cell(row, col), cell(row+1, col));
+  }
+  return result;
+}
+
+template<class GridType>
+Requirement GraphHomomorphism::grid(const GridType& grid) const {
+  return this->grid([&] (int row, int col) { return grid[row][col]; }, 
+		    grid.height(), 
+		    grid.width());
+}
+
+template<class Scalar>
+Requirement GraphHomomorphism::graph(const Graph& source, const std::vector<Scalar>& vertices) const {
+  if ( (int)vertices.size() != source.order() ) {
+    throw std::invalid_argument("GraphHomomorphism: one Scalar is needed per source vertex");
+  }
+  Requirement result;
+  for ( int src = 0; src < source.order(); src++ ) {
+    for ( int dst : source.neighbors(src) ) {
+      if ( !source.hasEdge(dst, src) ) {
+	result &= arc(vertices[src], vertices[dst]);
+      } else if ( src <= dst ) {
+	result &= edge(vertices[src], vertices[dst]);
+      }
+    }
+  }
+  return result;
+}
+
+#endif // GRAPHHOMOMORPHISM_H
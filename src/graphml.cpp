@@ -0,0 +1,468 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of GraphML, including a minimal streaming XML reader.
+
+#include <algorithm>
+#include <cctype>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include "graphml.h"
+
+using namespace std;
+
+namespace {
+typedef map<string, string> attribute_map;
+
+// Reads XML from a stream, reporting elements and text as it goes.
+// Handles comments, processing instructions, CDATA, DOCTYPE (without
+// an internal subset) and the predefined and numeric entities, which
+// is all GraphML needs.
+class XmlReader {
+public:
+  function<void(const string& name, const attribute_map& attributes)> startElement;
+  function<void(const string& name)> endElement;
+  function<void(const string& text)> characters;
+
+  explicit XmlReader(istream& in) : mIn(in) {}
+  void parse();
+
+private:
+  [[noreturn]] void error(const string& what) const;
+  int get();
+  void skipPast(const string& terminator);
+  string readUntil(const string& terminator);
+  void parseTag();
+  static string decode(const string& text);
+
+  istream& mIn;
+  vector<string> mOpen;
+};
+
+void XmlReader::error(const string& what) const {
+  throw runtime_error("Malformed GraphML: " + what);
+}
+
+int XmlReader::get() {
+  int c = mIn.get();
+  if ( c == EOF ) {
+    error("unexpected end of input");
+  }
+  return c;
+}
+
+void XmlReader::skipPast(const string& terminator) {
+  readUntil(terminator);
+}
+
+string XmlReader::readUntil(const string& terminator) {
+  string result;
+  while ( result.size() < terminator.size() || 
+	  result.compare(result.size() - terminator.size(), terminator.size(), terminator) != 0 ) {
+    result += (char)get();
+  }
+  result.resize(result.size() - terminator.size());
+  return result;
+}
+
+void XmlReader::parse() {
+  string text;
+  int c;
+  while ( (c = mIn.get()) != EOF ) {
+    if ( c != '<' ) {
+      text += (char)c;
+      continue;
+    }
+
+    if ( !text.empty() ) {
+      if ( !mOpen.empty() && characters ) {
+	characters(decode(text));
+      }
+      text.clear();
+    }
+    parseTag();
+  }
+
+  if ( !mOpen.empty() ) {
+    error("unclosed element <" + mOpen.back() + ">");
+  }
+}
+
+// Called just after a '<'
+void XmlReader::parseTag() {
+  int c = get();
+  if ( c == '?' ) {
+    skipPast("?>");
+    return;
+  }
+  if ( c == '!' ) {
+    string start;
+    start += (char)get();
+    start += (char)get();
+    if ( start == "--" ) {
+      skipPast("-->");
+    } else if ( start == "[C" ) {
+      if ( readUntil("[") != "DATA" ) {
+	error("bad CDATA section");
+      }
+      string data = readUntil("]]>");
+      if ( !mOpen.empty() && characters ) {
+	characters(data);
+      }
+    } else {
+      skipPast(">");
+    }
+    return;
+  }
+
+  // Read the whole tag, respecting quoted attribute values.
+  string tag(1, (char)c);
+  char quote = 0;
+  while ( true ) {
+    c = get();
+    if ( quote ) {
+      if ( c == quote ) quote = 0;
+    } else if ( c == '"' || c == '\'' ) {
+      quote = c;
+    } else if ( c == '>' ) {
+      break;
+    }
+    tag += (char)c;
+  }
+
+  // Closing tag
+  if ( tag[0] == '/' ) {
+    string name = tag.substr(1);
+    name.erase(name.find_last_not_of(" \t\r\n") + 1);
+    if ( mOpen.empty() || mOpen.back() != name ) {
+      error("unexpected </" + name + ">");
+    }
+    mOpen.pop_back();
+    if ( endElement ) endElement(name);
+    return;
+  }
+
+  bool selfClosing = !tag.empty() && tag.back() == '/';
+  if ( selfClosing ) {
+    tag.pop_back();
+  }
+
+  // Name, then name="value" pairs
+  size_t pos = 0;
+  auto skipSpace = [&] () { while ( pos < tag.size() && isspace((unsigned char)tag[pos]) ) pos++; };
+  auto readName = [&] () {
+    size_t start = pos;
+    while ( pos < tag.size() && !isspace((unsigned char)tag[pos]) && tag[pos] != '=' ) pos++;
+    return tag.substr(start, pos-start);
+  };
+
+  string name = readName();
+  if ( name.empty() ) {
+    error("element without a name");
+  }
+
+  attribute_map attributes;
+  skipSpace();
+  while ( pos < tag.size() ) {
+    string attribute = readName();
+    skipSpace();
+    if ( pos >= tag.size() || tag[pos] != '=' ) {
+      error("attribute " + attribute + " of <" + name + "> has no value");
+    }
+    pos++;
+    skipSpace();
+    if ( pos >= tag.size() || (tag[pos] != '"' && tag[pos] != '\'') ) {
+      error("unquoted value for attribute " + attribute + " of <" + name + ">");
+    }
+    size_t end = tag.find(tag[pos], pos+1);
+    attributes[attribute] = decode(tag.substr(pos+1, end-pos-1));
+    pos = end+1;
+    skipSpace();
+  }
+
+  if ( startElement ) startElement(name, attributes);
+  if ( selfClosing ) {
+    if ( endElement ) endElement(name);
+  } else {
+    mOpen.push_back(name);
+  }
+}
+
+string XmlReader::decode(const string& text) {
+  string result;
+  for ( size_t pos = 0; pos < text.size(); pos++ ) {
+    if ( text[pos] != '&' ) {
+      result += text[pos];
+      continue;
+    }
+
+    size_t end = text.find(';', pos);
+    if ( end == string::npos ) {
+      throw runtime_error("Malformed GraphML: unterminated entity");
+    }
+    string entity = text.substr(pos+1, end-pos-1);
+    if ( entity == "amp" ) result += '&';
+    else if ( entity == "lt" ) result += '<';
+    else if ( entity == "gt" ) result += '>';
+    else if ( entity == "quot" ) result += '"';
+    else if ( entity == "apos" ) result += '\'';
+    else if ( !entity.empty() && entity[0] == '#' ) {
+      // Numeric references outside ASCII don't occur in the keys and
+      // ids we use, so keep just the low byte.
+      long code = entity[1] == 'x' ? strtol(entity.c_str()+2, nullptr, 16) : strtol(entity.c_str()+1, nullptr, 10);
+      result += (char)code;
+    } else {
+      throw runtime_error("Malformed GraphML: unknown entity &" + entity + ";");
+    }
+    pos = end;
+  }
+  return result;
+}
+
+// Natural sort key: "ab5cd10" -> ("ab", 5, "cd", 10), with numbers
+// ordered before text.
+struct KeyPart {
+  bool isNumber;
+  long long number;
+  string text;
+
+  bool operator<(const KeyPart& rhs) const {
+    if ( isNumber != rhs.isNumber ) return isNumber;
+    return isNumber ? number < rhs.number : text < rhs.text;
+  }
+};
+
+vector<KeyPart> naturalKey(const string& key) {
+  vector<KeyPart> result;
+  size_t pos = 0;
+  while ( pos < key.size() ) {
+    size_t start = pos;
+    bool digits = isdigit((unsigned char)key[pos]);
+    while ( pos < key.size() && (bool)isdigit((unsigned char)key[pos]) == digits ) pos++;
+    string part = key.substr(start, pos-start);
+    result.push_back(digits ? KeyPart{true, stoll(part), ""} : KeyPart{false, 0, part});
+  }
+  return result;
+}
+
+string trim(const string& text) {
+  size_t start = text.find_first_not_of(" \t\r\n");
+  if ( start == string::npos ) return "";
+  return text.substr(start, text.find_last_not_of(" \t\r\n") - start + 1);
+}
+
+// What the reader keeps of each node
+struct NodeRecord {
+  string id;
+  map<string, string> data; // first datum per key
+  string color;
+};
+} // namespace
+
+GraphML::GraphML(istream& in) {
+  XmlReader reader(in);
+
+  string eqKeyId;
+  string eqDefault;
+  bool haveEqKey = false;
+  bool haveEqDefault = false;
+  vector<NodeRecord> nodes;
+  vector<pair<string, string> > edges;
+
+  // Parse state
+  bool inEqKey = false;
+  bool inEqDefault = false;
+  int graphDepth = 0;       // nesting depth within the first <graph>
+  bool seenGraph = false;
+  vector<int> openNodes;    // indices into nodes
+  string dataKey;           // key of the <data> being read, if any
+  bool inData = false;
+  string text;
+
+  reader.startElement = [&] (const string& name, const attribute_map& attributes) {
+    auto attribute = [&] (const string& attr) {
+      auto it = attributes.find(attr);
+      return it == attributes.end() ? string() : it->second;
+    };
+
+    if ( name == "key" && !haveEqKey && 
+	 attribute("attr.name") == "Equivalence" && attribute("for") == "node" && 
+	 attributes.count("id") ) {
+      haveEqKey = true;
+      inEqKey = true;
+      eqKeyId = attribute("id");
+    } else if ( name == "default" && inEqKey && !haveEqDefault ) {
+      inEqDefault = true;
+      text.clear();
+    } else if ( name == "graph" ) {
+      if ( graphDepth > 0 || !seenGraph ) {
+	graphDepth++;
+      }
+      seenGraph = true;
+    } else if ( graphDepth == 0 ) {
+      return;
+    } else if ( name == "node" ) {
+      if ( !attributes.count("id") ) {
+	throw runtime_error("Malformed GraphML: node without an id");
+      }
+      openNodes.push_back(nodes.size());
+      nodes.push_back(NodeRecord{attribute("id"), {}, ""});
+    } else if ( name == "edge" ) {
+      if ( !attributes.count("source") || !attributes.count("target") ) {
+	throw runtime_error("Malformed GraphML: edge without a source or target");
+      }
+      edges.push_back(make_pair(attribute("source"), attribute("target")));
+    } else if ( name == "data" && !openNodes.empty() ) {
+      inData = true;
+      dataKey = attribute("key");
+      text.clear();
+    } else if ( name == "y:Fill" && !openNodes.empty() ) {
+      NodeRecord& node = nodes[openNodes.back()];
+      if ( node.color.empty() && attributes.count("color") ) {
+	node.color = attribute("color");
+      }
+    }
+  };
+
+  reader.characters = [&] (const string& chars) {
+    if ( inEqDefault || inData ) {
+      text += chars;
+    }
+  };
+
+  reader.endElement = [&] (const string& name) {
+    if ( name == "key" ) {
+      inEqKey = false;
+    } else if ( name == "default" && inEqDefault ) {
+      inEqDefault = false;
+      haveEqDefault = true;
+      eqDefault = trim(text);
+    } else if ( name == "graph" && graphDepth > 0 ) {
+      graphDepth--;
+    } else if ( name == "node" && graphDepth > 0 ) {
+      openNodes.pop_back();
+    } else if ( name == "data" && inData ) {
+      inData = false;
+      nodes[openNodes.back()].data.insert(make_pair(dataKey, trim(text)));
+    }
+  };
+
+  reader.parse();
+
+  // Each node's equivalence key: its datum, the default, or (for
+  // negative values, or with no equivalences at all) its own id.
+  vector<vector<KeyPart> > nodeKeys;
+  for ( const NodeRecord& node : nodes ) {
+    string eq;
+    auto datum = node.data.find(eqKeyId);
+    if ( haveEqKey && datum != node.data.end() ) {
+      eq = datum->second;
+    } else if ( haveEqDefault ) {
+      eq = eqDefault;
+    }
+
+    if ( eq.empty() ) {
+      eq = node.id;
+    } else {
+      char* end;
+      long value = strtol(eq.c_str(), &end, 10);
+      if ( *end != '\0' ) {
+	throw runtime_error("Malformed GraphML: equivalence \"" + eq + "\" of node " + 
+			    node.id + " is not an integer");
+      }
+      if ( value < 0 ) {
+	eq = node.id;
+      }
+    }
+    nodeKeys.push_back(naturalKey(eq));
+  }
+
+  // Number the classes in key order.
+  vector<vector<KeyPart> > classes(nodeKeys);
+  sort(classes.begin(), classes.end());
+  auto equal = [] (const vector<KeyPart>& lhs, const vector<KeyPart>& rhs) {
+    return !(lhs < rhs) && !(rhs < lhs);
+  };
+  classes.erase(unique(classes.begin(), classes.end(), equal), classes.end());
+
+  for ( int i = 0; i < nodes.size(); i++ ) {
+    int index = lower_bound(classes.begin(), classes.end(), nodeKeys[i]) - classes.begin();
+    mIndices[nodes[i].id] = index;
+    if ( !nodes[i].color.empty() ) {
+      string color = nodes[i].color;
+      color.erase(0, color.find_first_not_of('#'));
+      color.erase(color.find_last_not_of('#') + 1);
+      mPalette[index] = "0x" + color;
+    }
+  }
+
+  mIncidences.assign(classes.size(), vector<bool>(classes.size(), false));
+  for ( const auto& edge : edges ) {
+    int src = indexOf(edge.first);
+    int dst = indexOf(edge.second);
+    mIncidences[src][dst] = true;
+    mIncidences[dst][src] = true;
+  }
+}
+
+unsigned int GraphML::order() const {
+  return mIncidences.size();
+}
+
+bool GraphML::adjacent(int src, int dst) const {
+  return mIncidences.at(src).at(dst);
+}
+
+const vector<vector<bool> >& GraphML::incidences() const {
+  return mIncidences;
+}
+
+int GraphML::indexOf(const string& nodeId) const {
+  auto it = mIndices.find(nodeId);
+  if ( it == mIndices.end() ) {
+    throw runtime_error("Malformed GraphML: unknown node " + nodeId);
+  }
+  return it->second;
+}
+
+const map<int, string>& GraphML::palette() const {
+  return mPalette;
+}
+
+void GraphML::writeMatrix(ostream& out) const {
+  out << order() << endl;
+  for ( const auto& row : mIncidences ) {
+    for ( bool incident : row ) {
+      out << (incident ? 1 : 0) << " ";
+    }
+    out << endl;
+  }
+}
+
+void GraphML::writePalette(ostream& out) const {
+  for ( const auto& entry : mPalette ) {
+    out << entry.first << " " << entry.second << endl;
+  }
+}
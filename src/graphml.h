@@ -0,0 +1,76 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// A graph read from GraphML (as written by yEd).
+//
+// Nodes are merged into equivalence classes by their "Equivalence"
+// data: nodes sharing a nonnegative value form one class, and nodes
+// with a negative value are classes of their own.  Classes are
+// numbered in natural order of their keys ("n2" before "n10"), and two
+// classes are adjacent if any edge joins their nodes, in either
+// direction.  Each class's color is the fill color of its nodes, for
+// plotting.
+//
+// The file is read in one streaming pass by a small SAX-style XML
+// reader; nothing is kept but the nodes, edges and keys.
+// writeMatrix() and writePalette() produce the .mtx and .palette files
+// the scenarios and plotting scripts read.
+
+#ifndef GRAPHML_H
+#define GRAPHML_H
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+class GraphML {
+public:
+  // Throws std::runtime_error on malformed input.
+  explicit GraphML(std::istream& in);
+
+  // Number of equivalence classes
+  unsigned int order() const;
+
+  bool adjacent(int src, int dst) const;
+  const std::vector<std::vector<bool> >& incidences() const;
+
+  // The class of the node with the given id
+  int indexOf(const std::string& nodeId) const;
+
+  // Color of each class, as "0xRRGGBB"
+  const std::map<int, std::string>& palette() const;
+
+  // The incidence matrix (order, then rows) and the palette (index
+  // and color per line), in the formats the scenarios read.
+  void writeMatrix(std::ostream& out) const;
+  void writePalette(std::ostream& out) const;
+
+private:
+  std::map<std::string, int> mIndices;
+  std::vector<std::vector<bool> > mIncidences;
+  std::map<int, std::string> mPalette;
+};
+
+#endif // GRAPHML_H
@@ -23,179 +23,135 @@
 ////////////////////////////////////////////////////////////////////////////
 //
 // April 2014
-// TODO: This file is a bit of a dumping ground for code that stacked
-// up in Solve.cpp recently.  I just don't need it for the moment.
-// It's just different kinds of graphs (in incidence matrix form) that
-// we can put relations on.
-//
-// At a minimum, it needs a matching header file.
+// Different kinds of graphs (in incidence matrix form) that we can put
+// relations on.  See graphs.h.
 
-#include <iostream>
-#include "grid.h"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include "graphs.h"
 using namespace std;
 
-/////////////////////////////////////////////////////////////////////
-//
-//  A graph based on a given incidence matrix, specified in a stream
-//
-//  This class is inefficient except for some possible (bizarre) edge
-//  cases.  I wrote it before I realized this, so it's not
-//  well-tested.  The inefficiency comes from the fact that it creates
-//  a large number of literals and specifies the values exactly; the
-//  only way to use this information is to imply these literals are
-//  true or false in certain scenarios, which will create a (probably)
-//  ridiculous amount of unnecessary unit propagation.
-//
-class StreamGraph: public Grid<Literal> {
-public:
-  StreamGraph() = delete;
-  StreamGraph(Solver* solver, istream& in);
-
-  int order() const;
-
-private:
-  // Helper method to make it easier to compute the grid inside of the
-  // constructor initialier list.
-  static Grid createGrid(Solver* solver, istream& in);
-};
-
-Grid<Literal> StreamGraph::createGrid(Solver* solver, istream& in) {
-  int order;
-  in >> order;
-  return Grid(order, order,
-	      [&](int src, int dst) {
-		Literal lit(solver->newVars(1));
-
-		if ( !in ) {
-		  throw std::runtime_error("Error reading incidence matrix from stream. "
-					   "Corrupted file? "
-					   "Incorrect dimension specification? "
-					   "Non-integer values?");
-		}
-		int elem;
-		in >> elem;
-
-		auto req = (elem == 0) ? ~lit : lit;
-		solver->require(req);
-		return lit;
-	      });
+Graph::Graph(int order, edge_predicate_type hasEdge) :
+  Graph(order, hasEdge, nullptr)
+{
+  ; // This function has no body, just an initializer list.
 }
 
-StreamGraph::StreamGraph(Solver* solver, istream& in) :
-  Grid(createGrid(solver, in))
+Graph::Graph(int order, edge_predicate_type hasEdge, candidates_type candidates) :
+  mOrder(order),
+  mHasEdge(hasEdge),
+  mCandidates(candidates)
 {
-  ; // This function has no body, just an initializer list.
+  if ( order < 0 ) {
+    std::ostringstream sout;
+    sout << "Invalid graph order " << order;
+    throw std::invalid_argument(sout.str());
+  }
 }
 
-int StreamGraph::order() const {
-  return height();
+Graph::Graph(const Adjacency& adjacency) :
+  Graph(adjacency.order(),
+	[=](int src, int dst) { return adjacency.adjacent(src, dst); },
+	[=](int src) { return adjacency.neighbors(src); })
+{
+  ; // This function has no body, just an initializer list.
 }
 
 /////////////////////////////////////////////////////////////////////
 //
-//  A complete graph (K_n)
+//  A graph based on a given incidence matrix, specified in a stream
 //
-class CompleteGraph: public Grid<Literal> {
-public:
-  CompleteGraph() = delete;
-  CompleteGraph(Solver* solver, int order);
-
-  int order() const;
-};
-
-CompleteGraph::CompleteGraph(Solver* solver, int order) :
-  Grid(order, order, 
-       [&](int src, int dst) {
-	 Literal lit(solver->newVars(1));
-	 auto req = (src == dst) ? ~lit : lit;
-	 solver->require(req);
-	 return lit;
-       })
-{
-  ; // This function has no body, just an initializer list.
+Graph Graph::read(istream& in) {
+  return Graph(Adjacency::readMatrix(in));
 }
 
-int CompleteGraph::order() const {
-  return height();
+/////////////////////////////////////////////////////////////////////
+//
+//  A complete graph (K_n)
+//
+Graph Graph::complete(int order) {
+  return Graph(order, [](int src, int dst) { return src != dst; });
 }
 
 /////////////////////////////////////////////////////////////////////
 //
 //  The twisted torus graph
 //
-class TwistedTorusGraph: public Grid<Literal> {
-public:
-  TwistedTorusGraph() = delete;
-  TwistedTorusGraph(Solver* solver, int order);
-
-  int order() const;
-};
-
-TwistedTorusGraph::TwistedTorusGraph(Solver* solver, int length) :
-  Grid(3*length, 3*length,
-       [&](int src, int dst) {
-	 // Symmetric matrix, so WLOG, src < dst.
-	 if ( src > dst ) {
-	   swap(src, dst);
-	 }
-
-	 // Note: these force srcCol <= dstCol with the swap above
-	 int srcRow = src % 3;
-	 int srcCol = src / 3;
-	 int dstRow = dst % 3;
-	 int dstCol = dst / 3;
-	 
-	 bool includeLink;
-	 
-	 // Case 1: horizontal links in the final column
-	 if ( srcCol == 0 && dstCol == length -1 ) {
-	   includeLink = 
-	     (srcRow == 0 && dstRow == 1) ||
-	     (srcRow == 1 && dstRow == 0) ||
-	     (srcRow == 2 && dstRow == 2);
-	 }
-	 
-	 // Case 2: horizontal links in other columns
-	 else if (srcCol+1 == dstCol) {
-	   includeLink = ( srcRow == dstRow );
-	 }
-	 
-	 // Case 3: vertical links in other columns
-	 else if (srcCol == dstCol) {
-	   includeLink = srcRow != dstRow;
-	 }
-	 
-	 // Case 4: all other links
-	 else {
-	   includeLink = false;
-	 }
-	 
-	 // Fill in the corresponding part of the matrix
-	 Literal lit(solver->newVars(1));
-
-	 solver->require(includeLink ? lit : ~lit);
-	 return lit;
-       })
-{
-  ; // This function has no body, just an initializer list.
+//  Vertex 3*col + row is row row of column col; each column is a
+//  triangle, rows continue to the next column, and the last column
+//  joins the first with rows 0 and 1 exchanged.
+//
+namespace {
+bool twistedTorusEdge(int length, int src, int dst) {
+  // Symmetric matrix, so WLOG, src < dst.
+  if ( src > dst ) {
+    swap(src, dst);
+  }
+
+  // Note: these force srcCol <= dstCol with the swap above
+  int srcRow = src % 3;
+  int srcCol = src / 3;
+  int dstRow = dst % 3;
+  int dstCol = dst / 3;
+
+  bool includeLink;
+
+  // Case 1: horizontal links in the final column
+  if ( srcCol == 0 && dstCol == length -1 ) {
+    includeLink = 
+      (srcRow == 0 && dstRow == 1) ||
+      (srcRow == 1 && dstRow == 0) ||
+      (srcRow == 2 && dstRow == 2);
+  }
+
+  // Case 2: horizontal links in other columns
+  else if (srcCol+1 == dstCol) {
+    includeLink = ( srcRow == dstRow );
+  }
+
+  // Case 3: vertical links in other columns
+  else if (srcCol == dstCol) {
+    includeLink = srcRow != dstRow;
+  }
+
+  // Case 4: all other links
+  else {
+    includeLink = false;
+  }
+
+  return includeLink;
+}
 }
 
-int TwistedTorusGraph::order() const {
-  return height();
+Graph Graph::twistedTorus(int length) {
+  if ( length <= 0 ) {
+    std::ostringstream sout;
+    sout << "Invalid twisted torus length " << length;
+    throw std::invalid_argument(sout.str());
+  }
+
+  return Graph(3*length,
+	       [=](int src, int dst) { return twistedTorusEdge(length, src, dst); },
+	       // Only the neighboring columns and the two ends can link.
+	       [=](int src) {
+		 int col = src / 3;
+		 vector<int> result;
+		 for ( int other : { col-1, col, col+1, 0, length-1 } ) {
+		   if ( 0 <= other && other < length ) {
+		     for ( int row = 0; row < 3; row++ ) {
+		       result.push_back(3*other + row);
+		     }
+		   }
+		 }
+		 return result;
+	       });
 }
 
 /////////////////////////////////////////////////////////////////////
 //
 //  The orientation reversal graph
 //
-class OrientationReversalGraph: public Grid<Literal> {
-public:
-  OrientationReversalGraph() = delete;
-  OrientationReversalGraph(Solver* solver, int width, int height);
-
-  int order() const;
-};
-
 // We seek a particular kind of coloring of a grid of nodes into a
 // target graph gamma.  That is, we want gamma to include an odd cycle, and we
 // want it to be possible to transform gamma into the reverse odd
@@ -250,114 +206,186 @@ public:
 //  5|0 1 1 0 1 0
 //  
 
-OrientationReversalGraph::OrientationReversalGraph(Solver* solver, int cycleLength, int stages) :
-  // Set up a long, complicated lambda function as one of the arguments for the Grid initialization
-  Grid(cycleLength*stages, cycleLength*stages,
-       [&](int src, int dst) {
-	 // The cycle length must be odd, and the number of stages must be even
-	 if ( !(cycleLength % 2 == 1 && stages % 2 == 0) ) {
-	   std::ostringstream sout;
-	   sout << "Invalid cycle length " << cycleLength << " or number of stages " << stages << " for an odd cycle orientation reversal.";
-	   throw std::invalid_argument(sout.str());
-	 }
-
-	 // Symmetric matrix, so WLOG, src <= dst.
-	 if ( src > dst ) {
-	   swap(src, dst);
-	 }
-
-	 int srcRow = src / cycleLength;
-	 int srcCol = src % cycleLength;
-	 int dstRow = dst / cycleLength;
-	 int dstCol = dst % cycleLength;
-	 
-	 bool includeLink = false;
-
-	 // 
-	 // Giant if tree.
-	 // 
-	 // Because of the swap above and the way srcRow and dstRow
-	 // are defined, we will always have srcRow <= dstRow, and if
-	 // equality holds, then srcCol <= dstCol.
-	 //
-
-	 // Case 1: links involving upper left corner 
-	 if (srcRow == 0 && srcCol == 0) {
-	   // Case 1a: The upper-left-corner node links to the node
-	   // to its right
-	   if ( dstRow == 0 && dstCol == 1 ) {
-	     includeLink = true;
-	   }
-	   
-	   // Case 1b: The upper-left-corner node links to the node on
-	   // the left side, on odd-numbered rows
-	   else if ( dstCol == 0 && dstRow % 2 == 1 ) {
-	     includeLink = true;
-	   }
-
-	   // Case 1c: The upper-left-corner node links to the node on
-	   // the right side, on even-numbered rows
-	   else if ( dstCol == cycleLength-1 && dstRow % 2 == 0 ) {
-	     includeLink = true;
-	   }
-
-	   // The upper-left-corner node links to no other nodes
-	   else {
-	     includeLink = false;
-	   }
-	 }
-
-	 // Case 2: horizontal links that have not already been
-	 // handled by case 1
-	 else if ( srcRow == dstRow ) {
-	   includeLink = ( srcCol+1 == dstCol );
-	 }
-
-	 // Case 3: all other links (i.e., just vertical links)
-	 else {
-	   // Case 3a: Vertical links from top row to bottom row.
-	   // Involves a reversal.
-	   if ( srcRow == 0 && dstRow == stages-1 ) {
-	     includeLink = ( srcCol == (cycleLength-dstCol)%cycleLength );
-	   }
-
-	   // Case 3b: All other vertical links from top row to bottom
-	   // row. These cases are not exclusive (they won't be if
-	   // stages==2), hence the lack of "else" and use of "|="
-	   if ( srcRow+1 == dstRow ) {
-	     includeLink |= ( srcCol == dstCol );
-	   }
-	 }
-	 // End of if tree ---------------------------------------------------
-
-
-	 // Fill in the corresponding part of the matrix
-	 Literal lit(solver->newVars(1));
-
-	 solver->require(includeLink ? lit : ~lit);
-	 return lit;
-       })
-{
-  ; // This constructor has no body, just an initializer list with a long lambda function.
+namespace {
+bool orientationReversalEdge(int cycleLength, int stages, int src, int dst) {
+  // Symmetric matrix, so WLOG, src <= dst.
+  if ( src > dst ) {
+    swap(src, dst);
+  }
+
+  int srcRow = src / cycleLength;
+  int srcCol = src % cycleLength;
+  int dstRow = dst / cycleLength;
+  int dstCol = dst % cycleLength;
+
+  bool includeLink = false;
+
+  // 
+  // Giant if tree.
+  // 
+  // Because of the swap above and the way srcRow and dstRow
+  // are defined, we will always have srcRow <= dstRow, and if
+  // equality holds, then srcCol <= dstCol.
+  //
+
+  // Case 1: links involving upper left corner 
+  if (srcRow == 0 && srcCol == 0) {
+    // Case 1a: The upper-left-corner node links to the node
+    // to its right
+    if ( dstRow == 0 && dstCol == 1 ) {
+      includeLink = true;
+    }
+
+    // Case 1b: The upper-left-corner node links to the node on
+    // the left side, on odd-numbered rows
+    else if ( dstCol == 0 && dstRow % 2 == 1 ) {
+      includeLink = true;
+    }
+
+    // Case 1c: The upper-left-corner node links to the node on
+    // the right side, on even-numbered rows
+    else if ( dstCol == cycleLength-1 && dstRow % 2 == 0 ) {
+      includeLink = true;
+    }
+
+    // The upper-left-corner node links to no other nodes
+    else {
+      includeLink = false;
+    }
+  }
+
+  // Case 2: horizontal links that have not already been
+  // handled by case 1
+  else if ( srcRow == dstRow ) {
+    includeLink = ( srcCol+1 == dstCol );
+  }
+
+  // Case 3: all other links (i.e., just vertical links)
+  else {
+    // Case 3a: Vertical links from top row to bottom row.
+    // Involves a reversal.
+    if ( srcRow == 0 && dstRow == stages-1 ) {
+      includeLink = ( srcCol == (cycleLength-dstCol)%cycleLength );
+    }
+
+    // Case 3b: All other vertical links from top row to bottom
+    // row. These cases are not exclusive (they won't be if
+    // stages==2), hence the lack of "else" and use of "|="
+    if ( srcRow+1 == dstRow ) {
+      includeLink |= ( srcCol == dstCol );
+    }
+  }
+  // End of if tree ---------------------------------------------------
+
+  return includeLink;
+}
 }
 
-int OrientationReversalGraph::order() const {
-  return height();
+Graph Graph::orientationReversal(int cycleLength, int stages) {
+  // The cycle length must be odd, and the number of stages must be even
+  if ( !(cycleLength > 0 && cycleLength % 2 == 1 && stages > 0 && stages % 2 == 0) ) {
+    std::ostringstream sout;
+    sout << "Invalid cycle length " << cycleLength << " or number of stages " << stages << " for an odd cycle orientation reversal.";
+    throw std::invalid_argument(sout.str());
+  }
+
+  return Graph(cycleLength*stages,
+	       [=](int src, int dst) { 
+		 return orientationReversalEdge(cycleLength, stages, src, dst); 
+	       },
+	       // The upper-left corner links across the whole grid; the
+	       // other nodes only link to it, their own and neighboring
+	       // rows, and the top or bottom row.
+	       [=](int src) {
+		 vector<int> result;
+		 int row = src / cycleLength;
+		 if ( src == 0 ) {
+		   for ( int dst = 0; dst < cycleLength*stages; dst++ ) {
+		     result.push_back(dst);
+		   }
+		   return result;
+		 }
+		 result.push_back(0);
+		 for ( int other : { row-1, row, row+1, 0, stages-1 } ) {
+		   if ( 0 <= other && other < stages ) {
+		     for ( int col = 0; col < cycleLength; col++ ) {
+		       result.push_back(other*cycleLength + col);
+		     }
+		   }
+		 }
+		 return result;
+	       });
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+//  Queries
+//
+int Graph::order() const {
+  return mOrder;
+}
+
+bool Graph::hasEdge(int src, int dst) const {
+  checkVertex(src);
+  checkVertex(dst);
+  return mHasEdge(src, dst);
+}
+
+vector<int> Graph::neighbors(int src) const {
+  checkVertex(src);
+  vector<int> result;
+  if ( mCandidates ) {
+    result = mCandidates(src);
+    sort(result.begin(), result.end());
+    result.erase(unique(result.begin(), result.end()), result.end());
+    result.erase(remove_if(result.begin(), result.end(),
+			   [&](int dst) { return !mHasEdge(src, dst); }),
+		 result.end());
+  } else {
+    for ( int dst = 0; dst < mOrder; dst++ ) {
+      if ( mHasEdge(src, dst) ) {
+	result.push_back(dst);
+      }
+    }
+  }
+  return result;
+}
+
+int Graph::degree(int src) const {
+  return neighbors(src).size();
+}
+
+Adjacency Graph::adjacency() const {
+  vector<vector<bool> > incidences(mOrder, vector<bool>(mOrder));
+  for ( int src = 0; src < mOrder; src++ ) {
+    for ( int dst : neighbors(src) ) {
+      incidences[src][dst] = true;
+    }
+  }
+  return Adjacency(incidences);
+}
+
+void Graph::checkVertex(int vertex) const {
+  if ( vertex < 0 || vertex >= mOrder ) {
+    std::ostringstream sout;
+    sout << "Vertex " << vertex << " out of range for a graph of order " << mOrder;
+    throw std::out_of_range(sout.str());
+  }
 }
 
-template<class T>
-void printGraph(Solver* solver, const T& graph) {
-  cout << "   ";
+ostream& operator<<(ostream& out, const Graph& graph) {
+  out << "   ";
   for ( int i = 0; i < graph.order(); i++ ) {
-    cout << (i%10) << " ";
+    out << (i%10) << " ";
   }
-  cout << endl << endl;
+  out << endl << endl;
   for ( int i = 0; i < graph.order(); i++ ) {
-    cout << (i%10) << "  ";
+    out << (i%10) << "  ";
     for ( int j = 0; j < graph.order(); j++ ) {
-      cout << solver->modelValue(var(graph[i][j])) << " ";
+      out << graph.hasEdge(i, j) << " ";
     }
-    cout << endl;
+    out << endl;
   }
-  cout << endl << endl;
+  out << endl << endl;
+  return out;
 }
@@ -0,0 +1,89 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Fixed graphs, described implicitly.
+//
+// A Graph is an order and an edge predicate hasEdge(src, dst),
+// evaluated on demand; nothing is stored per entry, and no solver
+// variables or clauses are created.  Constraints that depend on the
+// graph (e.g., "adjacent cells map to adjacent vertices") query it
+// while they are built, so a known graph costs no CNF at all.
+//
+// neighbors() scans every vertex unless the graph also knows which
+// vertices can possibly be adjacent to a given one; the sparse
+// families below supply such candidates, so their neighbor lists cost
+// time proportional to the degree rather than the order.
+
+#ifndef GRAPHS_H
+#define GRAPHS_H
+
+#include <functional>
+#include <iostream>
+#include <vector>
+#include "adjacency.h"
+
+class Graph {
+public:
+  typedef std::function<bool(int, int)> edge_predicate_type;
+  // A superset of the vertices adjacent from a vertex, in any order
+  // and possibly with repeats
+  typedef std::function<std::vector<int>(int)> candidates_type;
+
+  Graph() = delete;
+  Graph(int order, edge_predicate_type hasEdge);
+  Graph(int order, edge_predicate_type hasEdge, candidates_type candidates);
+  explicit Graph(const Adjacency& adjacency);
+
+  // The incidence matrix read from a stream (see Adjacency::readMatrix)
+  static Graph read(std::istream& in);
+
+  // K_n, with no loops
+  static Graph complete(int order);
+  // A triangular prism of the given length, closed into a twisted ring
+  static Graph twistedTorus(int length);
+  // The grid for odd-cycle orientation reversals (see graphs.cpp)
+  static Graph orientationReversal(int cycleLength, int stages);
+
+  int order() const;
+  bool hasEdge(int src, int dst) const;
+
+  // Vertices adjacent from src, in increasing order
+  std::vector<int> neighbors(int src) const;
+  int degree(int src) const;
+
+  // The graph as a stored bitset matrix
+  Adjacency adjacency() const;
+
+private:
+  void checkVertex(int vertex) const;
+
+  int mOrder;
+  edge_predicate_type mHasEdge;
+  candidates_type mCandidates;
+};
+
+// The incidence matrix, with row and column numbers mod 10
+std::ostream& operator<<(std::ostream& out, const Graph& graph);
+
+#endif // GRAPHS_H
@@ -0,0 +1,48 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Non-template parts of Grid
+
+#include <sstream>
+#include <stdexcept>
+#include "grid.h"
+
+using namespace std;
+
+void throwGridIndexError(const char* what, int index, const char* dimension, int bound, 
+			 const char* container) {
+  ostringstream sout;
+  sout << "Invalid " << what << " " << index << " for " << container << " of " << dimension << " " << bound;
+  throw out_of_range(sout.str());
+}
+
+void throwGridArgumentError(const char* what, int value, const char* container, 
+			    const char* dimension, int bound) {
+  ostringstream sout;
+  sout << "Invalid " << what << " " << value << " for " << container;
+  if ( dimension ) {
+    sout << " of " << dimension << " " << bound;
+  }
+  throw invalid_argument(sout.str());
+}
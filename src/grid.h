@@ -38,6 +38,19 @@
 #include "cardinal.h"
 #include "objectcontainer.h"
 
+// Defining GRID_UNCHECKED (e.g. -DGRID_UNCHECKED in release builds)
+// removes the bounds checks from operator[]; at() and at_unchecked()
+// are unaffected.
+
+// Throw the out_of_range error for a bad row or column (or other
+// index), and the invalid_argument error for a bad size or other
+// parameter, of a Grid or any other container.  Kept out of line so
+// that the checks themselves stay small.
+void throwGridIndexError(const char* what, int index, const char* dimension, int bound, 
+			 const char* container = "Grid");
+void throwGridArgumentError(const char* what, int value, const char* container, 
+			    const char* dimension = nullptr, int bound = 0);
+
 // 2d lists are (ultimately) 1d lists.
 template<class obj_type>
 class Grid {
@@ -48,7 +61,22 @@ public:
        int width,
        builder_type builder);
 
-  SubscriptWrapper<obj_type> operator[](int row) const;
+  // Accessor for one row; checks the column and returns the cell
+  // itself rather than a copy.
+  struct RowAccess {
+    const Grid* grid;
+    int row;
+    const obj_type& operator()(int col) const;
+  };
+  typedef SubscriptWrapper<const obj_type&, int, RowAccess> row_type;
+
+  row_type operator[](int row) const;
+
+  // Single-call access to a cell, checked and unchecked.  Use the
+  // unchecked version only in loops whose bounds are known to lie
+  // within the grid.
+  const obj_type& at(int row, int col) const;
+  const obj_type& at_unchecked(int row, int col) const;
 
   Requirement typeRequirement() const;
   unsigned int numLiterals() const;
@@ -101,25 +129,44 @@ auto makeList(int height,
 }
 
 template<class obj_type>
-SubscriptWrapper<obj_type> Grid<obj_type>::operator[](int row) const {
+inline typename Grid<obj_type>::row_type Grid<obj_type>::operator[](int row) const {
+#ifndef GRID_UNCHECKED
   // Guard against nonsensical rows.
-  if ( row < 0 || row >= height() ) {
-    std::ostringstream sout;
-    sout << "Invalid row " << row << " for Grid of height " << height();
-    throw std::out_of_range(sout.str());
+  if ( row < 0 || row >= mHeight ) {
+    throwGridIndexError("row", row, "height", mHeight);
+  }
+#endif
+
+  return row_type(RowAccess{this, row});
+}
+
+template<class obj_type>
+inline const obj_type& Grid<obj_type>::RowAccess::operator()(int col) const {
+#ifndef GRID_UNCHECKED
+  // Guard against nonsensical columns.
+  if ( col < 0 || col >= grid->mWidth ) {
+    throwGridIndexError("column", col, "width", grid->mWidth);
   }
+#endif
 
-  return SubscriptWrapper<obj_type>([=] (int col) {
-    // Guard against nonsensical columns.
-      if ( col < 0 || col >= this->width() ) {
-	std::ostringstream sout;
-	sout << "Invalid column " << col << " for Grid of width " << this->width();
-	throw std::out_of_range(sout.str());
-      }
-
-      // Get the right cell out of the data list.
-      return this->data()[row*this->width() + col];
-    });
+  // Get the right cell out of the data list.
+  return grid->mData[row*grid->mWidth + col];
+}
+
+template<class obj_type>
+inline const obj_type& Grid<obj_type>::at(int row, int col) const {
+  if ( row < 0 || row >= mHeight ) {
+    throwGridIndexError("row", row, "height", mHeight);
+  }
+  if ( col < 0 || col >= mWidth ) {
+    throwGridIndexError("column", col, "width", mWidth);
+  }
+  return mData[row*mWidth + col];
+}
+
+template<class obj_type>
+inline const obj_type& Grid<obj_type>::at_unchecked(int row, int col) const {
+  return mData[row*mWidth + col];
 }
 
 template<class obj_type>
@@ -33,6 +33,8 @@
 #define MATRIX_H
 
 #include <iostream>
+#include <functional>
+#include <vector>
 #include "requirement.h"
 #include "cardinal.h"
 #include "grid.h"
@@ -41,7 +43,12 @@
 template<class Scalar>
 class MatrixView;
 
-template<class Scalar> // Are these needed now?
+template<typename Scalar>
+class Matrix;
+
+// Indexes a cell of a Matrix (or other matrix type, such as
+// CompactMatrix) by a pair of Scalars.
+template<class Scalar, class MatrixType = Matrix<Scalar> >
 class PairIndexedScalar;
 
 template<typename Scalar = Cardinal>
@@ -53,6 +60,15 @@ public:
 	 int min, 
 	 int max);
 
+  // Builds a matrix whose cell (row, col) takes one of the values
+  // domain(row, col).  Requires a Scalar constructible from a set of
+  // values, such as SparseCardinal or SparseOrdinal.
+  typedef std::function<std::vector<int>(int, int)> domain_type;
+  Matrix(Solver* solver,
+	 int height,
+	 int width,
+	 domain_type domain);
+
   Matrix() = delete;
   Matrix(const Matrix& copy) = default; // deep copy inherited from vector
   Matrix(Matrix&& move) = default;
@@ -66,9 +82,21 @@ public:
   MatrixView<Scalar> reflectH() const;
   MatrixView<Scalar> reflectV() const;
   MatrixView<Scalar> transpose() const;
+  MatrixView<Scalar> periodicRows(int period, int height) const;
+  MatrixView<Scalar> periodicCols(int period, int width) const;
+  MatrixView<Scalar> toroidal() const;
+
+  // Indexing by Scalars, so that the location of the Scalar indexed
+  // can depend on constraints.
+  struct PairIndexAccess {
+    const Matrix* matrix;
+    Scalar row;
+    PairIndexedScalar<Scalar> operator()(Scalar col) const;
+  };
+  typedef SubscriptWrapper<PairIndexedScalar<Scalar>, Scalar, PairIndexAccess> pair_row_type;
 
   using Grid<Scalar>::operator[];
-  SubscriptWrapper<PairIndexedScalar<Scalar>, Scalar> operator[](Scalar row) const;
+  pair_row_type operator[](Scalar row) const;
 
 };
 
@@ -88,6 +116,20 @@ Matrix<Scalar>::Matrix(Solver* _solver,
 
 }
 
+template<typename Scalar>
+Matrix<Scalar>::Matrix(Solver* _solver,
+		       int _height,
+		       int _width,
+		       domain_type _domain) :
+  Grid<Scalar>(_height,
+	       _width,
+	       [&] (int row, int col) {
+		 return Scalar(_solver, _domain(row, col));
+	       })
+{
+
+}
+
 template<typename Scalar>
 MatrixView<Scalar> Matrix<Scalar>::restrict(int startRow, 
 					    int startCol, 
@@ -121,14 +163,30 @@ MatrixView<Scalar> Matrix<Scalar>::transpose() const {
   return MatrixView<Scalar>(*this).transpose();
 }
 
+template<typename Scalar>
+MatrixView<Scalar> Matrix<Scalar>::periodicRows(int period, int height) const {
+  return MatrixView<Scalar>(*this).periodicRows(period, height);
+}
 
 template<typename Scalar>
-SubscriptWrapper<PairIndexedScalar<Scalar>, Scalar> Matrix<Scalar>::operator[](Scalar row) const {
-  auto closure = [=] (Scalar col) {
-    return PairIndexedScalar<Scalar>(this, row, col);
-  };
-  
-  return SubscriptWrapper<PairIndexedScalar<Scalar>, Scalar>(closure);
+MatrixView<Scalar> Matrix<Scalar>::periodicCols(int period, int width) const {
+  return MatrixView<Scalar>(*this).periodicCols(period, width);
+}
+
+template<typename Scalar>
+MatrixView<Scalar> Matrix<Scalar>::toroidal() const {
+  return MatrixView<Scalar>(*this).toroidal();
+}
+
+
+template<typename Scalar>
+typename Matrix<Scalar>::pair_row_type Matrix<Scalar>::operator[](Scalar row) const {
+  return pair_row_type(PairIndexAccess{this, row});
+}
+
+template<typename Scalar>
+inline PairIndexedScalar<Scalar> Matrix<Scalar>::PairIndexAccess::operator()(Scalar col) const {
+  return PairIndexedScalar<Scalar>(matrix, row, col);
 }
 
 // Output operator
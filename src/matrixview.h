@@ -39,7 +39,10 @@
 #ifndef MATRIXVIEW_H
 #define MATRIXVIEW_H
 
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <stdexcept>
 #include "requirement.h"
 #include "solver.h"
 #include "cardinal.h"
@@ -48,6 +51,27 @@
 template<typename Scalar>
 class Matrix;
 
+// A view is stored in affine form: view cell (row, col) is base cell
+//
+//   (rowOrigin + rowFromRow*row + rowFromCol*col,
+//    colOrigin + colFromRow*row + colFromCol*col),
+//
+// Views of a Matrix have coefficients of 0 and +-1; slices of a
+// Tensor3 (stored as a Matrix of stacked layers) may step several base
+// rows at a time.  Transformations compose by updating the
+// coefficients once, and the equivalent offset and strides into the
+// base matrix's row-major storage are precomputed, so accessing a cell
+// never branches on the transformation.
+//
+// Periodic and toroidal views alias cells rather than constraining
+// them.  A periodic axis first maps its index i to (sign*i + shift) mod
+// period, and then applies the affine form, so a view can repeat a few
+// columns across a much wider grid without any new variables.  A
+// toroidal view accepts any index and reduces it modulo the view's own
+// height and width.
+template<typename Scalar>
+class Tensor3View;
+
 template<typename Scalar = Cardinal>
 class MatrixView {
 public:
@@ -65,44 +89,191 @@ public:
   MatrixView reflectV() const;
   MatrixView transpose() const;
 
+  // View of the given height (or width) whose row (or column) i is
+  // this view's row (or column) i mod period.  The period must be
+  // positive and at most this view's height (or width), and the axis
+  // must not already be periodic.
+  MatrixView periodicRows(int period, int height) const;
+  MatrixView periodicCols(int period, int width) const;
+
+  // View of the same cells whose indices wrap around at the edges, so
+  // that [-1] is the last row and [height] is the first.  Views derived
+  // from a toroidal view wrap around their own edges.  To make a grid
+  // periodic horizontally, for instance, constrain each cell against
+  // its neighbor at col+1 through a toroidal view, for col up to and
+  // including width-1.
+  MatrixView toroidal() const;
+  bool isToroidal() const;
+
   template<typename LhsMatrixType>
   Requirement operator==(const LhsMatrixType& lhs);
+
+  // Accessors for one row of the view, by int or by Scalar.  The int
+  // version returns the underlying cell rather than a copy.
+  struct RowAccess {
+    const MatrixView* view;
+    int row;
+    const Scalar& operator()(int col) const;
+  };
+  struct PairIndexAccess {
+    const MatrixView* view;
+    Scalar row;
+    PairIndexedScalar<Scalar, MatrixView> operator()(Scalar col) const;
+  };
+  typedef SubscriptWrapper<const Scalar&, int, RowAccess> row_type;
+  typedef SubscriptWrapper<PairIndexedScalar<Scalar, MatrixView>, Scalar, PairIndexAccess> pair_row_type;
   
-  // Return a vector representing a row of the matrix.  Can be used to double-index the matrix.
-  SubscriptWrapper<Scalar> operator[](int index) const;
+  // Return a vector representing a row of the matrix.  Can be used
+  // to double-index the matrix.  Like Grid, bounds-checked unless
+  // GRID_UNCHECKED is defined.
+  row_type operator[](int index) const;
 
   // Allows indexing of Scalars by Scalars.  Thus, the location of the Scalar indexed can
   // depend on constraints.
-  SubscriptWrapper<PairIndexedScalar<Scalar>, Scalar> operator[](Scalar row) const;
+  pair_row_type operator[](Scalar row) const;
+
+  // Iterates over cells in row-major order by adding fixed strides, or
+  // through the periodic mapping if the view has one.
+  class const_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Scalar value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Scalar* pointer;
+    typedef const Scalar& reference;
+
+    const_iterator(const MatrixView* view, 
+		   int row, 
+		   std::ptrdiff_t rowJump, 
+		   unsigned int index);
+
+    reference operator*() const;
+    pointer operator->() const { return &**this; }
+    const_iterator& operator++();
+    const_iterator operator++(int);
+
+    bool operator==(const const_iterator& rhs) const { return mIndex == rhs.mIndex; }
+    bool operator!=(const const_iterator& rhs) const { return mIndex != rhs.mIndex; }
+
+  private:
+    const MatrixView* mView;
+    const Scalar* mCells;
+    std::ptrdiff_t mPosition;
+    int mRow;
+    int mCol;
+    int mWidth;
+    std::ptrdiff_t mColStride;
+    std::ptrdiff_t mRowJump;
+    unsigned int mIndex;
+  };
+
+  // One row of the view, as an iterable range.
+  class Row {
+  public:
+    Row(const MatrixView* view, int row) : mView(view), mRow(row) {}
+
+    const_iterator begin() const;
+    const_iterator end() const;
+    const Scalar& operator[](int col) const { return (*mView)[mRow][col]; }
+    unsigned int size() const { return mView->width(); }
+
+  private:
+    const MatrixView* mView;
+    int mRow;
+  };
+
+  // Iterates over the rows of the view.
+  class row_iterator {
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Row value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Row* pointer;
+    typedef Row reference;
+
+    row_iterator(const MatrixView* view, int row) : mView(view), mRow(row) {}
+
+    Row operator*() const { return Row(mView, mRow); }
+    row_iterator& operator++() { mRow++; return *this; }
+    row_iterator operator++(int) { row_iterator old(*this); mRow++; return old; }
+
+    bool operator==(const row_iterator& rhs) const { return mRow == rhs.mRow; }
+    bool operator!=(const row_iterator& rhs) const { return mRow != rhs.mRow; }
+
+  private:
+    const MatrixView* mView;
+    int mRow;
+  };
+
+  struct RowRange {
+    row_iterator first;
+    row_iterator last;
+    row_iterator begin() const { return first; }
+    row_iterator end() const { return last; }
+  };
+
+  // Cells in row-major order, and rows in order
+  const_iterator begin() const;
+  const_iterator end() const;
+  RowRange rows() const;
 
   unsigned int height() const;
   unsigned int width() const;
 
+  friend class Tensor3View<Scalar>;
 private:
-  template<typename T> 
-  T transformedRow(T row, T col) const;
-  template<typename T>
-  T transformedCol(T row, T col) const;
+  // A view with the given affine form; see above.
+  MatrixView(const Matrix<Scalar>* base,
+	     int height, int width,
+	     int rowOrigin, int rowFromRow, int rowFromCol,
+	     int colOrigin, int colFromRow, int colFromCol);
+
+  // Recompute the storage offset and strides from the affine form.
+  void updateStrides();
+
+  // index mod period, in [0, period)
+  static int wrapIndex(int index, int period);
+
+  // The periodic mapping of one axis; a period of 0 means none.
+  struct Wrap {
+    int period;
+    int sign;
+    int shift;
+    int operator()(int index) const { return wrapIndex(sign*index + shift, period); }
+  };
+
+  bool isPeriodic() const;
+
+  // The cell at an in-range view index
+  const Scalar& cell(int row, int col) const;
 
   const Matrix<Scalar>* baseMatrix;
-  int mStartRow;
-  int mStartCol;
-  int mEndRow;
-  int mEndCol;
-
-  bool mFlipV;
-  bool mFlipH;
-  bool mTransposed;
-  
+  int mHeight;
+  int mWidth;
+
+  int mRowOrigin;
+  int mColOrigin;
+  int mRowFromRow;
+  int mRowFromCol;
+  int mColFromRow;
+  int mColFromCol;
+
+  std::ptrdiff_t mOffset;
+  std::ptrdiff_t mRowStride;
+  std::ptrdiff_t mColStride;
+
+  Wrap mRowWrap;
+  Wrap mColWrap;
+  bool mToroidal;
 };
 
 // Output operator
 template<typename Scalar>
 std::ostream& operator<<(std::ostream& out, const MatrixView<Scalar>& matrix) {
-  for ( int i = 0; i < matrix.height(); i++) {
+  for ( const auto& row : matrix.rows() ) {
     out << "    ";
-    for ( int j = 0; j < matrix.width(); j++ ) {
-      out << matrix[i] << " ";
+    for ( const Scalar& cell : row ) {
+      out << cell << " ";
     }
     out << std::endl;
   }
@@ -113,35 +284,48 @@ std::ostream& operator<<(std::ostream& out, const MatrixView<Scalar>& matrix) {
 template<typename Scalar>
 MatrixView<Scalar>::MatrixView(const Matrix<Scalar>& mat) :
   baseMatrix(&mat),
-  mStartRow(0),
-  mStartCol(0),
-  mEndRow(mat.height()),
-  mEndCol(mat.width()),
-  mTransposed(false),
-  mFlipH(false),
-  mFlipV(false)
+  mHeight(mat.height()),
+  mWidth(mat.width()),
+  mRowOrigin(0),
+  mColOrigin(0),
+  mRowFromRow(1),
+  mRowFromCol(0),
+  mColFromRow(0),
+  mColFromCol(1),
+  mRowWrap{0, 1, 0},
+  mColWrap{0, 1, 0},
+  mToroidal(false)
 {
-
+  updateStrides();
 }
 
 template<typename Scalar>
-template<typename T>
-T MatrixView<Scalar>::transformedRow(T row, T col) const {
-  if ( !mTransposed ) {
-    return mFlipV ? mEndRow-1 - row : mStartRow + row;
-  } else {
-    return mFlipH ? mEndRow-1 - col : mStartRow + col;
-  }  
+void MatrixView<Scalar>::updateStrides() {
+  std::ptrdiff_t baseWidth = baseMatrix->width();
+  mOffset    = mRowOrigin  * baseWidth + mColOrigin;
+  mRowStride = mRowFromRow * baseWidth + mColFromRow;
+  mColStride = mRowFromCol * baseWidth + mColFromCol;
 }
 
 template<typename Scalar>
-template<typename T>
-T MatrixView<Scalar>::transformedCol(T row, T col) const {
-  if ( !mTransposed ) {
-    return mFlipH ? mEndCol-1 - col : mStartCol + col;
-  } else {
-    return mFlipV ? mEndCol-1 - row : mStartCol + row;
-  }  
+MatrixView<Scalar>::MatrixView(const Matrix<Scalar>* base,
+			       int height, int width,
+			       int rowOrigin, int rowFromRow, int rowFromCol,
+			       int colOrigin, int colFromRow, int colFromCol) :
+  baseMatrix(base),
+  mHeight(height),
+  mWidth(width),
+  mRowOrigin(rowOrigin),
+  mColOrigin(colOrigin),
+  mRowFromRow(rowFromRow),
+  mRowFromCol(rowFromCol),
+  mColFromRow(colFromRow),
+  mColFromCol(colFromCol),
+  mRowWrap{0, 1, 0},
+  mColWrap{0, 1, 0},
+  mToroidal(false)
+{
+  updateStrides();
 }
 
 // Return a submatrix of the current matrix
@@ -159,123 +343,274 @@ MatrixView<Scalar> MatrixView<Scalar>::restrict(int startRow,
     throw std::out_of_range("Bad dimensions for matrix view; out of bounds.");
   }
 
-  // We need to calculate the new bounding box, taking into account
-  // transformations that are already present.  To do this, begin by
-  // transforming the four corners of the box.
-  auto newStartRow = transformedRow(startRow, startCol);
-  auto newStartCol = transformedCol(startRow, startCol);
-  auto newEndRow = transformedRow(endRow, endCol);
-  auto newEndCol = transformedCol(endRow, endCol);
-
-  // Now, the corners may be out of order; i.e., we may have start >
-  // end.  So swap them if necessary.  Note that the "end" is always
-  // one beyond the range, whereas the "start" is always in the range,
-  // so add ones to compensate.
-  if ( (mFlipV && !mTransposed) || (mFlipH && mTransposed) ) {
-    std::swap(newStartRow, newEndRow);
-    newStartRow++;
-    newEndRow++;
+  // Shift the origin to the new upper-left corner, or the periodic
+  // mapping of a periodic axis.
+  MatrixView<Scalar> newView(*this);
+  if ( mRowWrap.period ) {
+    newView.mRowWrap.shift += mRowWrap.sign*startRow;
+  } else {
+    newView.mRowOrigin += mRowFromRow*startRow;
+    newView.mColOrigin += mColFromRow*startRow;
   }
-
-  if ( (mFlipH && !mTransposed) || (mFlipV && mTransposed) ) {
-    std::swap(newStartCol, newEndCol);
-    newStartCol++;
-    newEndCol++;
+  if ( mColWrap.period ) {
+    newView.mColWrap.shift += mColWrap.sign*startCol;
+  } else {
+    newView.mRowOrigin += mRowFromCol*startCol;
+    newView.mColOrigin += mColFromCol*startCol;
   }
-
-  MatrixView<Scalar> newView(*this);
-  newView.mStartRow = newStartRow;
-  newView.mStartCol = newStartCol;
-  newView.mEndRow   = newEndRow;
-  newView.mEndCol   = newEndCol;
+  newView.mHeight = endRow - startRow;
+  newView.mWidth  = endCol - startCol;
+  newView.updateStrides();
 
   return newView;
 }
 
 template<typename Scalar>
 MatrixView<Scalar> MatrixView<Scalar>::rotCCW() const {
-  return (*this).transpose().reflectH();
+  return (*this).transpose().reflectV();
 }
 
 template<typename Scalar>
 MatrixView<Scalar> MatrixView<Scalar>::rotCW() const {
-  return (*this).transpose().reflectV();
+  return (*this).transpose().reflectH();
 }
 
+// Substitute col -> width-1-col
 template<typename Scalar>
 MatrixView<Scalar> MatrixView<Scalar>::reflectH() const {
   MatrixView<Scalar> newView(*this);
-  if ( !newView.mTransposed ) {
-    newView.mFlipH = !newView.mFlipH;
-  } else {
-    newView.mFlipV = !newView.mFlipV;
+  if ( mColWrap.period ) {
+    newView.mColWrap.shift += mColWrap.sign*(mWidth-1);
+    newView.mColWrap.sign = -mColWrap.sign;
+    return newView;
   }
+  newView.mRowOrigin += mRowFromCol*(mWidth-1);
+  newView.mColOrigin += mColFromCol*(mWidth-1);
+  newView.mRowFromCol = -mRowFromCol;
+  newView.mColFromCol = -mColFromCol;
+  newView.updateStrides();
   return newView;
 }
 
+// Substitute row -> height-1-row
 template<typename Scalar>
 MatrixView<Scalar> MatrixView<Scalar>::reflectV() const {
   MatrixView<Scalar> newView(*this);
-  if ( !newView.mTransposed ) {
-    newView.mFlipV = !newView.mFlipV;
-  } else {
-    newView.mFlipH = !newView.mFlipH;
+  if ( mRowWrap.period ) {
+    newView.mRowWrap.shift += mRowWrap.sign*(mHeight-1);
+    newView.mRowWrap.sign = -mRowWrap.sign;
+    return newView;
   }
+  newView.mRowOrigin += mRowFromRow*(mHeight-1);
+  newView.mColOrigin += mColFromRow*(mHeight-1);
+  newView.mRowFromRow = -mRowFromRow;
+  newView.mColFromRow = -mColFromRow;
+  newView.updateStrides();
   return newView;
 }
 
+// Exchange row and col
 template<typename Scalar>
 MatrixView<Scalar> MatrixView<Scalar>::transpose() const {
   MatrixView<Scalar> newView(*this);
-  newView.mTransposed = !newView.mTransposed;
+  std::swap(newView.mHeight, newView.mWidth);
+  std::swap(newView.mRowFromRow, newView.mRowFromCol);
+  std::swap(newView.mColFromRow, newView.mColFromCol);
+  std::swap(newView.mRowWrap, newView.mColWrap);
+  newView.updateStrides();
+  return newView;
+}
+
+template<typename Scalar>
+MatrixView<Scalar> MatrixView<Scalar>::periodicRows(int period, int height) const {
+  if ( period <= 0 || period > mHeight ) {
+    throwGridArgumentError("period", period, "periodic MatrixView", "height", mHeight);
+  }
+  if ( height < 0 ) {
+    throwGridArgumentError("height", height, "periodic MatrixView");
+  }
+  if ( mRowWrap.period ) {
+    throw std::invalid_argument("Rows of view are already periodic.");
+  }
+
+  MatrixView<Scalar> newView(*this);
+  newView.mRowWrap = Wrap{period, 1, 0};
+  newView.mHeight = height;
+  return newView;
+}
+
+template<typename Scalar>
+MatrixView<Scalar> MatrixView<Scalar>::periodicCols(int period, int width) const {
+  if ( period <= 0 || period > mWidth ) {
+    throwGridArgumentError("period", period, "periodic MatrixView", "width", mWidth);
+  }
+  if ( width < 0 ) {
+    throwGridArgumentError("width", width, "periodic MatrixView");
+  }
+  if ( mColWrap.period ) {
+    throw std::invalid_argument("Columns of view are already periodic.");
+  }
+
+  MatrixView<Scalar> newView(*this);
+  newView.mColWrap = Wrap{period, 1, 0};
+  newView.mWidth = width;
+  return newView;
+}
+
+template<typename Scalar>
+MatrixView<Scalar> MatrixView<Scalar>::toroidal() const {
+  MatrixView<Scalar> newView(*this);
+  newView.mToroidal = true;
   return newView;
 }
 
+template<typename Scalar>
+bool MatrixView<Scalar>::isToroidal() const {
+  return mToroidal;
+}
+
+template<typename Scalar>
+inline int MatrixView<Scalar>::wrapIndex(int index, int period) {
+  int result = index % period;
+  return result < 0 ? result + period : result;
+}
+
+template<typename Scalar>
+inline bool MatrixView<Scalar>::isPeriodic() const {
+  return mRowWrap.period != 0 || mColWrap.period != 0;
+}
+
+template<typename Scalar>
+inline const Scalar& MatrixView<Scalar>::cell(int row, int col) const {
+  if ( mRowWrap.period ) row = mRowWrap(row);
+  if ( mColWrap.period ) col = mColWrap(col);
+  return baseMatrix->data()[mOffset + row*mRowStride + col*mColStride];
+}
+
 // Return a vector representing a row of the matrix.  Can be used to double-index the matrix.
 template<typename Scalar>
-SubscriptWrapper<Scalar> MatrixView<Scalar>::operator[](int row) const {
-  // This closure almost identical to that in the other operator[].
-  // Not sure if it's worth the additional complexity to consolidate code.
-  auto closure = [=] (int col) {
-    auto accessRow = this->transformedRow(row, col);
-    auto accessCol = this->transformedCol(row, col);
-    return (*baseMatrix)[accessRow][accessCol];
-  };
+typename MatrixView<Scalar>::row_type MatrixView<Scalar>::operator[](int row) const {
+  if ( mToroidal && mHeight > 0 ) {
+    row = wrapIndex(row, mHeight);
+  }
 
-  return SubscriptWrapper<Scalar>(closure);
+#ifndef GRID_UNCHECKED
+  if ( row < 0 || row >= mHeight ) {
+    throwGridIndexError("row", row, "height", mHeight, "MatrixView");
+  }
+#endif
+
+  return row_type(RowAccess{this, row});
+}
+
+template<typename Scalar>
+inline const Scalar& MatrixView<Scalar>::RowAccess::operator()(int col) const {
+  if ( view->mToroidal && view->mWidth > 0 ) {
+    col = wrapIndex(col, view->mWidth);
+  }
+
+#ifndef GRID_UNCHECKED
+  if ( col < 0 || col >= view->mWidth ) {
+    throwGridIndexError("column", col, "width", view->mWidth, "MatrixView");
+  }
+#endif
+
+  return view->cell(row, col);
 }
 
 // Allows indexing of Scalars by Scalars.  Thus, the location of the Scalar indexed can
 // depend on constraints.
 template<typename Scalar>
-SubscriptWrapper<PairIndexedScalar<Scalar>, Scalar> MatrixView<Scalar>::operator[](Scalar row) const {
-  // This closure almost identical to that in the other operator[].
-  // Not sure if it's worth the additional complexity to consolidate code.
-  auto closure = [=] (Scalar col) {
-    auto accessRow = this->transformedRow(row, col);
-    auto accessCol = this->transformedCol(row, col);
-    return (*baseMatrix)[accessRow][accessCol];
-  };
-  
-  return SubscriptWrapper<PairIndexedScalar<Scalar>, Scalar>(closure);
+typename MatrixView<Scalar>::pair_row_type MatrixView<Scalar>::operator[](Scalar row) const {
+  return pair_row_type(PairIndexAccess{this, row});
 }
 
+// Scalar-indexed cells are selected within the view itself, so the
+// range requirements are relative to the view's bounds.
 template<typename Scalar>
-unsigned int MatrixView<Scalar>::height() const {
-  if ( !mTransposed ) {
-    return mEndRow - mStartRow;
-  } else {
-    return mEndCol - mStartCol;
+inline PairIndexedScalar<Scalar, MatrixView<Scalar> > 
+MatrixView<Scalar>::PairIndexAccess::operator()(Scalar col) const {
+  return PairIndexedScalar<Scalar, MatrixView>(view, row, col);
+}
+
+template<typename Scalar>
+MatrixView<Scalar>::const_iterator::const_iterator(const MatrixView* view, 
+						   int row, 
+						   std::ptrdiff_t rowJump, 
+						   unsigned int index) :
+  mView(view),
+  mCells(view->baseMatrix->data().data()),
+  mPosition(view->mOffset + row*view->mRowStride),
+  mRow(row),
+  mCol(0),
+  mWidth(view->mWidth),
+  mColStride(view->mColStride),
+  mRowJump(rowJump),
+  mIndex(index)
+{
+}
+
+template<typename Scalar>
+inline typename MatrixView<Scalar>::const_iterator::reference 
+MatrixView<Scalar>::const_iterator::operator*() const {
+  if ( mView->isPeriodic() ) {
+    return mView->cell(mRow, mCol);
   }
+  return mCells[mPosition];
 }
 
 template<typename Scalar>
-unsigned int MatrixView<Scalar>::width() const {
-  if ( !mTransposed ) {
-    return mEndCol - mStartCol;
-  } else {
-    return mEndRow - mStartRow;
+inline typename MatrixView<Scalar>::const_iterator& MatrixView<Scalar>::const_iterator::operator++() {
+  mPosition += mColStride;
+  mIndex++;
+  if ( ++mCol == mWidth ) {
+    mCol = 0;
+    mRow++;
+    mPosition += mRowJump;
   }
+  return *this;
+}
+
+template<typename Scalar>
+typename MatrixView<Scalar>::const_iterator MatrixView<Scalar>::const_iterator::operator++(int) {
+  const_iterator old(*this);
+  ++(*this);
+  return old;
+}
+
+template<typename Scalar>
+typename MatrixView<Scalar>::const_iterator MatrixView<Scalar>::begin() const {
+  return const_iterator(this, 0, mRowStride - mWidth*mColStride, 0);
+}
+
+template<typename Scalar>
+typename MatrixView<Scalar>::const_iterator MatrixView<Scalar>::end() const {
+  return const_iterator(this, 0, mRowStride - mWidth*mColStride, mHeight*mWidth);
+}
+
+template<typename Scalar>
+typename MatrixView<Scalar>::const_iterator MatrixView<Scalar>::Row::begin() const {
+  return const_iterator(mView, mRow, 0, 0);
+}
+
+template<typename Scalar>
+typename MatrixView<Scalar>::const_iterator MatrixView<Scalar>::Row::end() const {
+  return const_iterator(mView, mRow, 0, mView->mWidth);
+}
+
+template<typename Scalar>
+typename MatrixView<Scalar>::RowRange MatrixView<Scalar>::rows() const {
+  return RowRange{row_iterator(this, 0), row_iterator(this, mHeight)};
+}
+
+template<typename Scalar>
+unsigned int MatrixView<Scalar>::height() const {
+  return mHeight;
+}
+
+template<typename Scalar>
+unsigned int MatrixView<Scalar>::width() const {
+  return mWidth;
 }
 
 template<typename Scalar>
@@ -61,9 +61,31 @@ unsigned int MinisatSolver::newVars(unsigned int numReservations) {
 
 // Register a single requirement
 void MinisatSolver::require(const Clause& clause) {
-  vec<Minisat::Lit> vecClause;
-  
-  for ( auto lit : clause ) {
+  // Truth holds already; adding it as an (empty) clause would instead
+  // make the problem unsatisfiable.
+  if ( clause.isTruth() ) {
+    return;
+  }
+
+  vector<Literal> lits(clause.begin(), clause.end());
+  addClause(lits);
+}
+
+// Register packed clauses without building Clause objects
+void MinisatSolver::require(const ClauseBuffer& buffer) {
+  vector<Literal> lits;
+  buffer.forEachClause([&] (const int* packed, int size) {
+      lits.clear();
+      for ( int i = 0; i < size; i++ ) {
+	lits.push_back(ClauseBuffer::unpack(packed[i]));
+      }
+      addClause(lits);
+    });
+}
+
+// Check, fold and pass on a clause
+void MinisatSolver::addClause(vector<Literal>& lits) {
+  for ( auto lit : lits ) {
     if ( solver.nVars() <= lit.getVar() ) {
       std::ostringstream sout;
       sout << "solver's variable space does not accommodate new literal "
@@ -71,10 +93,16 @@ void MinisatSolver::require(const Clause& clause) {
 	   << "This should not be necessary, why is this not already done?.";
       throw std::out_of_range(sout.str());
     }
-  
+  }
+
+  if ( !fold(lits) ) {
+    return;
+  }
+
+  vec<Minisat::Lit> vecClause;
+  for ( auto lit : lits ) {
     vecClause.push(Minisat::mkLit(lit.getVar(), lit.isPos()));
   }
-  
   solver.addClause(vecClause);
 }
 
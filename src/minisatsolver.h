@@ -29,6 +29,7 @@
 
 #include <minisat/core/Solver.h>
 #include <chrono>
+#include <vector>
 #include "solver.h"
 
 class MinisatSolver : public Solver {
@@ -42,6 +43,7 @@ public:
   // Register a single requirement
   using Solver::require;
   virtual void require(const Clause& clause) override;
+  virtual void require(const ClauseBuffer& buffer) override;
 
   // Solve
   virtual bool solve() override;
@@ -59,6 +61,9 @@ public:
   virtual bool modelValue(unsigned int var) const override;
 
 private:
+  // Check, fold and pass on a clause
+  void addClause(std::vector<Literal>& lits);
+
   enum truefalseinterrupt {
     tfiFalse = 0,
     tfiTrue = 1,
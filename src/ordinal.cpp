@@ -47,6 +47,17 @@ Ordinal::Ordinal(Solver* _solver, int _min, int _max) :
   mSolver->require(typeRequirement());
 }
 
+// A handle on an ordinal whose literals were already allocated
+// (and requirements registered) starting at startingVar.
+Ordinal::Ordinal(Solver* _solver, int _min, int _max, unsigned int _startingVar) :
+  mMin(_min),
+  mMax(_max),
+  mSolver(_solver),
+  mStartingVar(_startingVar),
+  mNegated(false)
+{
+}
+
 Ordinal::Ordinal(Solver* _solver, 
 		 int _min, 
 		 int _max, 
@@ -85,6 +96,10 @@ int Ordinal::max() const {
   return mMax;
 }
 
+Solver* Ordinal::solver() const {
+  return mSolver;
+}
+
 // Addition of a ordinal by a constant.  Surprisingly easy to implement, and useful.
 // If scl is a Ordinal, then scl+1 returns a ordinal that is equal to n+1 iff scl is equal to n.
 // Uses no additional literals or requirements.
@@ -56,6 +56,10 @@ public:
   Ordinal(Solver* solver,
 	  int min, 
 	  int max);
+  Ordinal(Solver* solver,
+	  int min,
+	  int max,
+	  unsigned int startingVar);
 
   Ordinal() = delete;
   Ordinal(const Ordinal& copy) = default;
@@ -111,6 +115,9 @@ public:
   int min() const;
   int max() const;
 
+  // The solver on which the ordinal's literals live
+  Solver* solver() const;
+
   // The value assigned in the model, after solving, if a solution is
   // available.
   int modelValue() const;
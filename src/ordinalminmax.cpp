@@ -0,0 +1,95 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of the n-ary min() and max() over Ordinals
+
+#include <algorithm>
+#include <stdexcept>
+#include "ordinalminmax.h"
+
+using namespace std;
+
+namespace {
+// Take the minimum of ordinals[begin, end) as a balanced tree.
+Ordinal minRange(const vector<Ordinal>& ordinals, int begin, int end) {
+  if ( end - begin == 1 ) {
+    return ordinals[begin];
+  }
+
+  int middle = begin + (end - begin)/2;
+  Ordinal lhs = minRange(ordinals, begin, middle);
+  Ordinal rhs = minRange(ordinals, middle, end);
+
+  Solver* solver = lhs.solver();
+  Ordinal result(solver,
+		 std::min(lhs.min(), rhs.min()),
+		 std::min(lhs.max(), rhs.max()));
+  solver->require(minimum(lhs, rhs, result));
+  return result;
+}
+
+void checkOrdinals(const vector<Ordinal>& ordinals) {
+  if ( ordinals.empty() ) {
+    throw invalid_argument("Cannot take the min or max of no Ordinals.");
+  }
+
+  for ( const Ordinal& ord : ordinals ) {
+    if ( ord.solver() != ordinals.front().solver() ) {
+      throw invalid_argument("min() and max() require all Ordinals to share a solver.");
+    }
+  }
+}
+} // namespace
+
+// result <= x exactly when lhs <= x or rhs <= x.  Out-of-range atoms
+// are truth or falsity, which takes care of the ends of the ranges.
+Requirement minimum(const Ordinal& lhs, const Ordinal& rhs, const Ordinal& result) {
+  Requirement req;
+
+  int start = std::min(lhs.min(), rhs.min());
+  int end   = std::max(lhs.max(), rhs.max());
+  for ( int x = start; x < end; x++ ) {
+    req &= implication(lhs <= x, result <= x);
+    req &= implication(rhs <= x, result <= x);
+    req &= ~(result <= x) | (lhs <= x) | (rhs <= x);
+  }
+
+  return req;
+}
+
+Ordinal min(const vector<Ordinal>& ordinals) {
+  checkOrdinals(ordinals);
+  return minRange(ordinals, 0, ordinals.size());
+}
+
+Ordinal max(const vector<Ordinal>& ordinals) {
+  checkOrdinals(ordinals);
+
+  vector<Ordinal> negations;
+  for ( const Ordinal& ord : ordinals ) {
+    negations.push_back(-ord);
+  }
+
+  return -min(negations);
+}
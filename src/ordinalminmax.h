@@ -0,0 +1,78 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// N-ary minima and maxima of Ordinals.
+//
+// OrdinalMinExpr handles min(ord1, ord2), re-deriving its clauses at
+// every comparison.  The versions here take any number of Ordinals and
+// reduce them pairwise in a balanced tree, materializing one auxiliary
+// Ordinal per reduction node.  The result is an ordinary Ordinal, so
+// it can be compared as often as needed (e.g., row, column or region
+// minima of a Matrix<Ordinal>) without expanding anything again.
+//
+// max() costs the same as min(), since max(a,b) = -min(-a,-b) and
+// negating an Ordinal is free.
+//
+// Like the Ordinal constructor, these register the requirements
+// defining the new Ordinals with the solver immediately.
+//
+// Beware that, with "using namespace std", min({ord1, ord2}) picks
+// std::min over an initializer_list; pass a vector instead.
+
+#ifndef ORDINALMINMAX_H
+#define ORDINALMINMAX_H
+
+#include <vector>
+#include "requirement.h"
+#include "solver.h"
+#include "ordinal.h"
+
+// The requirement that result == min(lhs, rhs).
+Requirement minimum(const Ordinal& lhs, const Ordinal& rhs, const Ordinal& result);
+
+// The minimum/maximum of any positive number of Ordinals, all on the
+// same solver.
+Ordinal min(const std::vector<Ordinal>& ordinals);
+Ordinal max(const std::vector<Ordinal>& ordinals);
+
+// Any other container (or view) of Ordinals that supports range-for.
+template<class Container>
+Ordinal min(const Container& container) {
+  std::vector<Ordinal> ordinals;
+  for ( const Ordinal& ord : container ) {
+    ordinals.push_back(ord);
+  }
+  return min(ordinals);
+}
+
+template<class Container>
+Ordinal max(const Container& container) {
+  std::vector<Ordinal> ordinals;
+  for ( const Ordinal& ord : container ) {
+    ordinals.push_back(ord);
+  }
+  return max(ordinals);
+}
+
+#endif // ORDINALMINMAX_H
@@ -0,0 +1,80 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of sum() over Ordinals
+
+#include <stdexcept>
+#include "ordinalsum.h"
+
+using namespace std;
+
+namespace {
+// Sum ordinals[begin, end) as a balanced tree.
+Ordinal sumRange(const vector<Ordinal>& ordinals, int begin, int end) {
+  if ( end - begin == 1 ) {
+    return ordinals[begin];
+  }
+
+  int middle = begin + (end - begin)/2;
+  Ordinal lhs = sumRange(ordinals, begin, middle);
+  Ordinal rhs = sumRange(ordinals, middle, end);
+
+  Solver* solver = lhs.solver();
+  Ordinal total(solver, lhs.min() + rhs.min(), lhs.max() + rhs.max() - 1);
+  solver->require(totalizer(lhs, rhs, total));
+  return total;
+}
+} // namespace
+
+// For all values i of lhs and j of rhs,
+//   lhs >= i and rhs >= j imply total >= i+j, and
+//   lhs <= i and rhs <= j imply total <= i+j.
+// Premises and conclusions at the ends of the ranges are truth, which
+// the Atom-based clauses take care of on their own.
+Requirement totalizer(const Ordinal& lhs, const Ordinal& rhs, const Ordinal& total) {
+  Requirement result;
+
+  for ( int i = lhs.min(); i < lhs.max(); i++ ) {
+    for ( int j = rhs.min(); j < rhs.max(); j++ ) {
+      result &= ~(lhs >= i) | ~(rhs >= j) | (total >= i+j);
+      result &= ~(lhs <= i) | ~(rhs <= j) | (total <= i+j);
+    }
+  }
+
+  return result;
+}
+
+Ordinal sum(const vector<Ordinal>& ordinals) {
+  if ( ordinals.empty() ) {
+    throw invalid_argument("Cannot take the sum of no Ordinals; the result would have no solver.");
+  }
+
+  for ( const Ordinal& ord : ordinals ) {
+    if ( ord.solver() != ordinals.front().solver() ) {
+      throw invalid_argument("sum() requires all Ordinals to share a solver.");
+    }
+  }
+
+  return sumRange(ordinals, 0, ordinals.size());
+}
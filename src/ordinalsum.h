@@ -0,0 +1,66 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// N-ary sums of Ordinals.
+//
+// OrdinalAddExpr handles ord1 + ord2, but has to re-derive
+// O(range1*range2) clauses at every comparison, and does not extend to
+// more than two operands.  sum() instead builds a balanced tree of
+// totalizers: each internal node of the tree is an auxiliary Ordinal
+// defined to be the sum of its two children, and the root is returned
+// as an ordinary Ordinal.  Comparisons against the result then cost
+// what comparisons against any Ordinal cost (a single literal for a
+// constant bound), and the partial sums are shared by every comparison
+// made against the result.
+//
+// Like the Ordinal constructor, sum() registers the requirements
+// defining the new Ordinals with the solver immediately.
+
+#ifndef ORDINALSUM_H
+#define ORDINALSUM_H
+
+#include <vector>
+#include "requirement.h"
+#include "solver.h"
+#include "ordinal.h"
+
+// The requirement that total == lhs + rhs, for Ordinals in the order
+// encoding.
+Requirement totalizer(const Ordinal& lhs, const Ordinal& rhs, const Ordinal& total);
+
+// The sum of any positive number of Ordinals, all on the same solver.
+Ordinal sum(const std::vector<Ordinal>& ordinals);
+
+// Any other container (or view) of Ordinals that supports range-for,
+// e.g., a row of a Matrix<Ordinal>.
+template<class Container>
+Ordinal sum(const Container& container) {
+  std::vector<Ordinal> ordinals;
+  for ( const Ordinal& ord : container ) {
+    ordinals.push_back(ord);
+  }
+  return sum(ordinals);
+}
+
+#endif // ORDINALSUM_H
@@ -40,36 +40,73 @@ template<class Scalar>
 class MatrixView;
 
 template<class Scalar>
+class CompactMatrix;
+
+template<class Scalar, class MatrixType>
 class PairIndexedScalar {
 public:
   typedef int size_type;
 
-  // Value requirements on PairIndexedScalars
+  // Value requirements on PairIndexedScalars.  Each emits the range
+  // requirements on row and col plus one clause (or clause set) per
+  // cell in range, guarded by the cell's row and column.
   Requirement operator ==(int rhs) const;
   Requirement operator !=(int rhs) const;
 
   Requirement operator <=(int rhs) const;
-  Requirement operator <(int rhs)  const;  // Not Yet Implemented
-  Requirement operator >=(int rhs) const;  // Not Yet Implemented
-  Requirement operator >(int rhs)  const;  // Not Yet Implemented
-
-  Requirement operator == (Scalar rhs) const; // Not Yet Implemented
-  Requirement operator != (Scalar rhs) const; // Not Yet Implemented
+  Requirement operator <(int rhs)  const;
+  Requirement operator >=(int rhs) const;
+  Requirement operator >(int rhs)  const;
+
+  // Comparisons against another Scalar go through element(); all but
+  // == do so on a fresh Scalar spanning the values of the cells in
+  // range.
+  Requirement operator == (const Scalar& rhs) const;
+  Requirement operator != (const Scalar& rhs) const;
+  Requirement operator <= (const Scalar& rhs) const;
+  Requirement operator <  (const Scalar& rhs) const;
+  Requirement operator >= (const Scalar& rhs) const;
+  Requirement operator >  (const Scalar& rhs) const;
+
+  // The element constraint: value equals matrix[row][col].  Encoded
+  // as a row selection into one auxiliary Scalar per column in range,
+  // rowValue[j] == matrix[row][j], followed by a column selection,
+  // value == rowValue[col].  Nothing is cached: every call (so every
+  // Scalar comparison) allocates its own auxiliaries and links every
+  // cell in range to them again, so compare once and reuse the result
+  // where possible.
+  Requirement element(const Scalar& value) const;
 
   friend class Matrix<Scalar>;
   friend class MatrixView<Scalar>;
+  friend class CompactMatrix<Scalar>;
 private:
-  PairIndexedScalar(const Matrix<Scalar>* matrix, Scalar row, Scalar col);
+  PairIndexedScalar(const MatrixType* matrix, Scalar row, Scalar col);
+
+  // The range requirements on row and col, and the ranges of cells
+  // they may select.
+  Requirement rangeRequirement() const;
+  size_type rowStart() const;
+  size_type rowEnd() const;
+  size_type colStart() const;
+  size_type colEnd() const;
 
-  const Matrix<Scalar>* matrix;
+  // Requires that (row, col) == (i, j) implies cellReq(cell at i, j).
+  template<class CellReq>
+  Requirement eachCell(CellReq cellReq) const;
+
+  // A fresh Scalar spanning the values of the cells in range.
+  Scalar freshValue() const;
+
+  const MatrixType* matrix;
   Scalar row;
   Scalar col;
 };
 
-template<class Scalar>
-PairIndexedScalar<Scalar>::PairIndexedScalar(const Matrix<Scalar>* matrix, 
-					     Scalar _row, 
-					     Scalar _col) :
+template<class Scalar, class MatrixType>
+PairIndexedScalar<Scalar, MatrixType>::PairIndexedScalar(const MatrixType* matrix, 
+							 Scalar _row, 
+							 Scalar _col) :
   matrix(matrix),
   row(_row),
   col(_col)
@@ -77,87 +114,165 @@ PairIndexedScalar<Scalar>::PairIndexedScalar(const Matrix<Scalar>* matrix,
   
 }
 
-template<class Scalar>
-Requirement PairIndexedScalar<Scalar>::operator <= (int rhs) const {
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::rangeRequirement() const {
   Requirement result;
+  result &= row >= 0 & row < (int)matrix->height();
+  result &= col >= 0 & col < (int)matrix->width();
+  return result;
+}
 
-  size_type height = matrix->height();
-  size_type width = matrix->width();
+template<class Scalar, class MatrixType>
+typename PairIndexedScalar<Scalar, MatrixType>::size_type 
+PairIndexedScalar<Scalar, MatrixType>::rowStart() const {
+  return std::max(row.min(), 0);
+}
 
-  // Range requirements
-  result &= row >= 0 & row < (int)height;
-  result &= col >= 0 & col < (int)width;
+template<class Scalar, class MatrixType>
+typename PairIndexedScalar<Scalar, MatrixType>::size_type 
+PairIndexedScalar<Scalar, MatrixType>::rowEnd() const {
+  return std::min(row.max(), (size_type)matrix->height());
+}
 
-  size_type rowStart = std::max(row.min(), 0);	
-  size_type rowEnd   = std::min(row.max(), height);
+template<class Scalar, class MatrixType>
+typename PairIndexedScalar<Scalar, MatrixType>::size_type 
+PairIndexedScalar<Scalar, MatrixType>::colStart() const {
+  return std::max(col.min(), 0);
+}
 
-  size_type colStart = std::max(col.min(), 0);	
-  size_type colEnd   = std::min(col.max(), width);
+template<class Scalar, class MatrixType>
+typename PairIndexedScalar<Scalar, MatrixType>::size_type 
+PairIndexedScalar<Scalar, MatrixType>::colEnd() const {
+  return std::min(col.max(), (size_type)matrix->width());
+}
 
-  for (size_type i = rowStart; i < rowEnd; i++ ) {
-    for (size_type j = colStart; j < colEnd; j++ ) {
-      Scalar element = (*matrix)[i][j];
+template<class Scalar, class MatrixType>
+template<class CellReq>
+Requirement PairIndexedScalar<Scalar, MatrixType>::eachCell(CellReq cellReq) const {
+  Requirement result = rangeRequirement();
+
+  for (size_type i = rowStart(); i < rowEnd(); i++ ) {
+    for (size_type j = colStart(); j < colEnd(); j++ ) {
       result &= implication(row == (int)i & col == (int)j,
-			    element <= rhs);
+			    cellReq((*matrix)[i][j]));
     }
   }
 
   return result;
 }
 
-template<class Scalar>
-Requirement PairIndexedScalar<Scalar>::operator == (int rhs) const {
-  Requirement result;
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator == (int rhs) const {
+  return eachCell([=] (const Scalar& element) { return element == rhs; });
+}
 
-  size_type height = matrix->height();
-  size_type width = matrix->width();
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator != (int rhs) const {
+  return eachCell([=] (const Scalar& element) { return element != rhs; });
+}
 
-  // Range requirements
-  result &= row >= 0 & row < (int)height;
-  result &= col >= 0 & col < (int)width;
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator <= (int rhs) const {
+  return eachCell([=] (const Scalar& element) { return element <= rhs; });
+}
 
-  size_type rowStart = std::max(row.min(), 0);	
-  size_type rowEnd   = std::min(row.max(), height);
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator < (int rhs) const {
+  return eachCell([=] (const Scalar& element) { return element < rhs; });
+}
+
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator >= (int rhs) const {
+  return eachCell([=] (const Scalar& element) { return element >= rhs; });
+}
 
-  size_type colStart = std::max(col.min(), 0);	
-  size_type colEnd   = std::min(col.max(), width);
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator > (int rhs) const {
+  return eachCell([=] (const Scalar& element) { return element > rhs; });
+}
 
-  for (size_type i = rowStart; i < rowEnd; i++ ) {
-    for (size_type j = colStart; j < colEnd; j++ ) {
+template<class Scalar, class MatrixType>
+Scalar PairIndexedScalar<Scalar, MatrixType>::freshValue() const {
+  Scalar first = (*matrix)[rowStart()][colStart()];
+  int lo = first.min();
+  int hi = first.max();
+  for (size_type i = rowStart(); i < rowEnd(); i++ ) {
+    for (size_type j = colStart(); j < colEnd(); j++ ) {
       Scalar element = (*matrix)[i][j];
-      result &= implication(row == (int)i & col == (int)j,
-			    element == rhs);
+      lo = std::min(lo, element.min());
+      hi = std::max(hi, element.max());
     }
   }
-
-  return result;
+  return Scalar(first.solver(), lo, hi);
 }
 
-template<class Scalar>
-Requirement PairIndexedScalar<Scalar>::operator != (int rhs) const {
-  Requirement result;
-
-  size_type height = matrix->height();
-  size_type width = matrix->width();
-
-  // Range requirements
-  result &= row >= 0 & row < (int)height;
-  result &= col >= 0 & col < (int)width;
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::element(const Scalar& value) const {
+  Requirement result = rangeRequirement();
 
-  size_type rowStart = row.min() <= 0      ? 0      : row.min();
-  size_type rowEnd   = row.max() >= height ? height : row.max();
+  for (size_type j = colStart(); j < colEnd(); j++ ) {
+    if ( rowStart() >= rowEnd() ) {
+      break;
+    }
 
-  size_type colStart = col.min() <= 0     ? 0     : col.min();
-  size_type colEnd   = col.max() >= width ? width : col.max();
+    // The value of column j in the selected row
+    Scalar first = (*matrix)[rowStart()][j];
+    int lo = first.min();
+    int hi = first.max();
+    for (size_type i = rowStart(); i < rowEnd(); i++ ) {
+      lo = std::min(lo, (*matrix)[i][j].min());
+      hi = std::max(hi, (*matrix)[i][j].max());
+    }
+    Scalar rowValue(first.solver(), lo, hi);
 
-  for (size_type i = rowStart; i < rowEnd; i++ ) {
-    for (size_type j = colStart; j < colEnd; j++ ) {
-      result &= implication(row == (int)i & col == (int)j,
-			    (*matrix)[i][j] != rhs);
+    for (size_type i = rowStart(); i < rowEnd(); i++ ) {
+      result &= implication(row == (int)i, (*matrix)[i][j] == rowValue);
     }
+    result &= implication(col == (int)j, rowValue == value);
   }
 
   return result;
 }
 
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator == (const Scalar& rhs) const {
+  // Equality needs no fresh value; rhs itself is the element.
+  return element(rhs);
+}
+
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator != (const Scalar& rhs) const {
+  if ( rowStart() >= rowEnd() || colStart() >= colEnd() ) return rangeRequirement();
+  Scalar value = freshValue();
+  return element(value) & (value != rhs);
+}
+
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator <= (const Scalar& rhs) const {
+  if ( rowStart() >= rowEnd() || colStart() >= colEnd() ) return rangeRequirement();
+  Scalar value = freshValue();
+  return element(value) & (value <= rhs);
+}
+
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator < (const Scalar& rhs) const {
+  if ( rowStart() >= rowEnd() || colStart() >= colEnd() ) return rangeRequirement();
+  Scalar value = freshValue();
+  return element(value) & (value < rhs);
+}
+
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator >= (const Scalar& rhs) const {
+  if ( rowStart() >= rowEnd() || colStart() >= colEnd() ) return rangeRequirement();
+  Scalar value = freshValue();
+  return element(value) & (value >= rhs);
+}
+
+template<class Scalar, class MatrixType>
+Requirement PairIndexedScalar<Scalar, MatrixType>::operator > (const Scalar& rhs) const {
+  if ( rowStart() >= rowEnd() || colStart() >= colEnd() ) return rangeRequirement();
+  Scalar value = freshValue();
+  return element(value) & (value > rhs);
+}
+
 #endif // PAIRINDEXEDSCALAR_H
@@ -0,0 +1,94 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of encodeRows() and requireRows()
+
+#include <algorithm>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include "parallelencoding.h"
+
+using namespace std;
+
+vector<ClauseBuffer> encodeRows(int height, 
+				row_generator_type generate, 
+				unsigned int numThreads) {
+  if ( numThreads == 0 ) {
+    numThreads = max(1u, thread::hardware_concurrency());
+  }
+  int numBands = max(1, min((int)numThreads, height));
+
+  vector<ClauseBuffer> buffers(numBands);
+  vector<exception_ptr> errors(numBands);
+
+  // Band b covers rows [b*height/numBands, (b+1)*height/numBands).
+  auto encodeBand = [&] (int band) {
+    try {
+      int endRow = (long long)(band+1)*height/numBands;
+      for ( int row = (long long)band*height/numBands; row < endRow; row++ ) {
+	buffers[band].add(generate(row));
+      }
+    } catch ( ... ) {
+      errors[band] = current_exception();
+    }
+  };
+
+  // The calling thread takes the first band itself, and any bands no
+  // thread could be started for.  Workers already running are still
+  // joined below, so a failed start never leaves a joinable thread
+  // behind.
+  vector<thread> workers;
+  workers.reserve(numBands-1);
+  int band = 1;
+  try {
+    for ( ; band < numBands; band++ ) {
+      workers.emplace_back(encodeBand, band);
+    }
+  } catch ( const system_error& ) {
+  }
+  encodeBand(0);
+  for ( ; band < numBands; band++ ) {
+    encodeBand(band);
+  }
+  for ( thread& worker : workers ) {
+    worker.join();
+  }
+
+  for ( const exception_ptr& error : errors ) {
+    if ( error ) {
+      rethrow_exception(error);
+    }
+  }
+  return buffers;
+}
+
+void requireRows(Solver* solver, 
+		 int height, 
+		 row_generator_type generate, 
+		 unsigned int numThreads) {
+  for ( const ClauseBuffer& buffer : encodeRows(height, generate, numThreads) ) {
+    solver->require(buffer);
+  }
+}
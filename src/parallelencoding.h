@@ -0,0 +1,65 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Parallel generation of row-by-row constraints.
+//
+// Large grids spend most of their setup time building clauses, one
+// row after another.  encodeRows() splits the rows into disjoint,
+// contiguous bands and generates each band's clauses on its own
+// worker thread, packing them into a thread-local ClauseBuffer.
+// requireRows() then hands the buffers to the solver in band order, so
+// the solver sees the same clauses in the same order whatever the
+// number of threads.
+//
+// The generator runs concurrently with itself, so it must only read
+// shared state: building clauses from existing Scalars is fine, but
+// allocating variables (constructing Scalars, auxiliary encodings)
+// or calling the solver is not.
+
+#ifndef PARALLELENCODING_H
+#define PARALLELENCODING_H
+
+#include <functional>
+#include <vector>
+#include "requirement.h"
+#include "clausebuffer.h"
+#include "solver.h"
+
+typedef std::function<Requirement(int row)> row_generator_type;
+
+// One buffer per band, in row order.  numThreads of 0 means one per
+// hardware thread; bands that no thread can be started for are
+// encoded on the calling thread.  An exception thrown by the generator is rethrown
+// here (the one from the earliest band, if several).
+std::vector<ClauseBuffer> encodeRows(int height, 
+				     row_generator_type generate, 
+				     unsigned int numThreads = 0);
+
+// Encode as above, then require the clauses in row order.
+void requireRows(Solver* solver, 
+		 int height, 
+		 row_generator_type generate, 
+		 unsigned int numThreads = 0);
+
+#endif // PARALLELENCODING_H
@@ -24,6 +24,7 @@
 //
 // Implementation of the Pattern class
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 #include <sstream>
@@ -148,3 +149,83 @@ Pattern::subscript_type Pattern::operator[] (int index) {
 Pattern::const_subscript_type Pattern::operator[] (int index) const {
   return pattern[index];
 }
+
+Pattern::Pattern(const Array2d<bool>& cells) :
+  height(cells.height()),
+  width(cells.width()),
+  centerRow(-1),
+  centerCol(-1),
+  isBlank(true),
+  pattern(cells)
+{
+  for ( int row = 0; row < height; row++ ) {
+    for ( int col = 0; col < width; col++ ) {
+      isBlank &= !pattern[row][col];
+    }
+  }
+}
+
+vector<pair<int, int> > Pattern::cells() const {
+  vector<pair<int, int> > result;
+  for ( int row = 0; row < height; row++ ) {
+    for ( int col = 0; col < width; col++ ) {
+      if ( pattern[row][col] ) {
+	result.push_back(make_pair(row, col));
+      }
+    }
+  }
+  return result;
+}
+
+vector<Pattern> Pattern::orientations() const {
+  const vector<pair<int, int> > filled = cells();
+  vector<vector<pair<int, int> > > seen;
+  vector<Pattern> result;
+
+  for ( int transform = 0; transform < 8; transform++ ) {
+    vector<pair<int, int> > image;
+    for ( auto cell : filled ) {
+      int row = (transform & 0x1) ? height-1 - cell.first  : cell.first;
+      int col = (transform & 0x2) ? width-1  - cell.second : cell.second;
+      image.push_back((transform & 0x4) ? make_pair(col, row) : make_pair(row, col));
+    }
+
+    // Trim to the bounding box, and sort so that images compare equal
+    int minRow = 0, minCol = 0, maxRow = -1, maxCol = -1;
+    if ( !image.empty() ) {
+      minRow = maxRow = image.front().first;
+      minCol = maxCol = image.front().second;
+    }
+    for ( auto cell : image ) {
+      minRow = min(minRow, cell.first);
+      maxRow = max(maxRow, cell.first);
+      minCol = min(minCol, cell.second);
+      maxCol = max(maxCol, cell.second);
+    }
+    for ( auto& cell : image ) {
+      cell.first -= minRow;
+      cell.second -= minCol;
+    }
+    sort(image.begin(), image.end());
+    if ( find(seen.begin(), seen.end(), image) != seen.end() ) {
+      continue;
+    }
+    seen.push_back(image);
+
+    Array2d<bool> grid(maxRow-minRow+1, maxCol-minCol+1);
+    for ( auto cell : image ) {
+      grid[cell.first][cell.second] = true;
+    }
+    result.push_back(Pattern(grid));
+  }
+
+  return result;
+}
+
+bool Pattern::operator==(const Pattern& rhs) const {
+  return height == rhs.height && width == rhs.width && cells() == rhs.cells();
+}
+
+bool Pattern::operator!=(const Pattern& rhs) const {
+  return !(*this == rhs);
+}
@@ -29,6 +29,8 @@
 #define PATTERN_H
 
 #include <iostream>
+#include <utility>
+#include <vector>
 #include "requirement.h"
 #include "solver.h"
 #include "array2d.h"
@@ -45,6 +47,8 @@ public:
   Pattern(const std::string& pattern);
   Pattern(std::istream&& in);
   Pattern(std::istream& in);
+  // The given cells, with no center
+  explicit Pattern(const Array2d<bool>& cells);
 
   int height;
   int width;
@@ -58,6 +62,20 @@ public:
 
   subscript_type operator[] (int index);
   const_subscript_type operator[] (int index) const;
+
+  // The filled cells as (row, col) pairs, in row-major order
+  std::vector<std::pair<int, int> > cells() const;
+
+  // The distinct images of the filled cells under the eight rotations
+  // and reflections, each trimmed to its bounding box.  Images are
+  // taken in the order of the transform bits (1: flip rows, 2: flip
+  // columns, 4: transpose), so the first is the pattern itself,
+  // trimmed to its filled cells.
+  std::vector<Pattern> orientations() const;
+
+  // Same size and same filled cells; centers are not compared
+  bool operator==(const Pattern& rhs) const;
+  bool operator!=(const Pattern& rhs) const;
 private:
   void computePattern(std::istream& in);
 };
@@ -0,0 +1,197 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of Placements.
+
+#include <sstream>
+#include <stdexcept>
+#include "placements.h"
+#include "pseudoboolean.h"
+
+using namespace std;
+
+Placements::Placements(Solver* solver, const Pattern& piece, int height, int width, 
+		       bool turnable, open_cell_type open) :
+  mSolver(solver),
+  mHeight(height),
+  mWidth(width),
+  mPlacements(enumerate(piece, height, width, turnable, open)),
+  mStartingVar(0),
+  mCovering(height*width)
+{
+  mOrientations = piece.orientations();
+  if ( !turnable ) {
+    mOrientations.erase(mOrientations.begin()+1, mOrientations.end());
+  }
+
+  for ( unsigned int index = 0; index < mPlacements.size(); index++ ) {
+    for ( auto cell : mPlacements[index].cells ) {
+      mCovering[cell.first*width + cell.second].push_back(index);
+    }
+  }
+
+  if ( !mPlacements.empty() ) {
+    mStartingVar = solver->newVars(mPlacements.size());
+  }
+}
+
+vector<Placements::Placement> Placements::enumerate(const Pattern& piece, int height, int width, 
+						    bool turnable, open_cell_type open) {
+  if ( height < 0 || width < 0 ) {
+    ostringstream sout;
+    sout << "Invalid grid size " << height << " x " << width << " for Placements";
+    throw invalid_argument(sout.str());
+  }
+  if ( piece.isBlank ) {
+    throw invalid_argument("Placements of a blank pattern");
+  }
+
+  vector<Pattern> orientations = piece.orientations();
+  if ( !turnable ) {
+    orientations.erase(orientations.begin()+1, orientations.end());
+  }
+
+  vector<Placement> result;
+  for ( unsigned int orientation = 0; orientation < orientations.size(); orientation++ ) {
+    const Pattern& shape = orientations[orientation];
+    const vector<pair<int, int> > shapeCells = shape.cells();
+
+    for ( int row = 0; row + shape.height <= height; row++ ) {
+      for ( int col = 0; col + shape.width <= width; col++ ) {
+	Placement placement{ (int)orientation, row, col, shapeCells };
+	bool fits = true;
+	for ( auto& cell : placement.cells ) {
+	  cell.first += row;
+	  cell.second += col;
+	  fits = fits && (!open || open(cell.first, cell.second));
+	}
+	if ( fits ) {
+	  result.push_back(move(placement));
+	}
+      }
+    }
+  }
+
+  return result;
+}
+
+int Placements::height() const {
+  return mHeight;
+}
+
+int Placements::width() const {
+  return mWidth;
+}
+
+int Placements::size() const {
+  return mPlacements.size();
+}
+
+const vector<Pattern>& Placements::orientations() const {
+  return mOrientations;
+}
+
+const Placements::Placement& Placements::placement(int index) const {
+  return mPlacements.at(index);
+}
+
+Literal Placements::selector(int index) const {
+  if ( index < 0 || index >= size() ) {
+    ostringstream sout;
+    sout << "Placement " << index << " out of range for " << size() << " placements";
+    throw out_of_range(sout.str());
+  }
+  return Literal(mStartingVar + index);
+}
+
+const vector<int>& Placements::covering(int row, int col) const {
+  checkCell(row, col);
+  return mCovering[row*mWidth + col];
+}
+
+Clause Placements::covers(int row, int col) const {
+  Clause result;
+  for ( int index : covering(row, col) ) {
+    result |= selector(index);
+  }
+  return result;
+}
+
+Requirement Placements::exactlyOne() const {
+  vector<Literal> selectors;
+  for ( int index = 0; index < size(); index++ ) {
+    selectors.push_back(selector(index));
+  }
+  return ::exactlyOne(mSolver, selectors);
+}
+
+Requirement Placements::cellCoverage(const vector<Placements>& pieces, open_cell_type open) {
+  Requirement result;
+  if ( pieces.empty() ) {
+    return result;
+  }
+
+  const int height = pieces.front().height();
+  const int width = pieces.front().width();
+  for ( const Placements& piece : pieces ) {
+    if ( piece.height() != height || piece.width() != width ) {
+      throw invalid_argument("Placements::cellCoverage requires all pieces to share a grid.");
+    }
+  }
+
+  for ( int row = 0; row < height; row++ ) {
+    for ( int col = 0; col < width; col++ ) {
+      if ( open && !open(row, col) ) {
+	continue;
+      }
+      vector<Literal> selectors;
+      for ( const Placements& piece : pieces ) {
+	for ( int index : piece.covering(row, col) ) {
+	  selectors.push_back(piece.selector(index));
+	}
+      }
+      result &= ::exactlyOne(pieces.front().mSolver, selectors);
+    }
+  }
+
+  return result;
+}
+
+int Placements::modelPlacement() const {
+  for ( int index = 0; index < size(); index++ ) {
+    if ( mSolver->modelValue(mStartingVar + index) ) {
+      return index;
+    }
+  }
+  return -1;
+}
+
+void Placements::checkCell(int row, int col) const {
+  if ( row < 0 || row >= mHeight || col < 0 || col >= mWidth ) {
+    ostringstream sout;
+    sout << "Cell (" << row << ", " << col << ") out of range for a " 
+	 << mHeight << " x " << mWidth << " grid";
+    throw out_of_range(sout.str());
+  }
+}
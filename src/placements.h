@@ -0,0 +1,140 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Placements of a piece (a Pattern) on a grid, one selector literal
+// each.
+//
+// Placing a piece through Cardinal row, column and transform indices
+// and implications over a view of the board enumerates every
+// combination of indices, including placements that run off the board
+// and transforms that give the same shape twice.  Placements instead
+// enumerates, once, the distinct orientations of the piece and the
+// positions where an orientation fits: inside the grid and, optionally,
+// on open cells only.  Each remaining placement gets a selector
+// literal, and the constraints are written over the selectors:
+//
+// * exactlyOne(): the piece is placed exactly once.
+// * cover(cell, value): a placement marks the cells it covers with
+//   value, and a cell marked value is covered by some placement.
+// * cellCoverage(pieces, ...): each open cell is covered by exactly one
+//   placement of all the pieces together.
+
+#ifndef PLACEMENTS_H
+#define PLACEMENTS_H
+
+#include <functional>
+#include <utility>
+#include <vector>
+#include "clause.h"
+#include "literal.h"
+#include "pattern.h"
+#include "requirement.h"
+#include "solver.h"
+
+class Placements {
+public:
+  typedef std::function<bool(int, int)> open_cell_type;
+
+  struct Placement {
+    int orientation;  // into piece.orientations()
+    int row;          // of the orientation's upper-left corner
+    int col;
+    std::vector<std::pair<int, int> > cells;
+  };
+
+  // Placements on a height x width grid.  If turnable is false, the
+  // piece keeps its given orientation.  With open, placements must lie
+  // on cells where open(row, col) is true.
+  Placements(Solver* solver, const Pattern& piece, int height, int width, 
+	     bool turnable = true, open_cell_type open = nullptr);
+
+  Placements() = delete;
+  Placements(const Placements& copy) = default;
+  Placements(Placements&& move) = default;
+  Placements& operator=(const Placements& copy) = default;
+  Placements& operator=(Placements&& move) = default;
+
+  // Just the placements, with no selectors (e.g., for ExactCover)
+  static std::vector<Placement> enumerate(const Pattern& piece, int height, int width, 
+					  bool turnable = true, open_cell_type open = nullptr);
+
+  int height() const;
+  int width() const;
+  int size() const;
+  const std::vector<Pattern>& orientations() const;
+  const Placement& placement(int index) const;
+  Literal selector(int index) const;
+
+  // Placements covering a cell, by index
+  const std::vector<int>& covering(int row, int col) const;
+  // Some placement covers the cell
+  Clause covers(int row, int col) const;
+
+  Requirement exactlyOne() const;
+
+  // cell is any callable returning, for (row, col), a scalar whose
+  // comparison with an int gives an Atom (e.g., Cardinal).
+  template<class CellAccess>
+  Requirement cover(CellAccess cell, int value) const;
+
+  // Each cell is covered by exactly one placement of the given pieces;
+  // cells not open for placement (as above) are left uncovered.
+  static Requirement cellCoverage(const std::vector<Placements>& pieces, 
+				  open_cell_type open = nullptr);
+
+  // The placement chosen in the model, after solving; -1 if none
+  int modelPlacement() const;
+
+private:
+  void checkCell(int row, int col) const;
+
+  Solver* mSolver;
+  int mHeight;
+  int mWidth;
+  std::vector<Pattern> mOrientations;
+  std::vector<Placement> mPlacements;
+  unsigned int mStartingVar;
+  // Indexed by row*width + col
+  std::vector<std::vector<int> > mCovering;
+};
+
+template<class CellAccess>
+Requirement Placements::cover(CellAccess cell, int value) const {
+  Requirement result;
+
+  for ( int index = 0; index < size(); index++ ) {
+    for ( auto square : mPlacements[index].cells ) {
+      result &= ~selector(index) | (cell(square.first, square.second) == value);
+    }
+  }
+  for ( int row = 0; row < mHeight; row++ ) {
+    for ( int col = 0; col < mWidth; col++ ) {
+      result &= ~(cell(row, col) == value) | covers(row, col);
+    }
+  }
+
+  return result;
+}
+
+#endif // PLACEMENTS_H
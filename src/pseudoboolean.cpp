@@ -0,0 +1,514 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of the PseudoBoolean class
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include "pseudoboolean.h"
+
+using namespace std;
+
+namespace {
+// Stand-ins for infinity when tracking BDD intervals.  Far away from
+// any sum of ints, but still safe to add an int to.
+const long long posInfinity =  (1LL << 60);
+const long long negInfinity = -(1LL << 60);
+
+int gcd(int a, int b) {
+  return b == 0 ? a : gcd(b, a % b);
+}
+
+// Below this many literals, pairwise exclusion is no bigger than the
+// sequential encoding and needs no auxiliary variables.
+const int pairwiseLimit = 4;
+} // namespace
+
+Requirement atMostOne(Solver* solver, const vector<Literal>& lits) {
+  Requirement result;
+
+  if ( lits.size() <= pairwiseLimit ) {
+    for ( int i = 0; i < lits.size(); i++ ) {
+      for ( int j = i+1; j < lits.size(); j++ ) {
+	result &= ~lits[i] | ~lits[j];
+      }
+    }
+    return result;
+  }
+
+  PseudoBoolean sum(solver, PseudoBoolean::sequentialCounter);
+  for ( auto lit : lits ) {
+    sum.add(1, lit);
+  }
+  return sum <= 1;
+}
+
+Requirement exactlyOne(Solver* solver, const vector<Literal>& lits) {
+  Clause atLeastOne;
+  for ( auto lit : lits ) {
+    atLeastOne |= lit;
+  }
+  Requirement result = atMostOne(solver, lits);
+  result &= move(atLeastOne);
+  return result;
+}
+
+PseudoBoolean::PseudoBoolean(Solver* _solver, Encoding _encoding) :
+  mSolver(_solver),
+  mEncoding(_encoding),
+  mConstant(0),
+  mTerms()
+{
+
+}
+
+PseudoBoolean& PseudoBoolean::add(int weight, Atom atom) {
+  if ( atom.isTruth() ) {
+    mConstant += weight;
+  } else if ( atom.isLiteral() ) {
+    mTerms.push_back(make_pair(weight, atom.getLiteral()));
+  }
+  // Falsity contributes nothing.
+  return *this;
+}
+
+PseudoBoolean& PseudoBoolean::add(int weight, Literal lit) {
+  return add(weight, Atom(lit));
+}
+
+PseudoBoolean& PseudoBoolean::add(const Cardinal& card, function<int(int)> cost) {
+  for ( int value = card.min(); value < card.max(); value++ ) {
+    add(cost(value), card == value);
+  }
+  return *this;
+}
+
+PseudoBoolean& PseudoBoolean::operator+=(int constant) {
+  mConstant += constant;
+  return *this;
+}
+
+int PseudoBoolean::constant() const {
+  return mConstant;
+}
+
+unsigned int PseudoBoolean::numTerms() const {
+  return mTerms.size();
+}
+
+// Rewrite the sum so that all weights are positive and at most one
+// more than the bound, then divide through by the gcd of the weights.
+// None of this changes which assignments satisfy the constraint.
+bool PseudoBoolean::normalize(int bound, term_list& terms, int& newBound) const {
+  long long K = (long long)bound - mConstant;
+  terms.clear();
+
+  // w*x = w - w*~x, so negative weights become positive weights on the
+  // negated literal.
+  for ( auto term : mTerms ) {
+    if ( term.first > 0 ) {
+      terms.push_back(term);
+    } else if ( term.first < 0 ) {
+      K -= term.first;
+      terms.push_back(make_pair(-term.first, ~term.second));
+    }
+  }
+
+  if ( K < 0 ) {
+    return false;
+  }
+
+  // Any weight exceeding the bound forces its literal false no matter
+  // how large it is.
+  int divisor = 0;
+  for ( auto& term : terms ) {
+    if ( term.first > K ) {
+      term.first = K+1;
+    }
+    divisor = gcd(term.first, divisor);
+  }
+
+  if ( divisor > 1 ) {
+    for ( auto& term : terms ) {
+      term.first /= divisor;
+    }
+    K /= divisor;
+  }
+
+  newBound = K;
+  return true;
+}
+
+PseudoBoolean::Encoding PseudoBoolean::chooseEncoding(int bound) const {
+  term_list terms;
+  int K;
+  if ( !normalize(bound, terms, K) ) {
+    return sequentialCounter;
+  }
+  return chooseEncoding(terms, K);
+}
+
+// Pick an encoding from the coefficient profile.  After normalization,
+// a cardinality constraint has all weights equal to one; the counter is
+// ideal there.  Otherwise a BDD has at most n*(K+1) nodes, and far
+// fewer when there are only a handful of distinct weights, so use it
+// unless the weights are large and varied enough that the BDD
+// threatens to blow up.
+PseudoBoolean::Encoding PseudoBoolean::chooseEncoding(const term_list& terms, int bound) {
+  const long long bddLimit = 1 << 18;
+
+  bool cardinality = true;
+  vector<int> weights;
+  for ( auto term : terms ) {
+    cardinality &= term.first == 1;
+    weights.push_back(term.first);
+  }
+
+  if ( cardinality ) {
+    return sequentialCounter;
+  }
+
+  sort(weights.begin(), weights.end());
+  int distinctWeights = unique(weights.begin(), weights.end()) - weights.begin();
+
+  if ( distinctWeights <= 3 || (long long)terms.size() * (bound+1) <= bddLimit ) {
+    return bdd;
+  }
+
+  return adderNetwork;
+}
+
+Requirement PseudoBoolean::atMost(int bound, Encoding encoding) const {
+  term_list terms;
+  int K;
+  if ( !normalize(bound, terms, K) ) {
+    return Clause(); // FALSE
+  }
+
+  // If all the terms together can't exceed the bound, there is nothing
+  // to require.
+  long long total = 0;
+  for ( auto term : terms ) {
+    total += term.first;
+  }
+  if ( total <= K ) {
+    return Requirement();
+  }
+
+  if ( encoding == automatic ) {
+    encoding = chooseEncoding(terms, K);
+  }
+
+  switch ( encoding ) {
+  case bdd:
+    return encodeBDD(terms, K);
+  case sequentialCounter:
+    return encodeCounter(terms, K);
+  case adderNetwork:
+    return encodeAdder(terms, K);
+  default:
+    throw logic_error("Unknown encoding requested of PseudoBoolean::atMost.");
+  }
+}
+
+Requirement PseudoBoolean::operator<=(int bound) const {
+  return atMost(bound, mEncoding);
+}
+
+Requirement PseudoBoolean::operator<(int bound) const {
+  return *this <= bound-1;
+}
+
+// sum >= bound exactly when the sum of the complementary terms is
+// small enough.
+Requirement PseudoBoolean::operator>=(int bound) const {
+  PseudoBoolean complement(mSolver, mEncoding);
+  int total = mConstant;
+  for ( auto term : mTerms ) {
+    complement.add(term.first, ~term.second);
+    total += term.first;
+  }
+  return complement <= total - bound;
+}
+
+Requirement PseudoBoolean::operator>(int bound) const {
+  return *this >= bound+1;
+}
+
+Requirement PseudoBoolean::operator==(int value) const {
+  return *this <= value & *this >= value;
+}
+
+Requirement operator<=(int bound, const PseudoBoolean& sum) {
+  return sum >= bound;
+}
+
+Requirement operator<(int bound, const PseudoBoolean& sum) {
+  return sum > bound;
+}
+
+Requirement operator>=(int bound, const PseudoBoolean& sum) {
+  return sum <= bound;
+}
+
+Requirement operator>(int bound, const PseudoBoolean& sum) {
+  return sum < bound;
+}
+
+Requirement operator==(int value, const PseudoBoolean& sum) {
+  return sum == value;
+}
+
+int PseudoBoolean::modelValue() const {
+  int result = mConstant;
+  for ( auto term : mTerms ) {
+    if ( mSolver->modelValue(term.second.getVar()) == term.second.isPos() ) {
+      result += term.first;
+    }
+  }
+  return result;
+}
+
+// BDD encoding, after Abio et al., "BDDs for Pseudo-Boolean Constraints
+// -- Revisited".  Each node means "the terms from this level down sum to
+// at most K", and for each level we remember the interval of K for
+// which a node is valid, so that every bound leading to the same
+// function shares one node.  Only the downward implications are
+// needed, so each node costs at most two clauses.
+Requirement PseudoBoolean::encodeBDD(const term_list& unsortedTerms, int bound) const {
+  // Largest weights first gives the smallest diagrams in practice.
+  term_list terms(unsortedTerms);
+  stable_sort(terms.begin(), terms.end(),
+	      [](const pair<int, Literal>& lhs, const pair<int, Literal>& rhs) {
+		return lhs.first > rhs.first;
+	      });
+
+  const int n = terms.size();
+  vector<long long> remaining(n+1, 0);
+  for ( int i = n-1; i >= 0; i-- ) {
+    remaining[i] = remaining[i+1] + terms[i].first;
+  }
+
+  // levels[i] maps the low end of an interval to (high end, node).
+  typedef map<long long, pair<long long, Atom>> interval_map;
+  vector<interval_map> levels(n+1);
+  Requirement result;
+
+  function<pair<pair<long long, long long>, Atom>(int, long long)> build;
+  build = [&](int i, long long K) -> pair<pair<long long, long long>, Atom> {
+    if ( K < 0 ) {
+      return make_pair(make_pair(negInfinity, -1LL), Atom::falsity);
+    }
+    if ( K >= remaining[i] ) {
+      return make_pair(make_pair(remaining[i], posInfinity), Atom::truth);
+    }
+
+    // Look for an existing node whose interval contains K
+    interval_map& level = levels[i];
+    auto iter = level.upper_bound(K);
+    if ( iter != level.begin() ) {
+      --iter;
+      if ( iter->first <= K && K <= iter->second.first ) {
+	return make_pair(make_pair(iter->first, iter->second.first), iter->second.second);
+      }
+    }
+
+    int weight = terms[i].first;
+    Literal lit = terms[i].second;
+    auto low  = build(i+1, K);
+    auto high = build(i+1, K - weight);
+
+    long long start = std::max(low.first.first,  high.first.first  + weight);
+    long long end   = std::min(low.first.second, high.first.second + weight);
+
+    Atom node = low.second;
+    if ( low.second != high.second ) {
+      Literal nodeLit(mSolver->newVars(1));
+      result &= ~nodeLit | low.second;
+      result &= ~nodeLit | ~lit | high.second;
+      node = Atom(nodeLit);
+    }
+
+    level[start] = make_pair(end, node);
+    return make_pair(make_pair(start, end), node);
+  };
+
+  Atom root = build(0, bound).second;
+  result &= root;
+  return result;
+}
+
+// Sequential weight counter, after Holldobler, Manthey and Steinke, "A
+// Compact Encoding of Pseudo-Boolean Constraints into SAT".  Register
+// s(i,j) means "the first i+1 terms sum to at least j", for 1 <= j <=
+// K; overflowing the last register is forbidden.
+Requirement PseudoBoolean::encodeCounter(const term_list& terms, int bound) const {
+  const int n = terms.size();
+  const int K = bound;
+  Requirement result;
+
+  // With no room at all, every literal must be false.
+  if ( K == 0 ) {
+    for ( auto term : terms ) {
+      result &= ~term.second;
+    }
+    return result;
+  }
+
+  unsigned int startingVar = mSolver->newVars((n-1)*K);
+  auto reg = [=](int i, int j) {
+    return Literal(startingVar + i*K + (j-1));
+  };
+
+  for ( int i = 0; i < n; i++ ) {
+    int weight = terms[i].first;
+    Literal lit = terms[i].second;
+
+    if ( i < n-1 ) {
+      for ( int j = 1; j <= weight && j <= K; j++ ) {
+	result &= implication(lit, reg(i, j));
+      }
+    }
+
+    if ( i > 0 && i < n-1 ) {
+      for ( int j = 1; j <= K; j++ ) {
+	result &= implication(reg(i-1, j), reg(i, j));
+      }
+      for ( int j = 1; j + weight <= K; j++ ) {
+	result &= ~lit | ~reg(i-1, j) | reg(i, j+weight);
+      }
+    }
+
+    if ( weight > K ) {
+      result &= ~lit;
+    } else if ( i > 0 ) {
+      result &= ~lit | ~reg(i-1, K+1-weight);
+    }
+  }
+
+  return result;
+}
+
+// Adder network, after Een and Sorensson, "Translating Pseudo-Boolean
+// Constraints into SAT".  Literals are placed in buckets by the bits of
+// their weights, and full and half adders reduce each bucket to a
+// single bit, carrying into the next bucket.  The bits of the sum are
+// then compared lexicographically against the bits of the bound.
+Requirement PseudoBoolean::encodeAdder(const term_list& terms, int bound) const {
+  Requirement result;
+  vector<vector<Literal>> buckets;
+
+  for ( auto term : terms ) {
+    for ( int bit = 0; (term.first >> bit) != 0; bit++ ) {
+      if ( (term.first >> bit) & 1 ) {
+	if ( buckets.size() <= bit ) {
+	  buckets.resize(bit+1);
+	}
+	buckets[bit].push_back(term.second);
+      }
+    }
+  }
+
+  vector<Atom> sumBits;
+  for ( int bit = 0; bit < buckets.size(); bit++ ) {
+    // Reduce the bucket, treating it as a queue so that new sum bits
+    // are added only after the original inputs.
+    for ( int next = 0; buckets[bit].size() - next >= 2; ) {
+      if ( buckets.size() <= bit+1 ) {
+	buckets.resize(bit+2);
+      }
+
+      Literal sum(mSolver->newVars(1));
+      Literal carry(mSolver->newVars(1));
+
+      if ( buckets[bit].size() - next >= 3 ) {
+	// Full adder
+	Literal a = buckets[bit][next++];
+	Literal b = buckets[bit][next++];
+	Literal c = buckets[bit][next++];
+
+	result &=  a |  b |  c | ~sum;
+	result &=  a |  b | ~c |  sum;
+	result &=  a | ~b |  c |  sum;
+	result &=  a | ~b | ~c | ~sum;
+	result &= ~a |  b |  c |  sum;
+	result &= ~a |  b | ~c | ~sum;
+	result &= ~a | ~b |  c | ~sum;
+	result &= ~a | ~b | ~c |  sum;
+
+	result &= ~a | ~b | carry;
+	result &= ~a | ~c | carry;
+	result &= ~b | ~c | carry;
+	result &=  a |  b | ~carry;
+	result &=  a |  c | ~carry;
+	result &=  b |  c | ~carry;
+      } else {
+	// Half adder
+	Literal a = buckets[bit][next++];
+	Literal b = buckets[bit][next++];
+
+	result &=  a |  b | ~sum;
+	result &=  a | ~b |  sum;
+	result &= ~a |  b |  sum;
+	result &= ~a | ~b | ~sum;
+
+	result &= ~a | ~b | carry;
+	result &=  a | ~carry;
+	result &=  b | ~carry;
+      }
+
+      buckets[bit].push_back(sum);
+      buckets[bit+1].push_back(carry);
+    }
+
+    if ( buckets[bit].empty() ) {
+      sumBits.push_back(Atom::falsity);
+    } else {
+      sumBits.push_back(Atom(buckets[bit].back()));
+    }
+  }
+
+  // sum > bound exactly when, for some bit i that is clear in the
+  // bound, bit i of the sum is set and the sum has every higher bit that
+  // the bound has.  Forbid each such case.
+  for ( int i = 0; i < sumBits.size(); i++ ) {
+    if ( (bound >> i) & 1 ) {
+      continue;
+    }
+
+    Clause clause = ~sumBits[i];
+    for ( int j = i+1; j < sumBits.size(); j++ ) {
+      if ( (bound >> j) & 1 ) {
+	clause |= ~sumBits[j];
+      }
+    }
+    result &= move(clause);
+  }
+
+  // Bits of the bound beyond the width of the sum make it trivially
+  // satisfied, but normalization guarantees the sum can exceed the
+  // bound, so the bound has no such bits.
+  return result;
+}
@@ -0,0 +1,158 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Pseudo-Boolean linear constraints, i.e., requirements of the form
+//
+//   w_1*x_1 + w_2*x_2 + ... + w_n*x_n <= K
+//
+// where the x_i are atoms and the w_i are integer weights.  Writing
+// these by hand with Requirement operators blows up combinatorially,
+// so the comparison operators here introduce auxiliary variables
+// (through the solver) and encode the constraint with one of three
+// encodings:
+//
+// * bdd: a reduced, ordered BDD with node sharing.  Nodes are shared
+//   across all bounds that lead to the same function, so this tends to
+//   be small when there are few distinct weights.
+// * sequentialCounter: a sequential weight counter.  O(n*K) clauses;
+//   the best choice for cardinality constraints and small bounds.
+// * adderNetwork: a network of full adders computing the sum in
+//   binary, followed by a comparator.  O(n log(max weight)) clauses,
+//   but propagates poorly.  Reserved for large weights.
+//
+// With the default "automatic" encoding, one is picked from the
+// profile of the coefficients whenever a comparison is made.
+//
+// Since the auxiliary variables are only defined by the clauses in the
+// returned requirement, the requirement may be used as part of an
+// implication like any other.
+
+#ifndef PSEUDOBOOLEAN_H
+#define PSEUDOBOOLEAN_H
+
+#include <iostream>
+#include <vector>
+#include <utility>
+#include <functional>
+#include "requirement.h"
+#include "solver.h"
+#include "cardinal.h"
+
+class PseudoBoolean {
+public:
+  enum Encoding {
+    automatic,
+    bdd,
+    sequentialCounter,
+    adderNetwork,
+  };
+
+  PseudoBoolean(Solver* solver, Encoding encoding = automatic);
+
+  PseudoBoolean() = delete;
+  PseudoBoolean(const PseudoBoolean& copy) = default;
+  PseudoBoolean(PseudoBoolean&& move) = default;
+  PseudoBoolean& operator=(const PseudoBoolean& copy) = default;
+  PseudoBoolean& operator=(PseudoBoolean&& move) = default;
+
+  // Add a term weight*atom to the sum.  Weights may be negative or
+  // zero; truth and falsity are folded into a constant.
+  PseudoBoolean& add(int weight, Atom atom);
+  PseudoBoolean& add(int weight, Literal lit);
+
+  // Add cost(value) for whichever value the cardinal takes.
+  PseudoBoolean& add(const Cardinal& card, std::function<int(int)> cost);
+
+  // Add cost(value) for every cell of a matrix (or view, or grid) of
+  // Cardinals.
+  template<class MatrixType>
+  PseudoBoolean& addCosts(const MatrixType& matrix, std::function<int(int)> cost);
+
+  // Adding a constant shifts the sum.
+  PseudoBoolean& operator+=(int constant);
+
+  // Requirements bounding the sum.  Each call allocates fresh
+  // auxiliary variables.
+  Requirement operator<=(int bound) const;
+  Requirement operator< (int bound) const;
+  Requirement operator>=(int bound) const;
+  Requirement operator> (int bound) const;
+  Requirement operator==(int value) const;
+
+  // Force a particular encoding for a bound, regardless of the
+  // encoding passed to the constructor.
+  Requirement atMost(int bound, Encoding encoding) const;
+
+  // The encoding that would be used by "automatic" for a given bound.
+  Encoding chooseEncoding(int bound) const;
+
+  // The value of the sum in the model, after solving.
+  int modelValue() const;
+
+  // Access basic information
+  int constant() const;
+  unsigned int numTerms() const;
+
+private:
+  typedef std::vector<std::pair<int, Literal>> term_list;
+
+  Solver* mSolver;
+  Encoding mEncoding;
+  int mConstant;
+  term_list mTerms;
+
+  // Rewrites the terms so that all weights are positive, adjusting the
+  // bound accordingly.  Returns false if the bound is unsatisfiable
+  // outright.
+  bool normalize(int bound, term_list& terms, int& newBound) const;
+  static Encoding chooseEncoding(const term_list& terms, int bound);
+
+  Requirement encodeBDD(const term_list& terms, int bound) const;
+  Requirement encodeCounter(const term_list& terms, int bound) const;
+  Requirement encodeAdder(const term_list& terms, int bound) const;
+};
+
+// Comparisons with the constant on the left
+Requirement operator<=(int bound, const PseudoBoolean& sum);
+Requirement operator< (int bound, const PseudoBoolean& sum);
+Requirement operator>=(int bound, const PseudoBoolean& sum);
+Requirement operator> (int bound, const PseudoBoolean& sum);
+Requirement operator==(int value, const PseudoBoolean& sum);
+
+// At most one (exactly one) of the literals is true: pairwise for a
+// few literals, by a sequential counter otherwise
+Requirement atMostOne(Solver* solver, const std::vector<Literal>& lits);
+Requirement exactlyOne(Solver* solver, const std::vector<Literal>& lits);
+
+template<class MatrixType>
+PseudoBoolean& PseudoBoolean::addCosts(const MatrixType& matrix, std::function<int(int)> cost) {
+  for ( int row = 0; row < matrix.height(); row++ ) {
+    for ( int col = 0; col < matrix.width(); col++ ) {
+      add(matrix[row][col], cost);
+    }
+  }
+  return *this;
+}
+
+#endif // PSEUDOBOOLEAN_H
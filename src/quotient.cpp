@@ -0,0 +1,131 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of NeighborhoodQuotient.
+
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+#include "quotient.h"
+
+using namespace std;
+
+namespace {
+// FNV-1a over the words of a row
+uint64_t hashRow(const Adjacency::word_type* words, int count) {
+  uint64_t result = 14695981039346656037ull;
+  for ( int index = 0; index < count; index++ ) {
+    result ^= words[index];
+    result *= 1099511628211ull;
+  }
+  return result;
+}
+
+bool sameRow(const Adjacency& graph, int lhs, int rhs) {
+  return memcmp(graph.row(lhs), graph.row(rhs), 
+		graph.wordsPerRow() * sizeof(Adjacency::word_type)) == 0;
+}
+}
+
+NeighborhoodQuotient::NeighborhoodQuotient(const Adjacency& graph) :
+  mClassOf(graph.order())
+{
+  const Adjacency reversed = graph.transpose();
+
+  // Representatives by the hash of their row and column
+  unordered_map<uint64_t, vector<int> > buckets;
+  for ( int vertex = 0; vertex < graph.order(); vertex++ ) {
+    uint64_t key = hashRow(graph.row(vertex), graph.wordsPerRow()) * 31 + 
+      hashRow(reversed.row(vertex), reversed.wordsPerRow());
+    vector<int>& bucket = buckets[key];
+
+    int index = -1;
+    for ( int candidate : bucket ) {
+      if ( sameRow(graph, vertex, mRepresentatives[candidate]) && 
+	   sameRow(reversed, vertex, mRepresentatives[candidate]) ) {
+	index = candidate;
+	break;
+      }
+    }
+    if ( index < 0 ) {
+      index = mRepresentatives.size();
+      mRepresentatives.push_back(vertex);
+      mMembers.push_back(vector<int>());
+      bucket.push_back(index);
+    }
+    mClassOf[vertex] = index;
+    mMembers[index].push_back(vertex);
+  }
+
+  vector<vector<bool> > induced(order(), vector<bool>(order()));
+  for ( int src = 0; src < order(); src++ ) {
+    for ( int dst = 0; dst < order(); dst++ ) {
+      induced[src][dst] = graph.adjacent(mRepresentatives[src], mRepresentatives[dst]);
+    }
+  }
+  mQuotient = Adjacency(induced);
+}
+
+int NeighborhoodQuotient::order() const {
+  return mRepresentatives.size();
+}
+
+const Adjacency& NeighborhoodQuotient::quotient() const {
+  return mQuotient;
+}
+
+int NeighborhoodQuotient::lift(int index) const {
+  if ( index < 0 || index >= order() ) {
+    ostringstream sout;
+    sout << "Class " << index << " out of range for a quotient of order " << order();
+    throw out_of_range(sout.str());
+  }
+  return mRepresentatives[index];
+}
+
+vector<int> NeighborhoodQuotient::lift(const vector<int>& indices) const {
+  vector<int> result;
+  result.reserve(indices.size());
+  for ( int index : indices ) {
+    result.push_back(lift(index));
+  }
+  return result;
+}
+
+int NeighborhoodQuotient::classOf(int vertex) const {
+  return mClassOf.at(vertex);
+}
+
+int NeighborhoodQuotient::representative(int vertex) const {
+  return mRepresentatives[classOf(vertex)];
+}
+
+const vector<int>& NeighborhoodQuotient::representatives() const {
+  return mRepresentatives;
+}
+
+const vector<int>& NeighborhoodQuotient::members(int index) const {
+  return mMembers.at(index);
+}
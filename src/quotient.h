@@ -0,0 +1,78 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Quotients of target graphs by neighborhood equivalence.
+//
+// Two vertices with the same neighbors (the same row and column of the
+// adjacency matrix) are interchangeable as images of a homomorphism:
+// folding one onto the other maps edges to edges.  So a homomorphism
+// into the graph exists if and only if one exists into the subgraph
+// induced on one representative of each class, and a solution there
+// is already a solution in the whole graph.
+//
+// NeighborhoodQuotient finds the classes by hashing the packed rows
+// and columns, then comparing rows only on collisions.  Each class is
+// represented by its smallest vertex, and the quotient numbers the
+// representatives in increasing order, so lift() is monotone.
+//
+// Cells whose domain is just the representatives (e.g., SparseCardinals
+// over representatives()) need fewer values, which shrinks both the
+// at-most-one and the support encodings.
+
+#ifndef QUOTIENT_H
+#define QUOTIENT_H
+
+#include <vector>
+#include "adjacency.h"
+
+class NeighborhoodQuotient {
+public:
+  explicit NeighborhoodQuotient(const Adjacency& graph);
+
+  // Number of classes, and the induced subgraph on the representatives
+  int order() const;
+  const Adjacency& quotient() const;
+
+  // The original vertex of quotient vertex index, and the quotient
+  // vertex of each original vertex
+  int lift(int index) const;
+  std::vector<int> lift(const std::vector<int>& indices) const;
+  int classOf(int vertex) const;
+
+  // The smallest vertex equivalent to vertex, and all representatives
+  // in increasing order
+  int representative(int vertex) const;
+  const std::vector<int>& representatives() const;
+
+  // The original vertices in each class, in increasing order
+  const std::vector<int>& members(int index) const;
+
+private:
+  std::vector<int> mClassOf;
+  std::vector<int> mRepresentatives;
+  std::vector<std::vector<int> > mMembers;
+  Adjacency mQuotient;
+};
+
+#endif // QUOTIENT_H
@@ -95,7 +95,7 @@ Requirement& Requirement::operator&=(DualClause rhs) {
 
 Requirement& Requirement::operator&=(Clause rhs) {
   // Treat "truth" is the identity for conjunction
-  if ( rhs == Clause::truth ) {
+  if ( rhs.isTruth() ) {
     return *this;
   }
 
@@ -230,7 +230,7 @@ Requirement& Requirement::operator|=(DualClause rhs) {
 
 Requirement& Requirement::operator|=(Clause rhs) {
   // If disjoining truth, just clear the requirement, making the requirement "always-true".
-  if ( rhs == Clause::truth ) {
+  if ( rhs.isTruth() ) {
     clear();
     return *this;
   }
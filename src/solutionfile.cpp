@@ -0,0 +1,318 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of SolutionWriter and SolutionReader.
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include "solutionfile.h"
+
+using namespace std;
+
+namespace {
+struct Header {
+  char magic[4];
+  uint32_t version;
+  uint32_t height;
+  uint32_t width;
+  uint32_t bitsPerCell;
+  uint32_t wordsPerRecord;
+};
+static_assert(sizeof(Header) == 24, "unexpected .sltb header padding");
+
+struct Footer {
+  uint64_t numRecords;
+  char magic[4];
+  uint32_t reserved;
+};
+static_assert(sizeof(Footer) == 16, "unexpected .sltb footer padding");
+
+const char headerMagic[4] = { 'S', 'L', 'T', 'B' };
+const char footerMagic[4] = { 'S', 'L', 'T', 'E' };
+const uint32_t version = 1;
+const int bitsPerWord = 64;
+
+int bitsFor(int maxValue) {
+  int result = 1;
+  while ( result < 31 && (maxValue >> result) != 0 ) {
+    result++;
+  }
+  return result;
+}
+
+int wordsFor(int cells, int bitsPerCell) {
+  return ((uint64_t)cells*bitsPerCell + bitsPerWord - 1) / bitsPerWord;
+}
+
+// The value of bits bits starting at bit of words
+int unpack(const SolutionWriter::word_type* words, uint64_t bit, int bits) {
+  SolutionWriter::word_type packed = words[bit / bitsPerWord] >> (bit % bitsPerWord);
+  // The high bits of a value that straddles two words
+  if ( bit % bitsPerWord + bits > bitsPerWord ) {
+    packed |= words[bit / bitsPerWord + 1] << (bitsPerWord - bit % bitsPerWord);
+  }
+  return packed & ((SolutionWriter::word_type(1) << bits) - 1);
+}
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+//  SolutionWriter
+//
+SolutionWriter::SolutionWriter(const string& path, int height, int width, int maxValue) :
+  mHeight(height),
+  mWidth(width),
+  mMaxValue(maxValue),
+  mBitsPerCell(bitsFor(maxValue)),
+  mNumSolutions(0),
+  mClosed(false)
+{
+  if ( height <= 0 || width <= 0 || maxValue < 0 ) {
+    ostringstream sout;
+    sout << "Invalid solution dimensions " << height << " x " << width 
+	 << " or maximum value " << maxValue;
+    throw invalid_argument(sout.str());
+  }
+  mRecord.resize(wordsFor(height*width, mBitsPerCell));
+  mOut.open(path, ios::binary);
+  if ( !mOut ) {
+    throw runtime_error("Cannot create " + path);
+  }
+
+  Header header;
+  memcpy(header.magic, headerMagic, sizeof(headerMagic));
+  header.version = version;
+  header.height = height;
+  header.width = width;
+  header.bitsPerCell = mBitsPerCell;
+  header.wordsPerRecord = mRecord.size();
+  mOut.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  mOut.flush();
+}
+
+SolutionWriter::~SolutionWriter() {
+  // Destructors must not throw.
+  try {
+    close();
+  } catch ( ... ) {
+  }
+}
+
+void SolutionWriter::write(const vector<int>& values) {
+  if ( mClosed ) {
+    throw logic_error("SolutionWriter: write after close");
+  }
+  if ( (int)values.size() != mHeight*mWidth ) {
+    throw invalid_argument("SolutionWriter: wrong number of cell values");
+  }
+
+  fill(mRecord.begin(), mRecord.end(), 0);
+  uint64_t bit = 0;
+  for ( int value : values ) {
+    if ( value < 0 || value > mMaxValue ) {
+      ostringstream sout;
+      sout << "Cell value " << value << " outside [0, " << mMaxValue << "]";
+      throw out_of_range(sout.str());
+    }
+    word_type packed = value;
+    mRecord[bit / bitsPerWord] |= packed << (bit % bitsPerWord);
+    // The high bits of a value that straddles two words
+    if ( bit % bitsPerWord + mBitsPerCell > bitsPerWord ) {
+      mRecord[bit / bitsPerWord + 1] |= packed >> (bitsPerWord - bit % bitsPerWord);
+    }
+    bit += mBitsPerCell;
+  }
+
+  mOut.write(reinterpret_cast<const char*>(mRecord.data()), mRecord.size()*sizeof(word_type));
+  mOut.flush();
+  if ( !mOut ) {
+    throw runtime_error("Error writing solution");
+  }
+  mNumSolutions++;
+}
+
+void SolutionWriter::close() {
+  if ( mClosed ) {
+    return;
+  }
+  mClosed = true;
+
+  Footer footer;
+  footer.numRecords = mNumSolutions;
+  memcpy(footer.magic, footerMagic, sizeof(footerMagic));
+  footer.reserved = 0;
+  mOut.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+  mOut.close();
+  if ( !mOut ) {
+    throw runtime_error("Error closing solution file");
+  }
+}
+
+int SolutionWriter::height() const {
+  return mHeight;
+}
+
+int SolutionWriter::width() const {
+  return mWidth;
+}
+
+unsigned int SolutionWriter::numSolutions() const {
+  return mNumSolutions;
+}
+
+/////////////////////////////////////////////////////////////////////
+//
+//  SolutionReader
+//
+SolutionReader::SolutionReader(const string& path) {
+  ifstream in(path, ios::binary);
+  if ( !in ) {
+    throw runtime_error("Cannot open " + path);
+  }
+  read(in, path);
+}
+
+SolutionReader::SolutionReader(istream& in) {
+  read(in, "solution stream");
+}
+
+void SolutionReader::read(istream& in, const string& name) {
+  Header header;
+  if ( !in.read(reinterpret_cast<char*>(&header), sizeof(header)) || 
+       memcmp(header.magic, headerMagic, sizeof(headerMagic)) != 0 ) {
+    throw runtime_error(name + ": not a .sltb file");
+  }
+  if ( header.version != version ) {
+    throw runtime_error(name + ": unsupported .sltb version");
+  }
+  if ( header.height == 0 || header.width == 0 || header.height > INT32_MAX / header.width || 
+       header.bitsPerCell == 0 || header.bitsPerCell > 31 || 
+       (int)header.wordsPerRecord != wordsFor(header.height*header.width, header.bitsPerCell) ) {
+    throw runtime_error(name + ": inconsistent .sltb header");
+  }
+  mHeight = header.height;
+  mWidth = header.width;
+  mBitsPerCell = header.bitsPerCell;
+  mWordsPerRecord = header.wordsPerRecord;
+
+  // The rest of the file, read straight into the words: records, then
+  // (if complete) the footer.  A seekable stream is read in one go,
+  // with its size known up front; anything else grows the words by
+  // chunks.
+  typedef SolutionWriter::word_type word_type;
+  mWords.clear();
+  size_t bytes = 0;
+  const streampos start = in.tellg();
+  if ( start != streampos(-1) && in.seekg(0, ios::end) ) {
+    const size_t remaining = in.tellg() - start;
+    in.seekg(start);
+    mWords.resize((remaining + sizeof(word_type)-1) / sizeof(word_type));
+    in.read(reinterpret_cast<char*>(mWords.data()), remaining);
+    bytes = in.gcount();
+  } else {
+    in.clear();
+    const size_t chunkWords = (1 << 16) / sizeof(word_type);
+    while ( in ) {
+      mWords.resize(bytes/sizeof(word_type) + chunkWords);
+      in.read(reinterpret_cast<char*>(mWords.data()) + bytes, chunkWords*sizeof(word_type));
+      bytes += in.gcount();
+    }
+  }
+  const char* data = reinterpret_cast<const char*>(mWords.data());
+
+  const size_t recordBytes = mWordsPerRecord*sizeof(word_type);
+  mComplete = false;
+  size_t dataBytes = bytes;
+  if ( bytes >= sizeof(Footer) ) {
+    Footer footer;
+    memcpy(&footer, data + bytes - sizeof(Footer), sizeof(Footer));
+    if ( memcmp(footer.magic, footerMagic, sizeof(footerMagic)) == 0 && 
+	 footer.numRecords*recordBytes == bytes - sizeof(Footer) ) {
+      mComplete = true;
+      dataBytes -= sizeof(Footer);
+    }
+  }
+
+  mSize = dataBytes / recordBytes;
+  mWords.resize(mSize*mWordsPerRecord);
+}
+
+int SolutionReader::height() const {
+  return mHeight;
+}
+
+int SolutionReader::width() const {
+  return mWidth;
+}
+
+unsigned int SolutionReader::size() const {
+  return mSize;
+}
+
+bool SolutionReader::complete() const {
+  return mComplete;
+}
+
+const SolutionWriter::word_type* SolutionReader::record(unsigned int index) const {
+  if ( index >= mSize ) {
+    ostringstream sout;
+    sout << "Solution " << index << " out of range for a file of " << mSize << " solutions";
+    throw out_of_range(sout.str());
+  }
+  return mWords.data() + (size_t)index*mWordsPerRecord;
+}
+
+vector<int> SolutionReader::solution(unsigned int index) const {
+  const SolutionWriter::word_type* words = record(index);
+  vector<int> result(mHeight*mWidth);
+  uint64_t bit = 0;
+  for ( int& value : result ) {
+    value = unpack(words, bit, mBitsPerCell);
+    bit += mBitsPerCell;
+  }
+  return result;
+}
+
+int SolutionReader::at(unsigned int index, int row, int col) const {
+  if ( row < 0 || row >= mHeight || col < 0 || col >= mWidth ) {
+    ostringstream sout;
+    sout << "Cell (" << row << ", " << col << ") out of range for " << mHeight << " x " << mWidth << " solutions";
+    throw out_of_range(sout.str());
+  }
+  return unpack(record(index), ((uint64_t)row*mWidth + col)*mBitsPerCell, mBitsPerCell);
+}
+
+void SolutionReader::writeText(ostream& out, unsigned int index) const {
+  vector<int> values = solution(index);
+  out << mHeight << " " << mWidth << endl;
+  for ( int row = 0; row < mHeight; row++ ) {
+    out << "    ";
+    for ( int col = 0; col < mWidth; col++ ) {
+      out << values[row*mWidth + col] << " ";
+    }
+    out << endl;
+  }
+  out << endl << endl;
+}
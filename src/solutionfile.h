@@ -0,0 +1,148 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Binary solution files (.sltb).
+//
+// Scenarios that enumerate solutions write each one as a fixed-width
+// record of packed cell values, instead of formatting every Scalar
+// through iostreams.  The layout, all in native byte order, is
+//
+//  * a 24-byte header: the magic "SLTB", then uint32 version (1),
+//    height, width, bits per cell and 64-bit words per record;
+//  * the records: the cells of a solution in row-major order, each in
+//    bits-per-cell bits, packed from the low bits of each word up;
+//  * a 16-byte footer, written on close: uint64 number of records, the
+//    magic "SLTE" and a zero uint32.
+//
+// Records have a fixed size, so record k's offset follows from k and
+// the footer only needs the count.  A file whose writer was killed
+// before closing has no footer; SolutionReader still reads every
+// complete record in it, and reports it as incomplete.
+//
+// tools/sltb2sltn converts a .sltb file back to the text format that
+// python/visualize.py reads.
+
+#ifndef SOLUTIONFILE_H
+#define SOLUTIONFILE_H
+
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+class SolutionWriter {
+public:
+  typedef std::uint64_t word_type;
+
+  // Cell values must lie in [0, maxValue].  Throws std::runtime_error
+  // if the file cannot be created.
+  SolutionWriter(const std::string& path, int height, int width, int maxValue);
+  // Closes the file
+  ~SolutionWriter();
+
+  // Appends a solution and flushes it, so that a reader (or a run
+  // killed later) sees every solution written so far.  values are in
+  // row-major order; cell(row, col) returns the value of a cell; and
+  // grid supports height(), width() and double indexing of Scalars
+  // with modelValue().
+  void write(const std::vector<int>& values);
+  template<class CellAccess>
+  void writeCells(CellAccess cell);
+  template<class GridType>
+  void write(const GridType& grid);
+
+  // Writes the footer.  Nothing can be written afterwards.
+  void close();
+
+  int height() const;
+  int width() const;
+  unsigned int numSolutions() const;
+
+private:
+  std::ofstream mOut;
+  int mHeight;
+  int mWidth;
+  int mMaxValue;
+  int mBitsPerCell;
+  std::vector<word_type> mRecord;
+  std::uint64_t mNumSolutions;
+  bool mClosed;
+};
+
+class SolutionReader {
+public:
+  // Reads the whole file.  Throws std::runtime_error if it is not a
+  // .sltb file.
+  explicit SolutionReader(const std::string& path);
+  explicit SolutionReader(std::istream& in);
+
+  int height() const;
+  int width() const;
+  unsigned int size() const;
+  // Whether the file was closed properly
+  bool complete() const;
+
+  // Solution index in row-major order, and one of its cells
+  std::vector<int> solution(unsigned int index) const;
+  int at(unsigned int index, int row, int col) const;
+
+  // Solution index in the text format ("height width", then the rows)
+  void writeText(std::ostream& out, unsigned int index) const;
+
+private:
+  void read(std::istream& in, const std::string& name);
+  const SolutionWriter::word_type* record(unsigned int index) const;
+
+  int mHeight;
+  int mWidth;
+  int mBitsPerCell;
+  int mWordsPerRecord;
+  unsigned int mSize;
+  bool mComplete;
+  std::vector<SolutionWriter::word_type> mWords;
+};
+
+template<class CellAccess>
+void SolutionWriter::writeCells(CellAccess cell) {
+  std::vector<int> values;
+  values.reserve(mHeight*mWidth);
+  for ( int row = 0; row < mHeight; row++ ) {
+    for ( int col = 0; col < mWidth; col++ ) {
+      values.push_back(cell(row, col));
+    }
+  }
+  write(values);
+}
+
+template<class GridType>
+void SolutionWriter::write(const GridType& grid) {
+  if ( (int)grid.height() != mHeight || (int)grid.width() != mWidth ) {
+    throw std::invalid_argument("SolutionWriter: grid dimensions differ from the file's");
+  }
+  writeCells([&] (int row, int col) { return (int)grid[row][col].modelValue(); });
+}
+
+#endif // SOLUTIONFILE_H
@@ -48,6 +48,69 @@ void Solver::require(Atom atm) {
   require(Clause(atm));
 }
 
+void Solver::require(const ClauseBuffer& buffer) {
+  buffer.forEachClause([this] (const int* lits, int size) {
+      Clause clause;
+      for ( int i = 0; i < size; i++ ) {
+	clause |= ClauseBuffer::unpack(lits[i]);
+      }
+      require(clause);
+    });
+}
+
+void Solver::setFolding(bool enable) {
+  mFolding = enable;
+}
+
+bool Solver::folding() const {
+  return mFolding;
+}
+
+bool Solver::isFixed(unsigned int var) const {
+  return var < mFixed.size() && mFixed[var] != 0;
+}
+
+bool Solver::fixedValue(unsigned int var) const {
+  return var < mFixed.size() && mFixed[var] > 0;
+}
+
+unsigned int Solver::numDroppedClauses() const {
+  return mNumDroppedClauses;
+}
+
+unsigned int Solver::numStrippedLiterals() const {
+  return mNumStrippedLiterals;
+}
+
+bool Solver::fold(std::vector<Literal>& lits) {
+  if ( !mFolding ) {
+    return true;
+  }
+
+  // Keep the free literals; any true literal satisfies the clause.
+  auto kept = lits.begin();
+  for ( Literal lit : lits ) {
+    if ( !isFixed(lit.getVar()) ) {
+      *kept++ = lit;
+    } else if ( fixedValue(lit.getVar()) == lit.isPos() ) {
+      mNumDroppedClauses++;
+      return false;
+    } else {
+      mNumStrippedLiterals++;
+    }
+  }
+  lits.erase(kept, lits.end());
+
+  if ( lits.size() == 1 ) {
+    unsigned int var = lits[0].getVar();
+    if ( mFixed.size() <= var ) {
+      mFixed.resize(var+1, 0);
+    }
+    mFixed[var] = lits[0].isPos() ? 1 : -1;
+  }
+  return true;
+}
+
 // Solve
 bool Solver::solve() {
   solve(DualClause());
@@ -27,12 +27,20 @@
 //
 // Provides sensible default implementations of several methods, which
 // call the pure virtual methods.
+//
+// Also keeps the partial assignment made by unit requirements (givens,
+// constant graph entries and the like) so that backends can simplify
+// every later clause before storing it: clauses with a true literal
+// are dropped and false literals are stripped.  Backends opt in by
+// passing their clauses through fold().
 
 #ifndef SOLVER_H
 #define SOLVER_H
 
 #include <iostream>
+#include <vector>
 #include "requirement.h"
+#include "clausebuffer.h"
 #include <minisat/core/Solver.h>
 
 class Solver {
@@ -50,6 +58,7 @@ public:
   virtual void require(Literal lit);
   virtual void require(Atom atm);
   virtual void require(const Clause& clause) = 0;
+  virtual void require(const ClauseBuffer& buffer);
 
   // Solve
   virtual bool solve();
@@ -63,6 +72,32 @@ public:
 
   // Query the value of a particular variable.
   virtual bool modelValue(unsigned int var) const = 0;
+
+  // Encode-time simplification by fixed variables (on by default).
+  // Turning it off leaves the variables already fixed in place.
+  void setFolding(bool enable);
+  bool folding() const;
+
+  // Whether a unit requirement has fixed the variable, and to what
+  bool isFixed(unsigned int var) const;
+  bool fixedValue(unsigned int var) const;
+
+  // What folding has saved so far
+  unsigned int numDroppedClauses() const;
+  unsigned int numStrippedLiterals() const;
+
+protected:
+  // Simplify the literals of a clause in place.  Returns false if the
+  // clause is already satisfied and can be dropped.  A clause left with
+  // a single literal fixes that literal's variable.
+  bool fold(std::vector<Literal>& lits);
+
+private:
+  // 1 if fixed true, -1 if fixed false, 0 if free; indexed by variable
+  std::vector<signed char> mFixed;
+  bool mFolding = true;
+  unsigned int mNumDroppedClauses = 0;
+  unsigned int mNumStrippedLiterals = 0;
 };
 
 #endif // SOLVER_H
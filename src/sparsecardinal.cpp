@@ -0,0 +1,271 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of the SparseCardinal class
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include "sparsecardinal.h"
+
+using namespace std;
+
+namespace {
+  // Sorts and removes duplicates
+  vector<int> normalizedValues(vector<int> values) {
+    sort(values.begin(), values.end());
+    values.erase(unique(values.begin(), values.end()), values.end());
+    if ( values.empty() ) {
+      throw domain_error("Cannot create a sparse cardinal with an empty set of possible values.");
+    }
+    return values;
+  }
+}
+
+// Creates an object representing a sparse cardinal.
+SparseCardinal::SparseCardinal(Solver* _solver, const vector<int>& _values) :
+  mSolver(_solver),
+  mValues(make_shared<const vector<int> >(normalizedValues(_values))),
+  mOffset(0),
+  mNegated(false),
+  mStartingVar(_solver->newVars(mValues->size()))
+{
+  mSolver->require(typeRequirement());
+}
+
+// Must take at least one value, and cannot take two values simultaneously.
+Requirement SparseCardinal::typeRequirement() const {
+  Requirement result;
+
+  Clause atLeastOneValue;
+  for ( unsigned int i = 0; i < numLiterals(); i++ ) {
+    atLeastOneValue |= Literal(mStartingVar + i);
+  }
+  result &= move(atLeastOneValue);
+
+  for ( unsigned int i = 0; i < numLiterals(); i++ ) {
+    for ( unsigned int j = i+1; j < numLiterals(); j++ ) {
+      result &= ~Literal(mStartingVar + i) | ~Literal(mStartingVar + j);
+    }
+  }
+
+  return result;
+}
+
+unsigned int SparseCardinal::numLiterals() const {
+  return mValues->size();
+}
+
+int SparseCardinal::valueAt(unsigned int index) const {
+  return mNegated ? mOffset - (*mValues)[index] : mOffset + (*mValues)[index];
+}
+
+bool SparseCardinal::contains(int value) const {
+  return (*this == value) != Atom::falsity;
+}
+
+vector<int> SparseCardinal::values() const {
+  vector<int> result;
+  for ( unsigned int i = 0; i < numLiterals(); i++ ) {
+    result.push_back(valueAt(i));
+  }
+  if ( mNegated ) {
+    reverse(result.begin(), result.end());
+  }
+  return result;
+}
+
+int SparseCardinal::min() const {
+  return mNegated ? valueAt(numLiterals()-1) : valueAt(0);
+}
+
+int SparseCardinal::max() const {
+  return (mNegated ? valueAt(0) : valueAt(numLiterals()-1)) + 1;
+}
+
+unsigned int SparseCardinal::startingVar() const {
+  return mStartingVar;
+}
+
+Solver* SparseCardinal::solver() const {
+  return mSolver;
+}
+
+// Arithmetic by constants only changes how values are read off.
+SparseCardinal SparseCardinal::operator+(const int rhs) const {
+  SparseCardinal retVal(*this);
+  retVal.mOffset += rhs;
+  return retVal;
+}
+SparseCardinal SparseCardinal::operator-(const int rhs) const {
+  return *this + (-rhs);
+}
+
+SparseCardinal SparseCardinal::operator-() const {
+  SparseCardinal retVal(*this);
+  retVal.mNegated = !retVal.mNegated;
+  retVal.mOffset = -retVal.mOffset;
+  return retVal;
+}
+
+SparseCardinal operator+(const int lhs, const SparseCardinal& rhs) {
+  return rhs + lhs;
+}
+
+SparseCardinal operator-(const int lhs, const SparseCardinal& rhs) {
+  return (-rhs) + lhs;
+}
+
+// Literals indicating equality with a specific value.
+Atom SparseCardinal::operator==(int rhs) const {
+  int stored = mNegated ? mOffset - rhs : rhs - mOffset;
+  auto it = lower_bound(mValues->begin(), mValues->end(), stored);
+  if ( it == mValues->end() || *it != stored ) {
+    return Atom::falsity;
+  }
+  return Atom(Literal(mStartingVar + (it - mValues->begin())));
+}
+Atom SparseCardinal::operator!=(int rhs) const {
+  return ~(*this == rhs);
+}
+
+// Comparison operators
+Clause SparseCardinal::operator>(int rhs) const {
+  return *this >= rhs+1;
+}
+
+Clause SparseCardinal::operator>=(int rhs) const {
+  Clause result;
+  for ( unsigned int i = 0; i < numLiterals(); i++ ) {
+    if ( valueAt(i) >= rhs ) {
+      result |= Literal(mStartingVar + i);
+    }
+  }
+  return result;
+}
+
+Clause SparseCardinal::operator<(int rhs) const {
+  Clause result;
+  for ( unsigned int i = 0; i < numLiterals(); i++ ) {
+    if ( valueAt(i) < rhs ) {
+      result |= Literal(mStartingVar + i);
+    }
+  }
+  return result;
+}
+
+Clause SparseCardinal::operator<=(int rhs) const {
+  return *this < rhs+1;
+}
+
+Clause operator>(int lhs, const SparseCardinal& rhs) {
+  return rhs < lhs;
+}
+
+Clause operator>=(int lhs, const SparseCardinal& rhs) {
+  return rhs <= lhs;
+}
+
+Clause operator<(int lhs, const SparseCardinal& rhs) {
+  return rhs > lhs;
+}
+
+Clause operator<=(int lhs, const SparseCardinal& rhs) {
+  return rhs >= lhs;
+}
+
+// Requirements that two SparseCardinals be equal.  Values possible for
+// only one side are forbidden; values possible for both are linked.
+Requirement SparseCardinal::operator==(const SparseCardinal& rhs) const {
+  const SparseCardinal& lhs = *this;
+
+  Requirement result;
+
+  for ( int val : lhs.values() ) {
+    result &= lhs != val | rhs == val;
+  }
+  for ( int val : rhs.values() ) {
+    result &= lhs == val | rhs != val;
+  }
+
+  return result;
+}
+
+// Requirements that two SparseCardinals be nonequal; only values
+// possible for both sides need a clause.
+Requirement SparseCardinal::operator!=(const SparseCardinal& rhs) const {
+  const SparseCardinal& lhs = *this;
+
+  Requirement result;
+
+  for ( int val : lhs.values() ) {
+    if ( rhs.contains(val) ) {
+      result &= lhs != val | rhs != val;
+    }
+  }
+
+  return result;
+}
+
+// The value assigned in the model, after solving, if a solution is available.
+int SparseCardinal::modelValue() const {
+  for ( unsigned int i = 0; i < numLiterals(); i++ ) {
+    if ( mSolver->modelValue(mStartingVar + i) == true ) {
+      return valueAt(i);
+    }
+  }
+
+  // Should never reach here.  Results undefined.
+  return min()-1;
+}
+
+// After a solution has been found, a requirement for a different solution
+Literal SparseCardinal::diffSolnReq() const {
+  return ~(currSolnReq());
+}
+Literal SparseCardinal::currSolnReq() const {
+  Atom atm = (*this) == this->modelValue();
+  if ( !atm.isLiteral() ) {
+    throw std::logic_error("In SparseCardinal::currSolnReq(), modelValue() seems not to be a valid model value.");
+  }
+
+  return atm.getLiteral();
+}
+
+SparseCardinal::operator int() const {
+  return modelValue();
+}
+
+Atom operator==(int lhs, const SparseCardinal& rhs) {
+  return rhs == lhs;
+}
+
+Atom operator!=(int lhs, const SparseCardinal& rhs) {
+  return rhs != lhs;
+}
+
+ostream& operator<<(ostream& out, const SparseCardinal& rhs) {
+  out << (int)rhs;
+  return out;
+}
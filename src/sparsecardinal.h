@@ -0,0 +1,136 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Like a Cardinal, represents an unknown integer quantity with one
+// literal per possible value.  Unlike a Cardinal, the possible values
+// are given as an explicit set rather than a contiguous range
+// [min,max), so values known in advance to be impossible cost neither
+// literals nor at-most-one clauses.
+//
+// min() and max() keep the Cardinal conventions (inclusive of min,
+// exclusive of max) and bound the value set; values between them that
+// are not in the set behave exactly like out-of-range values of a
+// Cardinal (equality with them is falsity).
+
+#ifndef SPARSECARDINAL_H
+#define SPARSECARDINAL_H
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "requirement.h"
+#include "solver.h"
+
+class SparseCardinal {
+public:
+  // Builds a sparse cardinal taking one of the given values.
+  // Duplicates are ignored and order is irrelevant; an empty set of
+  // values throws a domain_error.  Allocates one literal per distinct
+  // value and registers the type requirement.
+  SparseCardinal(Solver* solver,
+		 const std::vector<int>& values);
+
+  SparseCardinal() = delete;
+  SparseCardinal(const SparseCardinal& copy) = default;
+  SparseCardinal(SparseCardinal&& move) = default;
+  SparseCardinal& operator=(const SparseCardinal& copy) = default;
+  SparseCardinal& operator=(SparseCardinal&& move) = default;
+
+  // After a solution has been found, a requirement for the current/a different solution
+  Literal diffSolnReq() const;
+  Literal currSolnReq() const;
+
+  // Addition by a constant and negation, as for Cardinal.  Uses no
+  // additional literals or requirements.
+  SparseCardinal operator+(const int rhs) const;
+  SparseCardinal operator-(const int rhs) const;
+  SparseCardinal operator-() const;
+
+  // Literals indicating equality with a specific value.  Values not
+  // in the set give falsity (resp. truth).
+  Atom operator==(int rhs) const;
+  Atom operator!=(int rhs) const;
+
+  // Ordering requirements
+  Clause operator>(int rhs) const;
+  Clause operator>=(int rhs) const;
+  Clause operator<(int rhs) const;
+  Clause operator<=(int rhs) const;
+
+  // Requirements that two SparseCardinals be equal/nonequal, whatever
+  // values they take.  The value sets need not be the same, or even
+  // overlap.
+  Requirement operator==(const SparseCardinal& rhs) const;
+  Requirement operator!=(const SparseCardinal& rhs) const;
+
+  // The corresponding requirement of being a sparse cardinal
+  Requirement typeRequirement() const;
+
+  // The number of literals required; equal to the number of values.
+  unsigned int numLiterals() const;
+
+  // Whether value is one of the possible values
+  bool contains(int value) const;
+
+  // The possible values, in increasing order
+  std::vector<int> values() const;
+
+  // Access basic information
+  int min() const;
+  int max() const;
+  unsigned int startingVar() const;
+  Solver* solver() const;
+
+  // The value assigned in the model, after solving, if a solution is available.
+  int modelValue() const;
+  operator int() const;
+
+private:
+  Solver* mSolver;
+  std::shared_ptr<const std::vector<int> > mValues; // sorted, shared between copies
+  int mOffset;
+  bool mNegated;
+  unsigned int mStartingVar;
+
+  // The value taken when the literal with the given index is true.
+  int valueAt(unsigned int index) const;
+};
+
+// Arithmetic (by constants)
+SparseCardinal operator+(const int lhs, const SparseCardinal& rhs);
+SparseCardinal operator-(const int lhs, const SparseCardinal& rhs);
+
+// Ordering requirements
+Clause operator>(int lhs, const SparseCardinal& rhs);
+Clause operator>=(int lhs, const SparseCardinal& rhs);
+Clause operator<(int lhs, const SparseCardinal& rhs);
+Clause operator<=(int lhs, const SparseCardinal& rhs);
+
+// Comparison operators
+Atom operator==(int lhs, const SparseCardinal& rhs);
+Atom operator!=(int lhs, const SparseCardinal& rhs);
+
+std::ostream& operator<<(std::ostream& out, const SparseCardinal& rhs);
+
+#endif // SPARSECARDINAL_H
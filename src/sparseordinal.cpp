@@ -0,0 +1,264 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of the SparseOrdinal class
+//
+// With stored values s_0 < s_1 < ... < s_{k-1}, literal i means
+// "stored value <= s_i", for i < k-1.
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include "sparseordinal.h"
+
+using namespace std;
+
+namespace {
+  // Sorts and removes duplicates
+  vector<int> normalizedValues(vector<int> values) {
+    sort(values.begin(), values.end());
+    values.erase(unique(values.begin(), values.end()), values.end());
+    if ( values.empty() ) {
+      throw domain_error("Cannot create a sparse ordinal with an empty set of possible values.");
+    }
+    return values;
+  }
+}
+
+// Creates an object representing a sparse ordinal.
+SparseOrdinal::SparseOrdinal(Solver* _solver, const vector<int>& _values) :
+  mSolver(_solver),
+  mValues(make_shared<const vector<int> >(normalizedValues(_values))),
+  mOffset(0),
+  mNegated(false),
+  mStartingVar(_solver->newVars(mValues->size()-1))
+{
+  mSolver->require(typeRequirement());
+}
+
+// The order literals must be monotone.
+Requirement SparseOrdinal::typeRequirement() const {
+  Requirement result;
+  for ( unsigned int i = 0; i+1 < numLiterals(); i++ ) {
+    result &= implication(Literal(mStartingVar + i), Literal(mStartingVar + i + 1));
+  }
+  return result;
+}
+
+unsigned int SparseOrdinal::numLiterals() const {
+  return mValues->size()-1;
+}
+
+bool SparseOrdinal::contains(int value) const {
+  int stored = mNegated ? mOffset - value : value - mOffset;
+  return binary_search(mValues->begin(), mValues->end(), stored);
+}
+
+vector<int> SparseOrdinal::values() const {
+  vector<int> result;
+  for ( int stored : *mValues ) {
+    result.push_back(mNegated ? mOffset - stored : mOffset + stored);
+  }
+  if ( mNegated ) {
+    reverse(result.begin(), result.end());
+  }
+  return result;
+}
+
+int SparseOrdinal::min() const {
+  return mNegated ? mOffset - mValues->back() : mOffset + mValues->front();
+}
+
+int SparseOrdinal::max() const {
+  return (mNegated ? mOffset - mValues->front() : mOffset + mValues->back()) + 1;
+}
+
+Solver* SparseOrdinal::solver() const {
+  return mSolver;
+}
+
+// Arithmetic by constants only changes how values are read off.
+SparseOrdinal SparseOrdinal::operator+(const int rhs) const {
+  SparseOrdinal retVal(*this);
+  retVal.mOffset += rhs;
+  return retVal;
+}
+SparseOrdinal SparseOrdinal::operator-(const int rhs) const {
+  return *this + (-rhs);
+}
+
+SparseOrdinal SparseOrdinal::operator-() const {
+  SparseOrdinal retVal(*this);
+  retVal.mNegated = !retVal.mNegated;
+  retVal.mOffset = -retVal.mOffset;
+  return retVal;
+}
+
+SparseOrdinal operator+(const int lhs, const SparseOrdinal& rhs) {
+  return rhs + lhs;
+}
+SparseOrdinal operator-(const int lhs, const SparseOrdinal& rhs) {
+  return (-rhs) + lhs;
+}
+
+// The stored value is at most bound iff it is at most the largest
+// stored value not exceeding bound.
+Atom SparseOrdinal::storedAtMost(int bound) const {
+  int index = upper_bound(mValues->begin(), mValues->end(), bound) - mValues->begin() - 1;
+  if ( index < 0 ) return Atom::falsity;
+  if ( index >= (int)numLiterals() ) return Atom::truth;
+  return Atom(Literal(mStartingVar + index));
+}
+
+// Comparison operators
+Atom SparseOrdinal::operator<=(int rhs) const {
+  if ( !mNegated ) {
+    return storedAtMost(rhs - mOffset);
+  } else {
+    // offset - stored <= rhs  iff  stored >= offset - rhs
+    return ~storedAtMost(mOffset - rhs - 1);
+  }
+}
+
+Atom SparseOrdinal::operator<(int rhs) const {
+  return *this <= rhs-1;
+}
+
+Atom SparseOrdinal::operator>(int rhs) const {
+  return ~(*this <= rhs);
+}
+
+Atom SparseOrdinal::operator>=(int rhs) const {
+  return ~(*this < rhs);
+}
+
+Atom operator>(int lhs, const SparseOrdinal& rhs) {
+  return rhs < lhs;
+}
+
+Atom operator>=(int lhs, const SparseOrdinal& rhs) {
+  return rhs <= lhs;
+}
+
+Atom operator<(int lhs, const SparseOrdinal& rhs) {
+  return rhs > lhs;
+}
+
+Atom operator<=(int lhs, const SparseOrdinal& rhs) {
+  return rhs >= lhs;
+}
+
+// Equality with a specific value
+DualClause SparseOrdinal::operator==(int rhs) const {
+  if ( !contains(rhs) ) {
+    return DualClause::falsity;
+  }
+
+  DualClause result;
+  result &= *this <= rhs;
+  result &= *this >= rhs;
+  return result;
+}
+Clause SparseOrdinal::operator!=(int rhs) const {
+  return ~(*this == rhs);
+}
+
+DualClause operator==(int lhs, const SparseOrdinal& rhs) {
+  return rhs == lhs;
+}
+
+Clause operator!=(int lhs, const SparseOrdinal& rhs) {
+  return rhs != lhs;
+}
+
+Requirement SparseOrdinal::operator>(const SparseOrdinal& rhs) const {
+  return rhs < *this;
+}
+
+Requirement SparseOrdinal::operator>=(const SparseOrdinal& rhs) const {
+  return rhs <= *this;
+}
+
+Requirement SparseOrdinal::operator<(const SparseOrdinal& rhs) const {
+  return *this+1 <= rhs;
+}
+
+// lhs <= rhs iff, whenever rhs is at most one of its values, so is
+// lhs.  Only the values rhs can take need a clause.
+Requirement SparseOrdinal::operator<=(const SparseOrdinal& rhs) const {
+  const SparseOrdinal& lhs = *this;
+
+  Requirement result;
+  for ( int val : rhs.values() ) {
+    result &= implication(rhs <= val, lhs <= val);
+  }
+  return result;
+}
+
+Requirement SparseOrdinal::operator==(const SparseOrdinal& rhs) const {
+  return *this <= rhs & *this >= rhs;
+}
+
+// Only values possible for both sides need a clause.
+Requirement SparseOrdinal::operator!=(const SparseOrdinal& rhs) const {
+  const SparseOrdinal& lhs = *this;
+
+  Requirement result;
+  for ( int val : lhs.values() ) {
+    if ( rhs.contains(val) ) {
+      result &= (lhs != val | rhs != val);
+    }
+  }
+  return result;
+}
+
+// The value assigned in the model, after solving, if a solution is
+// available.
+int SparseOrdinal::modelValue() const {
+  unsigned int index = 0;
+  while ( index < numLiterals() && mSolver->modelValue(mStartingVar + index) != true ) {
+    index++;
+  }
+
+  int stored = (*mValues)[index];
+  return mNegated ? mOffset - stored : mOffset + stored;
+}
+
+// After a solution has been found, a requirement for a different solution
+Clause SparseOrdinal::diffSolnReq() const {
+  return (*this) != this->modelValue();
+}
+
+DualClause SparseOrdinal::currSolnReq() const {
+  return (*this) == this->modelValue();
+}
+
+SparseOrdinal::operator int() const {
+  return modelValue();
+}
+
+ostream& operator<<(ostream& out, const SparseOrdinal& rhs) {
+  out << (int)rhs;
+  return out;
+}
@@ -0,0 +1,140 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Like an Ordinal, represents an unknown integer quantity using the
+// order encoding, so that order comparisons are single literals.
+// Unlike an Ordinal, the possible values are given as an explicit set
+// rather than a contiguous range [min,max): only the gaps between
+// consecutive possible values need a literal, so a set of k values
+// costs k-1 literals however far apart they are.
+//
+// min() and max() keep the Ordinal conventions (inclusive of min,
+// exclusive of max) and bound the value set.
+
+#ifndef SPARSEORDINAL_H
+#define SPARSEORDINAL_H
+
+#include <iostream>
+#include <memory>
+#include <vector>
+#include "requirement.h"
+#include "solver.h"
+
+class SparseOrdinal {
+public:
+  // Builds a sparse ordinal taking one of the given values.
+  // Duplicates are ignored and order is irrelevant; an empty set of
+  // values throws a domain_error.  Registers the type requirement.
+  SparseOrdinal(Solver* solver,
+		const std::vector<int>& values);
+
+  SparseOrdinal() = delete;
+  SparseOrdinal(const SparseOrdinal& copy) = default;
+  SparseOrdinal(SparseOrdinal&& move) = default;
+  SparseOrdinal& operator=(const SparseOrdinal& copy) = default;
+  SparseOrdinal& operator=(SparseOrdinal&& move) = default;
+
+  // After a solution has been found, a requirement for the current/a different solution
+  Clause     diffSolnReq() const;
+  DualClause currSolnReq() const;
+
+  // Addition by a constant and negation, as for Ordinal.  Uses no
+  // additional literals or requirements.
+  SparseOrdinal operator+(const int rhs) const;
+  SparseOrdinal operator-(const int rhs) const;
+  SparseOrdinal operator-() const;
+
+  // Equality requirements.  Values not in the set give falsity
+  // (resp. truth).
+  DualClause operator==(int rhs) const;
+  Clause     operator!=(int rhs) const;
+
+  // Ordering requirements
+  Atom operator>(int rhs) const;
+  Atom operator>=(int rhs) const;
+  Atom operator<(int rhs) const;
+  Atom operator<=(int rhs) const;
+
+  // Requirements between two SparseOrdinals.  The value sets need not
+  // be the same, or even overlap.
+  Requirement operator==(const SparseOrdinal& rhs) const;
+  Requirement operator!=(const SparseOrdinal& rhs) const;
+  Requirement operator>(const SparseOrdinal& rhs) const;
+  Requirement operator>=(const SparseOrdinal& rhs) const;
+  Requirement operator<(const SparseOrdinal& rhs) const;
+  Requirement operator<=(const SparseOrdinal& rhs) const;
+
+  // The corresponding requirement of being a sparse ordinal
+  Requirement typeRequirement() const;
+
+  // The number of literals required; one less than the number of
+  // values.
+  unsigned int numLiterals() const;
+
+  // Whether value is one of the possible values
+  bool contains(int value) const;
+
+  // The possible values, in increasing order
+  std::vector<int> values() const;
+
+  // The minimum and maximum allowable values
+  int min() const;
+  int max() const;
+
+  // The solver on which the ordinal's literals live
+  Solver* solver() const;
+
+  // The value assigned in the model, after solving, if a solution is
+  // available.
+  int modelValue() const;
+  explicit operator int() const;
+
+private:
+  Solver* mSolver;
+  std::shared_ptr<const std::vector<int> > mValues; // sorted, shared between copies
+  int mOffset;
+  bool mNegated;
+  unsigned int mStartingVar;
+
+  // The atom for "stored value <= bound", ignoring offset and negation.
+  Atom storedAtMost(int bound) const;
+};
+
+// Arithmetic (by constants)
+SparseOrdinal operator+(const int lhs, const SparseOrdinal& rhs);
+SparseOrdinal operator-(const int lhs, const SparseOrdinal& rhs);
+
+// Ordering requirements
+Atom operator>(int lhs, const SparseOrdinal& rhs);
+Atom operator>=(int lhs, const SparseOrdinal& rhs);
+Atom operator<(int lhs, const SparseOrdinal& rhs);
+Atom operator<=(int lhs, const SparseOrdinal& rhs);
+
+// Comparison operators
+DualClause operator==(int lhs, const SparseOrdinal& rhs);
+Clause     operator!=(int lhs, const SparseOrdinal& rhs);
+
+std::ostream& operator<<(std::ostream& out, const SparseOrdinal& rhs);
+
+#endif // SPARSEORDINAL_H
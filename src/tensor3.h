@@ -0,0 +1,422 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// A 3-dimensional array of Scalars, indexed (layer, row, col).
+//
+// The cells are stored as a Matrix of depth*height rows, one layer
+// after another, so their literals are allocated contiguously.
+// Tensor3View reorders and reflects the axes without copying, and any
+// view can be sliced along any axis into a MatrixView.
+//
+
+#ifndef TENSOR3_H
+#define TENSOR3_H
+
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include "requirement.h"
+#include "solver.h"
+#include "cardinal.h"
+#include "matrix.h"
+#include "matrixview.h"
+
+// A view of a Tensor3.  View cell (i0, i1, i2) is the storage cell
+//
+//   (rowOrigin + rowCoef[0]*i0 + rowCoef[1]*i1 + rowCoef[2]*i2,
+//    colOrigin + colCoef[0]*i0 + colCoef[1]*i1 + colCoef[2]*i2),
+//
+// so permutations, reflections and slices only update coefficients.
+template<typename Scalar = Cardinal>
+class Tensor3View {
+public:
+  Tensor3View(const Tensor3View& copy) = default;
+  Tensor3View& operator=(const Tensor3View& copy) = default;
+
+  // The extent along axis 0, 1, 2, and their usual names
+  unsigned int size(int axis) const;
+  unsigned int depth() const;
+  unsigned int height() const;
+  unsigned int width() const;
+
+  // Bounds-checked access to a cell
+  const Scalar& at(int i0, int i1, int i2) const;
+
+  // The MatrixView with axis fixed at index, keeping the other two
+  // axes in order.  operator[] slices along axis 0.
+  MatrixView<Scalar> slice(int axis, int index) const;
+  MatrixView<Scalar> operator[](int index) const;
+
+  // View whose axis n is this view's axis order[n].
+  Tensor3View permute(int axis0, int axis1, int axis2) const;
+
+  // View with the given axis reversed
+  Tensor3View reflect(int axis) const;
+
+  // Requirement that two views of the same shape be equal cell by cell
+  template<typename OtherTensor>
+  Requirement operator==(const OtherTensor& rhs) const;
+
+  // Model values of every cell, in (i0, i1, i2) order
+  std::vector<int> modelValues() const;
+
+  template<typename S>
+  friend class Tensor3;
+private:
+  Tensor3View(const Matrix<Scalar>* base, int depth, int height, int width);
+
+  void checkAxis(int axis) const;
+  // Axes 0, 1 and 2 are depth, height and width
+  static const char* axisName(int axis);
+
+  const Matrix<Scalar>* mBase;
+  int mSize[3];
+  int mRowOrigin;
+  int mColOrigin;
+  int mRowCoef[3];
+  int mColCoef[3];
+};
+
+template<typename Scalar = Cardinal>
+class Tensor3 {
+public:
+  Tensor3(Solver* solver,
+	  int depth,
+	  int height,
+	  int width,
+	  int min,
+	  int max);
+
+  Tensor3() = delete;
+  Tensor3(const Tensor3& copy) = default;
+  Tensor3(Tensor3&& move) = default;
+  Tensor3& operator=(const Tensor3& copy) = default;
+  Tensor3& operator=(Tensor3&& move) = default;
+
+  unsigned int depth() const;
+  unsigned int height() const;
+  unsigned int width() const;
+
+  // Bounds-checked access to a cell
+  const Scalar& at(int layer, int row, int col) const;
+
+  // Views, as for Tensor3View.  operator[] returns a layer.
+  Tensor3View<Scalar> view() const;
+  MatrixView<Scalar> slice(int axis, int index) const;
+  MatrixView<Scalar> operator[](int layer) const;
+  Tensor3View<Scalar> permute(int axis0, int axis1, int axis2) const;
+  Tensor3View<Scalar> reflect(int axis) const;
+
+  Requirement typeRequirement() const;
+  unsigned int numLiterals() const;
+  Clause diffSolnReq() const;
+  DualClause currSolnReq() const;
+
+  // Model values of every cell, in (layer, row, col) order
+  std::vector<int> modelValues() const;
+
+  // The underlying storage: layers stacked vertically
+  const Matrix<Scalar>& data() const;
+
+private:
+  static int checkedRows(int depth, int height, int width);
+
+  int mDepth;
+  Matrix<Scalar> mCells;
+};
+
+//
+// Tensor3View
+//
+
+template<typename Scalar>
+Tensor3View<Scalar>::Tensor3View(const Matrix<Scalar>* base, int depth, int height, int width) :
+  mBase(base),
+  mRowOrigin(0),
+  mColOrigin(0)
+{
+  mSize[0] = depth;
+  mSize[1] = height;
+  mSize[2] = width;
+
+  // Layer k starts at storage row k*height.
+  mRowCoef[0] = height;
+  mRowCoef[1] = 1;
+  mRowCoef[2] = 0;
+  mColCoef[0] = 0;
+  mColCoef[1] = 0;
+  mColCoef[2] = 1;
+}
+
+template<typename Scalar>
+void Tensor3View<Scalar>::checkAxis(int axis) const {
+  if ( axis < 0 || axis > 2 ) {
+    throwGridArgumentError("axis", axis, "Tensor3");
+  }
+}
+
+template<typename Scalar>
+const char* Tensor3View<Scalar>::axisName(int axis) {
+  static const char* const names[3] = {"depth", "height", "width"};
+  return names[axis];
+}
+
+template<typename Scalar>
+unsigned int Tensor3View<Scalar>::size(int axis) const {
+  checkAxis(axis);
+  return mSize[axis];
+}
+
+template<typename Scalar>
+unsigned int Tensor3View<Scalar>::depth() const {
+  return mSize[0];
+}
+
+template<typename Scalar>
+unsigned int Tensor3View<Scalar>::height() const {
+  return mSize[1];
+}
+
+template<typename Scalar>
+unsigned int Tensor3View<Scalar>::width() const {
+  return mSize[2];
+}
+
+template<typename Scalar>
+const Scalar& Tensor3View<Scalar>::at(int i0, int i1, int i2) const {
+  int index[3] = {i0, i1, i2};
+  for ( int axis = 0; axis < 3; axis++ ) {
+    if ( index[axis] < 0 || index[axis] >= mSize[axis] ) {
+      throwGridIndexError("index", index[axis], axisName(axis), mSize[axis], "Tensor3");
+    }
+  }
+
+  int row = mRowOrigin + mRowCoef[0]*i0 + mRowCoef[1]*i1 + mRowCoef[2]*i2;
+  int col = mColOrigin + mColCoef[0]*i0 + mColCoef[1]*i1 + mColCoef[2]*i2;
+  return mBase->at_unchecked(row, col);
+}
+
+template<typename Scalar>
+MatrixView<Scalar> Tensor3View<Scalar>::slice(int axis, int index) const {
+  checkAxis(axis);
+  if ( index < 0 || index >= mSize[axis] ) {
+    throwGridIndexError("index", index, axisName(axis), mSize[axis], "Tensor3");
+  }
+
+  // The two remaining axes, in order, become the rows and columns.
+  int rowAxis = axis == 0 ? 1 : 0;
+  int colAxis = axis == 2 ? 1 : 2;
+
+  return MatrixView<Scalar>(mBase, mSize[rowAxis], mSize[colAxis],
+			    mRowOrigin + mRowCoef[axis]*index, mRowCoef[rowAxis], mRowCoef[colAxis],
+			    mColOrigin + mColCoef[axis]*index, mColCoef[rowAxis], mColCoef[colAxis]);
+}
+
+template<typename Scalar>
+MatrixView<Scalar> Tensor3View<Scalar>::operator[](int index) const {
+  return slice(0, index);
+}
+
+template<typename Scalar>
+Tensor3View<Scalar> Tensor3View<Scalar>::permute(int axis0, int axis1, int axis2) const {
+  int order[3] = {axis0, axis1, axis2};
+  bool seen[3] = {false, false, false};
+  for ( int n = 0; n < 3; n++ ) {
+    checkAxis(order[n]);
+    if ( seen[order[n]] ) {
+      throw std::invalid_argument("Tensor3 permutation repeats an axis.");
+    }
+    seen[order[n]] = true;
+  }
+
+  Tensor3View newView(*this);
+  for ( int n = 0; n < 3; n++ ) {
+    newView.mSize[n]    = mSize[order[n]];
+    newView.mRowCoef[n] = mRowCoef[order[n]];
+    newView.mColCoef[n] = mColCoef[order[n]];
+  }
+  return newView;
+}
+
+// Substitute i -> size-1-i along the axis
+template<typename Scalar>
+Tensor3View<Scalar> Tensor3View<Scalar>::reflect(int axis) const {
+  checkAxis(axis);
+
+  Tensor3View newView(*this);
+  newView.mRowOrigin += mRowCoef[axis]*(mSize[axis]-1);
+  newView.mColOrigin += mColCoef[axis]*(mSize[axis]-1);
+  newView.mRowCoef[axis] = -mRowCoef[axis];
+  newView.mColCoef[axis] = -mColCoef[axis];
+  return newView;
+}
+
+template<typename Scalar>
+template<typename OtherTensor>
+Requirement Tensor3View<Scalar>::operator==(const OtherTensor& rhs) const {
+  if ( depth() != rhs.depth() || height() != rhs.height() || width() != rhs.width() ) {
+    return Atom::falsity;
+  }
+
+  Requirement req;
+  for ( int i0 = 0; i0 < mSize[0]; i0++ ) {
+    for ( int i1 = 0; i1 < mSize[1]; i1++ ) {
+      for ( int i2 = 0; i2 < mSize[2]; i2++ ) {
+	req &= at(i0, i1, i2) == rhs.at(i0, i1, i2);
+      }
+    }
+  }
+  return req;
+}
+
+template<typename Scalar>
+std::vector<int> Tensor3View<Scalar>::modelValues() const {
+  std::vector<int> result;
+  result.reserve(mSize[0]*mSize[1]*mSize[2]);
+  for ( int i0 = 0; i0 < mSize[0]; i0++ ) {
+    for ( int i1 = 0; i1 < mSize[1]; i1++ ) {
+      for ( int i2 = 0; i2 < mSize[2]; i2++ ) {
+	result.push_back(at(i0, i1, i2).modelValue());
+      }
+    }
+  }
+  return result;
+}
+
+//
+// Tensor3
+//
+
+// Validates the dimensions before any storage is built
+template<typename Scalar>
+int Tensor3<Scalar>::checkedRows(int depth, int height, int width) {
+  if ( depth < 0 ) throwGridArgumentError("depth", depth, "Tensor3");
+  if ( height < 0 ) throwGridArgumentError("height", height, "Tensor3");
+  if ( width < 0 ) throwGridArgumentError("width", width, "Tensor3");
+  return depth*height;
+}
+
+template<typename Scalar>
+Tensor3<Scalar>::Tensor3(Solver* _solver,
+			 int _depth,
+			 int _height,
+			 int _width,
+			 int _min,
+			 int _max) :
+  mDepth(_depth),
+  mCells(_solver, checkedRows(_depth, _height, _width), _width, _min, _max)
+{
+}
+
+template<typename Scalar>
+unsigned int Tensor3<Scalar>::depth() const {
+  return mDepth;
+}
+
+template<typename Scalar>
+unsigned int Tensor3<Scalar>::height() const {
+  return mDepth == 0 ? 0 : mCells.height() / mDepth;
+}
+
+template<typename Scalar>
+unsigned int Tensor3<Scalar>::width() const {
+  return mCells.width();
+}
+
+template<typename Scalar>
+const Scalar& Tensor3<Scalar>::at(int layer, int row, int col) const {
+  return view().at(layer, row, col);
+}
+
+template<typename Scalar>
+Tensor3View<Scalar> Tensor3<Scalar>::view() const {
+  return Tensor3View<Scalar>(&mCells, depth(), height(), width());
+}
+
+template<typename Scalar>
+MatrixView<Scalar> Tensor3<Scalar>::slice(int axis, int index) const {
+  return view().slice(axis, index);
+}
+
+template<typename Scalar>
+MatrixView<Scalar> Tensor3<Scalar>::operator[](int layer) const {
+  return view().slice(0, layer);
+}
+
+template<typename Scalar>
+Tensor3View<Scalar> Tensor3<Scalar>::permute(int axis0, int axis1, int axis2) const {
+  return view().permute(axis0, axis1, axis2);
+}
+
+template<typename Scalar>
+Tensor3View<Scalar> Tensor3<Scalar>::reflect(int axis) const {
+  return view().reflect(axis);
+}
+
+template<typename Scalar>
+Requirement Tensor3<Scalar>::typeRequirement() const {
+  return mCells.typeRequirement();
+}
+
+template<typename Scalar>
+unsigned int Tensor3<Scalar>::numLiterals() const {
+  return mCells.numLiterals();
+}
+
+template<typename Scalar>
+Clause Tensor3<Scalar>::diffSolnReq() const {
+  return mCells.diffSolnReq();
+}
+
+template<typename Scalar>
+DualClause Tensor3<Scalar>::currSolnReq() const {
+  return mCells.currSolnReq();
+}
+
+// Storage order is (layer, row, col) order, so decode straight through.
+template<typename Scalar>
+std::vector<int> Tensor3<Scalar>::modelValues() const {
+  std::vector<int> result;
+  result.reserve(mCells.data().size());
+  for ( const Scalar& cell : mCells.data() ) {
+    result.push_back(cell.modelValue());
+  }
+  return result;
+}
+
+template<typename Scalar>
+const Matrix<Scalar>& Tensor3<Scalar>::data() const {
+  return mCells;
+}
+
+// Output operator: layers separated by blank lines
+template<class Scalar>
+std::ostream& operator<<(std::ostream& out, const Tensor3<Scalar>& tensor) {
+  for ( int layer = 0; layer < tensor.depth(); layer++ ) {
+    out << tensor[layer] << std::endl;
+  }
+  return out;
+}
+
+#endif // TENSOR3_H
@@ -0,0 +1,116 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of Tiling.
+
+#include <stdexcept>
+#include "tiling.h"
+
+using namespace std;
+
+namespace {
+// Open cells, numbered in row-major order, as columns after the pieces
+vector<int> cellColumns(int numPieces, int height, int width, Placements::open_cell_type open) {
+  vector<int> result(height < 0 || width < 0 ? 0 : height*width, -1);
+  int column = numPieces;
+  for ( int row = 0; row < height; row++ ) {
+    for ( int col = 0; col < width; col++ ) {
+      if ( !open || open(row, col) ) {
+	result[row*width + col] = column++;
+      }
+    }
+  }
+  return result;
+}
+
+int numOpen(const vector<int>& columns) {
+  int result = 0;
+  for ( int column : columns ) {
+    result += column >= 0;
+  }
+  return result;
+}
+} // namespace
+
+Tiling::Tiling(const vector<Pattern>& pieces, int height, int width, 
+	       bool turnable, Placements::open_cell_type open) :
+  mHeight(height),
+  mWidth(width),
+  mNumPieces(pieces.size()),
+  mProblem(0)
+{
+  const vector<int> columns = cellColumns(mNumPieces, height, width, open);
+  mProblem = ExactCover(mNumPieces + numOpen(columns));
+
+  for ( int piece = 0; piece < mNumPieces; piece++ ) {
+    for ( auto& placement : Placements::enumerate(pieces[piece], height, width, turnable, open) ) {
+      vector<int> covered(1, piece);
+      for ( auto cell : placement.cells ) {
+	covered.push_back(columns[cell.first*width + cell.second]);
+      }
+      mProblem.addRow(covered);
+      mPieces.push_back(piece);
+      mPlacements.push_back(move(placement));
+    }
+  }
+}
+
+int Tiling::height() const {
+  return mHeight;
+}
+
+int Tiling::width() const {
+  return mWidth;
+}
+
+int Tiling::numPieces() const {
+  return mNumPieces;
+}
+
+const ExactCover& Tiling::problem() const {
+  return mProblem;
+}
+
+int Tiling::piece(int row) const {
+  return mPieces.at(row);
+}
+
+const Placements::Placement& Tiling::placement(int row) const {
+  return mPlacements.at(row);
+}
+
+Array2d<int> Tiling::labels(const vector<int>& rows) const {
+  Array2d<int> result(mHeight, mWidth);
+  for ( int row = 0; row < mHeight; row++ ) {
+    for ( int col = 0; col < mWidth; col++ ) {
+      result[row][col] = -1;
+    }
+  }
+  for ( int row : rows ) {
+    for ( auto cell : placement(row).cells ) {
+      result[cell.first][cell.second] = piece(row);
+    }
+  }
+  return result;
+}
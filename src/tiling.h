@@ -0,0 +1,70 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Tilings of a grid by polyominoes, as an exact cover problem.
+//
+// Each piece (a Pattern, possibly repeated) is placed exactly once and
+// each open cell is covered exactly once.  The ExactCover has one
+// primary column per piece and per open cell, and one row per
+// placement that fits (see Placements::enumerate); its solutions turn
+// back into grids of piece indices with labels().  Unlike Placements,
+// nothing here goes through a Solver.
+
+#ifndef TILING_H
+#define TILING_H
+
+#include <vector>
+#include "array2d.h"
+#include "exactcover.h"
+#include "pattern.h"
+#include "placements.h"
+
+class Tiling {
+public:
+  Tiling(const std::vector<Pattern>& pieces, int height, int width, 
+	 bool turnable = true, Placements::open_cell_type open = nullptr);
+
+  int height() const;
+  int width() const;
+  int numPieces() const;
+
+  const ExactCover& problem() const;
+
+  // The piece and placement of a row of problem()
+  int piece(int row) const;
+  const Placements::Placement& placement(int row) const;
+
+  // The piece covering each cell in a solution; -1 where none does
+  Array2d<int> labels(const std::vector<int>& rows) const;
+
+private:
+  int mHeight;
+  int mWidth;
+  int mNumPieces;
+  ExactCover mProblem;
+  std::vector<int> mPieces;
+  std::vector<Placements::Placement> mPlacements;
+};
+
+#endif // TILING_H
@@ -0,0 +1,137 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Implementation of WindowRule
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include "windowrule.h"
+
+using namespace std;
+
+WindowRule::WindowRule(int _height, 
+		       int _width, 
+		       const vector<int>& _values, 
+		       predicate_type predicate) :
+  mHeight(_height),
+  mWidth(_width)
+{
+  if ( mHeight <= 0 || mWidth <= 0 ) {
+    std::ostringstream sout;
+    sout << "Invalid window dimensions " << mHeight << " x " << mWidth;
+    throw std::invalid_argument(sout.str());
+  }
+
+  vector<int> values(_values);
+  sort(values.begin(), values.end());
+  values.erase(unique(values.begin(), values.end()), values.end());
+
+  if ( mHeight*mWidth == 2 ) {
+    compilePairs(values, predicate);
+  } else {
+    compileTuples(values, predicate);
+  }
+}
+
+WindowRule WindowRule::horizontal(const vector<int>& values, pair_predicate_type predicate) {
+  return WindowRule(1, 2, values, [predicate] (const vector<int>& cells) {
+      return predicate(cells[0], cells[1]);
+    });
+}
+
+WindowRule WindowRule::vertical(const vector<int>& values, pair_predicate_type predicate) {
+  return WindowRule(2, 1, values, [predicate] (const vector<int>& cells) {
+      return predicate(cells[0], cells[1]);
+    });
+}
+
+int WindowRule::height() const {
+  return mHeight;
+}
+
+int WindowRule::width() const {
+  return mWidth;
+}
+
+unsigned int WindowRule::numClauses() const {
+  return mClauses.size();
+}
+
+// For each cell and value, the cell taking the value implies the other
+// cell takes one of the values compatible with it.  Values compatible
+// with everything need no clause.
+void WindowRule::compilePairs(const vector<int>& values, predicate_type predicate) {
+  vector<int> cells(2);
+  for ( int cell = 0; cell < 2; cell++ ) {
+    for ( int value : values ) {
+      TemplateClause clause{ TemplateLiteral{cell, value, false} };
+      for ( int other : values ) {
+	cells[cell] = value;
+	cells[1-cell] = other;
+	if ( predicate(cells) ) {
+	  clause.push_back(TemplateLiteral{1-cell, other, true});
+	}
+      }
+
+      if ( clause.size() <= values.size() ) {
+	mClauses.push_back(clause);
+      }
+    }
+  }
+}
+
+// Forbid each combination of values that fails the predicate.
+void WindowRule::compileTuples(const vector<int>& values, predicate_type predicate) {
+  int numCells = mHeight*mWidth;
+  if ( values.empty() ) {
+    return;
+  }
+
+  // Odometer over value indices
+  vector<int> indices(numCells, 0);
+  vector<int> cells(numCells);
+  while ( true ) {
+    for ( int cell = 0; cell < numCells; cell++ ) {
+      cells[cell] = values[indices[cell]];
+    }
+
+    if ( !predicate(cells) ) {
+      TemplateClause clause;
+      for ( int cell = 0; cell < numCells; cell++ ) {
+	clause.push_back(TemplateLiteral{cell, cells[cell], false});
+      }
+      mClauses.push_back(clause);
+    }
+
+    int cell = numCells-1;
+    while ( cell >= 0 && ++indices[cell] == values.size() ) {
+      indices[cell] = 0;
+      cell--;
+    }
+    if ( cell < 0 ) {
+      break;
+    }
+  }
+}
@@ -0,0 +1,155 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Local rules over sliding windows of a grid.
+//
+// A WindowRule is a predicate over the values of the cells in a
+// height x width window, such as "horizontally adjacent cells take
+// adjacent colors".  The predicate is evaluated once, when the rule is
+// built, and compiled into clause templates over (window cell, value)
+// pairs; stamp() then instantiates the templates at every window
+// position of a Matrix, MatrixView or any other grid.
+//
+// Two-cell windows are compiled into support clauses (a cell taking a
+// value implies its neighbor takes a compatible value), which
+// propagate as well as the hand-written versions.  Larger windows are
+// compiled into one clause per forbidden combination of values, so
+// their cost grows as values^cells.
+//
+// Cells must be Scalars whose operator==(int) returns an Atom, such as
+// Cardinal or SparseCardinal.  Values outside a cell's domain fold to
+// falsity, so a rule over the union of several domains stays tight.
+
+#ifndef WINDOWRULE_H
+#define WINDOWRULE_H
+
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include "atom.h"
+#include "clause.h"
+#include "requirement.h"
+
+class WindowRule {
+public:
+  // Values of the window's cells in row-major order
+  typedef std::function<bool(const std::vector<int>&)> predicate_type;
+  typedef std::function<bool(int, int)> pair_predicate_type;
+
+  WindowRule(int height, 
+	     int width, 
+	     const std::vector<int>& values, 
+	     predicate_type predicate);
+
+  // Rules over 1 x 2 and 2 x 1 windows: (left, right) and (top, bottom)
+  static WindowRule horizontal(const std::vector<int>& values, pair_predicate_type predicate);
+  static WindowRule vertical(const std::vector<int>& values, pair_predicate_type predicate);
+
+  int height() const;
+  int width() const;
+  unsigned int numClauses() const;
+
+  // The rule for the window whose top-left cell is (row, col).  cell
+  // is any callable returning the Scalar at (row, col).
+  template<class CellAccess>
+  Requirement apply(CellAccess cell, int row, int col) const;
+
+  // The rule at every window position of a height x width grid, and
+  // at the positions whose top row is row (e.g., for requireRows())
+  template<class CellAccess>
+  Requirement stamp(CellAccess cell, int height, int width) const;
+  template<class CellAccess>
+  Requirement stampRow(CellAccess cell, int row, int width) const;
+
+  // The rule at every window position of a grid that supports
+  // height(), width() and double indexing
+  template<class GridType>
+  Requirement stamp(const GridType& grid) const;
+
+private:
+  // cell == value if equal, cell != value otherwise
+  struct TemplateLiteral {
+    int cell;
+    int value;
+    bool equal;
+  };
+  typedef std::vector<TemplateLiteral> TemplateClause;
+
+  void compilePairs(const std::vector<int>& values, predicate_type predicate);
+  void compileTuples(const std::vector<int>& values, predicate_type predicate);
+
+  int mHeight;
+  int mWidth;
+  std::vector<TemplateClause> mClauses;
+};
+
+template<class CellAccess>
+Requirement WindowRule::apply(CellAccess cell, int row, int col) const {
+  // Fetch each cell of the window once.
+  typedef typename std::decay<decltype(cell(row, col))>::type Scalar;
+  std::vector<Scalar> cells;
+  cells.reserve(mHeight*mWidth);
+  for ( int i = 0; i < mHeight; i++ ) {
+    for ( int j = 0; j < mWidth; j++ ) {
+      cells.push_back(cell(row+i, col+j));
+    }
+  }
+
+  Requirement result;
+  for ( const TemplateClause& templ : mClauses ) {
+    Clause clause;
+    for ( const TemplateLiteral& lit : templ ) {
+      Atom atom = cells[lit.cell] == lit.value;
+      clause |= lit.equal ? atom : ~atom;
+    }
+    result &= clause;
+  }
+  return result;
+}
+
+template<class CellAccess>
+Requirement WindowRule::stamp(CellAccess cell, int height, int width) const {
+  Requirement result;
+  for ( int row = 0; row + mHeight <= height; row++ ) {
+    result &= stampRow(cell, row, width);
+  }
+  return result;
+}
+
+template<class CellAccess>
+Requirement WindowRule::stampRow(CellAccess cell, int row, int width) const {
+  Requirement result;
+  for ( int col = 0; col + mWidth <= width; col++ ) {
+    result &= apply(cell, row, col);
+  }
+  return result;
+}
+
+template<class GridType>
+Requirement WindowRule::stamp(const GridType& grid) const {
+  return stamp([&grid] (int row, int col) { return grid[row][col]; }, 
+	       grid.height(), grid.width());
+}
+
+#endif // WINDOWRULE_H
@@ -0,0 +1,193 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "../src/adjacency.h"
+
+using namespace std;
+
+class AdjacencyTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(AdjacencyTest);
+  CPPUNIT_TEST(testFromIncidences);
+  CPPUNIT_TEST(testWideRows);
+  CPPUNIT_TEST(testReadMatrix);
+  CPPUNIT_TEST(testMapRoundTrip);
+  CPPUNIT_TEST(testMapErrors);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testFromIncidences(void);
+  void testWideRows(void);
+  void testReadMatrix(void);
+  void testMapRoundTrip(void);
+  void testMapErrors(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( AdjacencyTest );
+
+namespace {
+  // A file in /tmp, removed when the TempFile goes out of scope
+  class TempFile {
+  public:
+    explicit TempFile(const string& suffix) {
+      char name[] = "/tmp/adjacencytestXXXXXX";
+      int fd = mkstemp(name);
+      close(fd);
+      unlink(name);
+      mPath = string(name) + suffix;
+    }
+    ~TempFile() { remove(mPath.c_str()); }
+    const string& path() const { return mPath; }
+  private:
+    string mPath;
+  };
+
+  // The cycle on order vertices
+  vector<vector<bool> > cycle(int order) {
+    vector<vector<bool> > result(order, vector<bool>(order));
+    for ( int vertex = 0; vertex < order; vertex++ ) {
+      result[vertex][(vertex+1) % order] = true;
+      result[(vertex+1) % order][vertex] = true;
+    }
+    return result;
+  }
+}
+
+void AdjacencyTest::testFromIncidences(void) {
+  vector<vector<bool> > incidences = { { false, true,  true },
+				       { false, false, true },
+				       { true,  false, true } };
+  Adjacency graph(incidences);
+
+  CPPUNIT_ASSERT_EQUAL(3, graph.order());
+  CPPUNIT_ASSERT_EQUAL(1, graph.wordsPerRow());
+  for ( int src = 0; src < 3; src++ ) {
+    for ( int dst = 0; dst < 3; dst++ ) {
+      CPPUNIT_ASSERT_EQUAL(bool(incidences[src][dst]), graph.adjacent(src, dst));
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL(2, graph.degree(0));
+  CPPUNIT_ASSERT_EQUAL(1, graph.degree(1));
+  CPPUNIT_ASSERT(graph.neighbors(2) == vector<int>({0, 2}));
+  CPPUNIT_ASSERT(graph.incidences() == incidences);
+  CPPUNIT_ASSERT(graph.transpose().neighbors(2) == vector<int>({0, 1, 2}));
+  CPPUNIT_ASSERT(graph.transpose().transpose().incidences() == incidences);
+
+  CPPUNIT_ASSERT_THROW(graph.adjacent(0, 3), out_of_range);
+  CPPUNIT_ASSERT_THROW(graph.degree(-1), out_of_range);
+  CPPUNIT_ASSERT_EQUAL(0, Adjacency().order());
+}
+
+void AdjacencyTest::testWideRows(void) {
+  // Neighbors straddle word boundaries.
+  Adjacency graph(cycle(130));
+
+  CPPUNIT_ASSERT_EQUAL(3, graph.wordsPerRow());
+  CPPUNIT_ASSERT(graph.neighbors(0) == vector<int>({1, 129}));
+  CPPUNIT_ASSERT(graph.neighbors(64) == vector<int>({63, 65}));
+  CPPUNIT_ASSERT(graph.neighbors(128) == vector<int>({127, 129}));
+  for ( int vertex = 0; vertex < 130; vertex++ ) {
+    CPPUNIT_ASSERT_EQUAL(2, graph.degree(vertex));
+  }
+  CPPUNIT_ASSERT_EQUAL(Adjacency::word_type(1) << 1, graph.row(0)[0]);
+  CPPUNIT_ASSERT_EQUAL(Adjacency::word_type(1) << 1, graph.row(0)[2]);
+}
+
+void AdjacencyTest::testReadMatrix(void) {
+  istringstream in("3\n0 1 1 \n1 0 1 \n1 1 0 \n");
+  Adjacency graph = Adjacency::readMatrix(in);
+  CPPUNIT_ASSERT_EQUAL(3, graph.order());
+  CPPUNIT_ASSERT(!graph.adjacent(1, 1));
+  CPPUNIT_ASSERT(graph.adjacent(1, 2));
+
+  istringstream shortIn("3\n0 1 1 \n1 0 1 \n");
+  CPPUNIT_ASSERT_THROW(Adjacency::readMatrix(shortIn), runtime_error);
+  istringstream wordIn("2\n0 x\n");
+  CPPUNIT_ASSERT_THROW(Adjacency::readMatrix(wordIn), runtime_error);
+}
+
+void AdjacencyTest::testMapRoundTrip(void) {
+  TempFile file(".mtxb");
+  Adjacency original(cycle(70));
+  {
+    ofstream out(file.path(), ios::binary);
+    original.write(out);
+  }
+
+  Adjacency mapped = Adjacency::load(file.path());
+  CPPUNIT_ASSERT_EQUAL(70, mapped.order());
+  CPPUNIT_ASSERT(mapped.incidences() == original.incidences());
+  CPPUNIT_ASSERT(mapped.neighbors(69) == vector<int>({0, 68}));
+
+  // Copies share the mapping, which outlives the original.
+  Adjacency copy = mapped;
+  mapped = Adjacency();
+  CPPUNIT_ASSERT_EQUAL(2, copy.degree(65));
+
+  TempFile text(".mtx");
+  {
+    ofstream out(text.path());
+    out << "2\n0 1\n0 0\n";
+  }
+  Adjacency parsed = Adjacency::load(text.path());
+  CPPUNIT_ASSERT(parsed.adjacent(0, 1));
+  CPPUNIT_ASSERT(!parsed.adjacent(1, 0));
+}
+
+void AdjacencyTest::testMapErrors(void) {
+  string valid;
+  {
+    ostringstream out;
+    Adjacency(cycle(5)).write(out);
+    valid = out.str();
+  }
+
+  TempFile file(".mtxb");
+  auto mapWith = [&] (const string& contents) {
+    {
+      ofstream out(file.path(), ios::binary);
+      out << contents;
+    }
+    return Adjacency::map(file.path());
+  };
+
+  CPPUNIT_ASSERT_EQUAL(5, mapWith(valid).order());
+  CPPUNIT_ASSERT_THROW(mapWith(valid.substr(0, 10)), runtime_error);
+  CPPUNIT_ASSERT_THROW(mapWith(valid.substr(0, valid.size()-1)), runtime_error);
+  CPPUNIT_ASSERT_THROW(mapWith("MTXA" + valid.substr(4)), runtime_error);
+
+  // A neighbor past the order
+  string padded = valid;
+  padded[24] |= 0x80;
+  CPPUNIT_ASSERT_THROW(mapWith(padded), runtime_error);
+
+  CPPUNIT_ASSERT_THROW(Adjacency::map("/nonexistent/graph.mtxb"), runtime_error);
+}
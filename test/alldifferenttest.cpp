@@ -0,0 +1,150 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <algorithm>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/alldifferent.h"
+
+using namespace std;
+
+class AllDifferentTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(AllDifferentTest);
+  CPPUNIT_TEST(testSmallIsPairwise);
+  CPPUNIT_TEST(testLinearSize);
+  CPPUNIT_TEST(testPermutationClauses);
+  CPPUNIT_TEST(testPigeonhole);
+  CPPUNIT_TEST(testExhaustive);
+  CPPUNIT_TEST(testHallIntervals);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testSmallIsPairwise(void);
+  void testLinearSize(void);
+  void testPermutationClauses(void);
+  void testPigeonhole(void);
+  void testExhaustive(void);
+  void testHallIntervals(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( AllDifferentTest );
+
+void AllDifferentTest::testSmallIsPairwise(void) {
+  MockSolver solver;
+  Cardinal card1(&solver, 0, 4);
+  Cardinal card2(&solver, 1, 5);
+
+  // Few enough Cardinals that this is exactly the pairwise requirement
+  CPPUNIT_ASSERT_EQUAL(card1 != card2, allDifferent({card1, card2}));
+}
+
+void AllDifferentTest::testLinearSize(void) {
+  MockSolver solver;
+  vector<Cardinal> cards;
+  for ( int i = 0; i < 30; i++ ) {
+    cards.push_back(Cardinal(&solver, 0, 40));
+  }
+
+  Requirement result = allDifferent(cards);
+
+  // Pairwise nonequality would need 30*29/2*40 = 17400 clauses.  The
+  // sequential encoding needs fewer than 3 per Cardinal per value.
+  CPPUNIT_ASSERT(result.size() < 3*30*40);
+}
+
+void AllDifferentTest::testPermutationClauses(void) {
+  MockSolver solver;
+  vector<Cardinal> cards;
+  for ( int i = 0; i < 3; i++ ) {
+    cards.push_back(Cardinal(&solver, 0, 3));
+  }
+
+  Requirement result = allDifferent(cards);
+
+  for ( int value = 0; value < 3; value++ ) {
+    Clause used = cards[0] == value | cards[1] == value | cards[2] == value;
+    CPPUNIT_ASSERT(find(result.begin(), result.end(), used) != result.end());
+  }
+
+  // With a spare value, there are no such clauses
+  cards.push_back(Cardinal(&solver, 0, 5));
+  result = allDifferent(cards);
+  Clause used = cards[0] == 0 | cards[1] == 0 | cards[2] == 0 | cards[3] == 0;
+  CPPUNIT_ASSERT(find(result.begin(), result.end(), used) == result.end());
+}
+
+void AllDifferentTest::testPigeonhole(void) {
+  MockSolver solver;
+  vector<Cardinal> cards;
+  for ( int i = 0; i < 4; i++ ) {
+    cards.push_back(Cardinal(&solver, 0, 3));
+  }
+
+  CPPUNIT_ASSERT_EQUAL(Requirement(Clause()), allDifferent(cards));
+}
+
+void AllDifferentTest::testExhaustive(void) {
+  for ( int hall = 0; hall < 2; hall++ ) {
+    MinisatSolver solver;
+    vector<Cardinal> cards;
+    for ( int i = 0; i < 5; i++ ) {
+      cards.push_back(Cardinal(&solver, 0, 6));
+    }
+    solver.require(allDifferent(cards, hall));
+
+    // Try every assignment to the first three, with the others free.
+    for ( int a = 0; a < 6; a++ ) {
+      for ( int b = 0; b < 6; b++ ) {
+	for ( int c = 0; c < 6; c++ ) {
+	  bool distinct = a != b && b != c && a != c;
+	  bool solved = solver.solve((cards[0] == a) & (cards[1] == b) & (cards[2] == c));
+	  CPPUNIT_ASSERT_EQUAL(distinct, solved);
+	}
+      }
+    }
+  }
+}
+
+void AllDifferentTest::testHallIntervals(void) {
+  MinisatSolver solver;
+  vector<Cardinal> cards;
+  cards.push_back(Cardinal(&solver, 0, 2));
+  cards.push_back(Cardinal(&solver, 0, 2));
+  cards.push_back(Cardinal(&solver, 0, 3));
+  cards.push_back(Cardinal(&solver, 0, 5));
+
+  solver.require(allDifferent(cards, true));
+
+  // The first two Cardinals use up {0,1}, so the third must be 2.
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(2, cards[2].modelValue());
+  ASSERT_UNSAT_ASSUMP(solver, DualClause(cards[2] == 1), cards[2]);
+  ASSERT_UNSAT_ASSUMP(solver, DualClause(cards[3] == 2), cards[3]);
+}
@@ -0,0 +1,172 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/cardinal.h"
+#include "../src/graphs.h"
+#include "../src/graphhomomorphism.h"
+#include "../src/automorphisms.h"
+
+using namespace std;
+
+class AutomorphismsTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(AutomorphismsTest);
+  CPPUNIT_TEST(testGroupSizes);
+  CPPUNIT_TEST(testColors);
+  CPPUNIT_TEST(testGenerators);
+  CPPUNIT_TEST(testLexLeader);
+  CPPUNIT_TEST(testSymmetryBreaking);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testGroupSizes(void);
+  void testColors(void);
+  void testGenerators(void);
+  void testLexLeader(void);
+  void testSymmetryBreaking(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( AutomorphismsTest );
+
+namespace {
+  Adjacency cycle(int order) {
+    return Graph(order, [=] (int src, int dst) {
+	return (src+1) % order == dst || (dst+1) % order == src;
+      }).adjacency();
+  }
+
+  // Outer 5-cycle 0-4, inner pentagram 5-9, spokes i -- i+5
+  Adjacency petersen() {
+    return Graph(10, [] (int src, int dst) {
+	if ( src > dst ) swap(src, dst);
+	if ( dst < 5 ) return (src+1) % 5 == dst || (dst+1) % 5 == src;
+	if ( src >= 5 ) return (src-5+2) % 5 == dst-5 || (dst-5+2) % 5 == src-5;
+	return dst == src+5;
+      }).adjacency();
+  }
+
+  // Counts the solutions for cells, blocking each in turn
+  int countSolutions(Solver& solver, const vector<Cardinal>& cells) {
+    int result = 0;
+    while ( solver.solve() ) {
+      result++;
+      Clause block;
+      for ( const Cardinal& cell : cells ) {
+	block |= cell != cell.modelValue();
+      }
+      solver.require(block);
+    }
+    return result;
+  }
+}
+
+void AutomorphismsTest::testGroupSizes(void) {
+  CPPUNIT_ASSERT_EQUAL(6.0, Automorphisms(Graph::complete(3).adjacency()).size());
+  CPPUNIT_ASSERT_EQUAL(24.0, Automorphisms(Graph::complete(4).adjacency()).size());
+  CPPUNIT_ASSERT_EQUAL(10.0, Automorphisms(cycle(5)).size());
+  CPPUNIT_ASSERT_EQUAL(16.0, Automorphisms(cycle(8)).size());
+  CPPUNIT_ASSERT_EQUAL(120.0, Automorphisms(petersen()).size());
+
+  // Two disjoint edges: swap within each, and swap the edges.
+  Adjacency matching = Graph(4, [] (int src, int dst) { return (src ^ 1) == dst; }).adjacency();
+  CPPUNIT_ASSERT_EQUAL(8.0, Automorphisms(matching).size());
+
+  // The directed 3-cycle only rotates.
+  Adjacency directed = Graph(3, [] (int src, int dst) { return (src+1) % 3 == dst; }).adjacency();
+  CPPUNIT_ASSERT_EQUAL(3.0, Automorphisms(directed).size());
+
+  // A tree with branches of lengths 1, 2 and 3 at vertex 1 has none.
+  Adjacency rigid = Graph(7, [] (int src, int dst) {
+      if ( src > dst ) swap(src, dst);
+      return (dst == src+1 && dst < 5) || (src == 1 && dst == 5) || (src == 5 && dst == 6);
+    }).adjacency();
+  Automorphisms none(rigid);
+  CPPUNIT_ASSERT_EQUAL(1.0, none.size());
+  CPPUNIT_ASSERT(none.generators().empty());
+}
+
+void AutomorphismsTest::testColors(void) {
+  // Fixing the color of vertex 2 of K_3 leaves only the swap of 0 and 1.
+  Automorphisms swaps(Graph::complete(3).adjacency(), {0, 0, 1});
+  CPPUNIT_ASSERT_EQUAL(2.0, swaps.size());
+  CPPUNIT_ASSERT(swaps.orbits() == vector<int>({0, 0, 2}));
+  CPPUNIT_ASSERT_EQUAL(1u, (unsigned int)swaps.generators().size());
+  CPPUNIT_ASSERT(swaps.generators()[0] == Permutation({1, 0, 2}));
+
+  CPPUNIT_ASSERT_THROW(Automorphisms(Graph::complete(3).adjacency(), {0, 0}), invalid_argument);
+}
+
+void AutomorphismsTest::testGenerators(void) {
+  Adjacency graph = petersen();
+  Automorphisms automorphisms(graph);
+  for ( const Permutation& generator : automorphisms.generators() ) {
+    CPPUNIT_ASSERT(Automorphisms::isAutomorphism(graph, generator));
+  }
+  // Vertex-transitive
+  CPPUNIT_ASSERT(automorphisms.orbits() == vector<int>(10, 0));
+
+  CPPUNIT_ASSERT(Automorphisms::isAutomorphism(cycle(5), {1, 2, 3, 4, 0}));
+  CPPUNIT_ASSERT(!Automorphisms::isAutomorphism(cycle(5), {1, 0, 2, 3, 4}));
+  CPPUNIT_ASSERT(!Automorphisms::isAutomorphism(cycle(5), {0, 0, 2, 3, 4}));
+  CPPUNIT_ASSERT(!Automorphisms::isAutomorphism(cycle(5), {0, 1, 2}));
+}
+
+void AutomorphismsTest::testLexLeader(void) {
+  MinisatSolver solver;
+  vector<Cardinal> cells = { Cardinal(&solver, 0, 3), Cardinal(&solver, 0, 3) };
+  solver.require(lexLeader(&solver, cells, {1, 0, 2}));
+
+  // (x, y) <= (s(x), s(y)) with s swapping 0 and 1
+  ASSERT_SAT_ASSUMP(solver, cells[0] == 0);
+  ASSERT_UNSAT_ASSUMP(solver, cells[0] == 1, cells[0]);
+  ASSERT_SAT_ASSUMP(solver, cells[0] == 2 & cells[1] == 0);
+  ASSERT_UNSAT_ASSUMP(solver, cells[0] == 2 & cells[1] == 1, cells[0]);
+  ASSERT_SAT_ASSUMP(solver, cells[0] == 2 & cells[1] == 2);
+}
+
+void AutomorphismsTest::testSymmetryBreaking(void) {
+  // Proper 3-colorings of a path on 4 vertices: 3 * 2 * 2 * 2 of them,
+  // in 4 families under the 6 permutations of the colors.
+  Graph path(4, [] (int src, int dst) { return src - dst == 1 || dst - src == 1; });
+  Adjacency triangle = Graph::complete(3).adjacency();
+
+  MinisatSolver plain;
+  vector<Cardinal> plainCells;
+  for ( int vertex = 0; vertex < 4; vertex++ ) plainCells.push_back(Cardinal(&plain, 0, 3));
+  plain.require(GraphHomomorphism(triangle).graph(path, plainCells));
+  CPPUNIT_ASSERT_EQUAL(24, countSolutions(plain, plainCells));
+
+  MinisatSolver broken;
+  vector<Cardinal> cells;
+  for ( int vertex = 0; vertex < 4; vertex++ ) cells.push_back(Cardinal(&broken, 0, 3));
+  broken.require(GraphHomomorphism(triangle).graph(path, cells));
+  broken.require(valueSymmetryBreaking(&broken, cells, Automorphisms(triangle)));
+  int remaining = countSolutions(broken, cells);
+  CPPUNIT_ASSERT(remaining >= 4);
+  CPPUNIT_ASSERT(remaining < 24);
+}
@@ -0,0 +1,126 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/cardinal.h"
+#include "../src/clausebuffer.h"
+
+using namespace std;
+
+class ClauseBufferTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(ClauseBufferTest);
+  CPPUNIT_TEST(testPack);
+  CPPUNIT_TEST(testRoundTrip);
+  CPPUNIT_TEST(testTruthAndFalsity);
+  CPPUNIT_TEST(testRequire);
+  CPPUNIT_TEST(testSolve);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testPack(void);
+  void testRoundTrip(void);
+  void testTruthAndFalsity(void);
+  void testRequire(void);
+  void testSolve(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ClauseBufferTest );
+
+void ClauseBufferTest::testPack(void) {
+  for ( unsigned int var = 0; var < 5; var++ ) {
+    CPPUNIT_ASSERT_EQUAL((int)var+1, ClauseBuffer::pack(Literal(var)));
+    CPPUNIT_ASSERT_EQUAL(-(int)var-1, ClauseBuffer::pack(~Literal(var)));
+    CPPUNIT_ASSERT_EQUAL(Literal(var), ClauseBuffer::unpack(ClauseBuffer::pack(Literal(var))));
+    CPPUNIT_ASSERT_EQUAL(~Literal(var), ClauseBuffer::unpack(ClauseBuffer::pack(~Literal(var))));
+  }
+}
+
+void ClauseBufferTest::testRoundTrip(void) {
+  MockSolver solver;
+  Cardinal card(&solver, 0, 4);
+  Requirement req = card.typeRequirement();
+  req &= (card == 1) | (card == 3);
+
+  ClauseBuffer buffer;
+  CPPUNIT_ASSERT(buffer.empty());
+  buffer &= req;
+  CPPUNIT_ASSERT_EQUAL((unsigned int)req.size(), buffer.numClauses());
+  CPPUNIT_ASSERT_EQUAL(req, buffer.toRequirement());
+
+  // Clauses come back in order.
+  vector<int> sizes;
+  buffer.forEachClause([&] (const int* lits, int size) { sizes.push_back(size); });
+  vector<int> expected;
+  for ( const Clause& clause : req ) {
+    expected.push_back(clause.size());
+  }
+  CPPUNIT_ASSERT(expected == sizes);
+
+  buffer.clear();
+  CPPUNIT_ASSERT(buffer.empty());
+  CPPUNIT_ASSERT_EQUAL(Requirement(), buffer.toRequirement());
+}
+
+void ClauseBufferTest::testTruthAndFalsity(void) {
+  ClauseBuffer buffer;
+  buffer.add(Clause::truth);
+  CPPUNIT_ASSERT(buffer.empty());
+
+  buffer.add(Clause());
+  CPPUNIT_ASSERT_EQUAL(1u, buffer.numClauses());
+  CPPUNIT_ASSERT_EQUAL(Requirement(Clause()), buffer.toRequirement());
+}
+
+void ClauseBufferTest::testRequire(void) {
+  MockSolver solver;
+  Cardinal card(&solver, 0, 4);
+
+  ClauseBuffer buffer;
+  buffer &= card.typeRequirement();
+  solver.require(buffer);
+  CPPUNIT_ASSERT_EQUAL(card.typeRequirement(), solver.getRequirements());
+}
+
+void ClauseBufferTest::testSolve(void) {
+  MinisatSolver solver;
+  Cardinal card(&solver, 0, 4);
+
+  ClauseBuffer buffer;
+  buffer &= card.typeRequirement();
+  buffer &= Clause(card == 2);
+  solver.require(buffer);
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(2, card.modelValue());
+
+  ClauseBuffer falsity;
+  falsity &= Clause();
+  solver.require(falsity);
+  ASSERT_UNSAT(solver, card);
+}
@@ -153,6 +153,10 @@ void ClauseTest::testDisjoinTrueFalseClause(void) {
   CPPUNIT_ASSERT_EQUAL(clause,        clause | Clause::falsity);
   CPPUNIT_ASSERT_EQUAL(clause,        clause | Atom::falsity);
 
+  CPPUNIT_ASSERT(Clause::truth.isTruth());
+  CPPUNIT_ASSERT((clause | Clause::truth).isTruth());
+  CPPUNIT_ASSERT(!clause.isTruth());
+  CPPUNIT_ASSERT(!Clause::falsity.isTruth());
 }
 
 void ClauseTest::testOutputLitPositive(void) {
@@ -0,0 +1,131 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/ordinal.h"
+#include "../src/matrix.h"
+#include "../src/compactmatrix.h"
+#include "../src/pairindexedscalar.h"
+
+using namespace std;
+
+class CompactMatrixTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(CompactMatrixTest);
+  CPPUNIT_TEST(testSameAsMatrix);
+  CPPUNIT_TEST(testOrdinalCells);
+  CPPUNIT_TEST(testPairIndexed);
+  CPPUNIT_TEST(testSolutions);
+  CPPUNIT_TEST(testOutOfRange);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testSameAsMatrix(void);
+  void testOrdinalCells(void);
+  void testPairIndexed(void);
+  void testSolutions(void);
+  void testOutOfRange(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( CompactMatrixTest );
+
+void CompactMatrixTest::testSameAsMatrix(void) {
+  MockSolver compactSolver;
+  MockSolver fullSolver;
+  CompactMatrix<> compact(&compactSolver, 3, 4, 1, 4);
+  Matrix<> full(&fullSolver, 3, 4, 1, 4);
+
+  // Same literals, in the same places, with the same requirements.
+  CPPUNIT_ASSERT_EQUAL(full.numLiterals(), compact.numLiterals());
+  CPPUNIT_ASSERT_EQUAL(fullSolver.newVars(0), compactSolver.newVars(0));
+  CPPUNIT_ASSERT_EQUAL(full.typeRequirement(), compact.typeRequirement());
+  for ( int row = 0; row < 3; row++ ) {
+    for ( int col = 0; col < 4; col++ ) {
+      for ( int value = 1; value < 4; value++ ) {
+	CPPUNIT_ASSERT_EQUAL(full[row][col] == value, compact[row][col] == value);
+      }
+    }
+  }
+}
+
+void CompactMatrixTest::testOrdinalCells(void) {
+  MockSolver compactSolver;
+  MockSolver fullSolver;
+  CompactMatrix<Ordinal> compact(&compactSolver, 2, 3, 0, 5);
+  Matrix<Ordinal> full(&fullSolver, 2, 3, 0, 5);
+
+  CPPUNIT_ASSERT_EQUAL(full.typeRequirement(), compact.typeRequirement());
+  CPPUNIT_ASSERT_EQUAL(full[1][2] <= 3, compact.at(1, 2) <= 3);
+}
+
+void CompactMatrixTest::testPairIndexed(void) {
+  MinisatSolver solver;
+  CompactMatrix<> matrix(&solver, 3, 3, 0, 3);
+  Cardinal row(&solver, 0, 3);
+  Cardinal col(&solver, 0, 3);
+
+  // Only the diagonal may be 2, and the indexed cell must be 2.
+  for ( int i = 0; i < 3; i++ ) {
+    for ( int j = 0; j < 3; j++ ) {
+      if ( i != j ) {
+	solver.require(matrix[i][j] != 2);
+      }
+    }
+  }
+  Requirement indexed = matrix[row][col] == 2;
+  solver.require(indexed);
+
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(row.modelValue(), col.modelValue());
+  CPPUNIT_ASSERT_EQUAL(2, matrix[row.modelValue()][col.modelValue()].modelValue());
+  ASSERT_UNSAT_ASSUMP(solver, (row == 0) & (col == 1), indexed);
+}
+
+void CompactMatrixTest::testSolutions(void) {
+  MinisatSolver solver;
+  CompactMatrix<> matrix(&solver, 1, 2, 0, 2);
+
+  int numSolutions = 0;
+  while ( solver.solve() ) {
+    numSolutions++;
+    solver.require(matrix.diffSolnReq());
+  }
+  CPPUNIT_ASSERT_EQUAL(4, numSolutions);
+}
+
+void CompactMatrixTest::testOutOfRange(void) {
+  MockSolver solver;
+  CompactMatrix<> matrix(&solver, 4, 3, 0, 3);
+
+  CPPUNIT_ASSERT_THROW(matrix[-1][0], out_of_range);
+  CPPUNIT_ASSERT_THROW(matrix[0][-1], out_of_range);
+  CPPUNIT_ASSERT_THROW(matrix[4][0], out_of_range);
+  CPPUNIT_ASSERT_THROW(matrix.at(0, 3), out_of_range);
+  CPPUNIT_ASSERT_THROW(CompactMatrix<>(&solver, -1, 3, 0, 3), invalid_argument);
+}
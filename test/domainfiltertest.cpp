@@ -0,0 +1,215 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Unit tests for DomainFilter.
+
+#include <stdexcept>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/sparsecardinal.h"
+#include "../src/graphs.h"
+#include "../src/graphhomomorphism.h"
+#include "../src/domainfilter.h"
+
+using namespace std;
+
+class DomainFilterTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(DomainFilterTest);
+  CPPUNIT_TEST(testRestrictions);
+  CPPUNIT_TEST(testPath);
+  CPPUNIT_TEST(testUnsatisfiable);
+  CPPUNIT_TEST(testDirected);
+  CPPUNIT_TEST(testTwoRelations);
+  CPPUNIT_TEST(testWideDomains);
+  CPPUNIT_TEST(testSolutionsKept);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testRestrictions(void);
+  void testPath(void);
+  void testUnsatisfiable(void);
+  void testDirected(void);
+  void testTwoRelations(void);
+  void testWideDomains(void);
+  void testSolutionsKept(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( DomainFilterTest );
+
+namespace {
+  // The path 0 - 1 - ... - order-1
+  Adjacency path(int order) {
+    return Graph(order, [] (int src, int dst) {
+	return src == dst+1 || dst == src+1;
+      }).adjacency();
+  }
+}
+
+void DomainFilterTest::testRestrictions(void) {
+  DomainFilter filter(3, 5);
+  CPPUNIT_ASSERT(filter.domain(0) == vector<int>({0, 1, 2, 3, 4}));
+
+  filter.restrict(0, {1, 3, 4, 7});
+  filter.bound(0, 2, 10);
+  CPPUNIT_ASSERT(filter.domain(0) == vector<int>({3, 4}));
+  filter.fix(1, 2);
+  CPPUNIT_ASSERT(filter.domain(1) == vector<int>({2}));
+  filter.remove(2, 0);
+  CPPUNIT_ASSERT_EQUAL(4, filter.domainSize(2));
+  CPPUNIT_ASSERT(!filter.contains(2, 0));
+  CPPUNIT_ASSERT(!filter.contains(2, 5));
+  CPPUNIT_ASSERT_EQUAL(8ul, filter.numRemoved());
+
+  CPPUNIT_ASSERT_THROW(filter.domain(3), out_of_range);
+  CPPUNIT_ASSERT_THROW(filter.relate(0, 1, 0), out_of_range);
+  CPPUNIT_ASSERT_THROW(filter.addRelation(path(4)), invalid_argument);
+  CPPUNIT_ASSERT_THROW(DomainFilter(-1, 2), invalid_argument);
+}
+
+void DomainFilterTest::testPath(void) {
+  // Three cells in a row, mapped onto the path 0 - 1 - 2 - 3 - 4.
+  // Fixing the first cell to 0 leaves the middle one only 1, and the
+  // last one 0 or 2.
+  DomainFilter filter(3, 5);
+  const int adjacent = filter.addRelation(path(5));
+  filter.relate(0, 1, adjacent);
+  filter.relate(1, 2, adjacent);
+  filter.fix(0, 0);
+  CPPUNIT_ASSERT(filter.propagate());
+  CPPUNIT_ASSERT(filter.domain(0) == vector<int>({0}));
+  CPPUNIT_ASSERT(filter.domain(1) == vector<int>({1}));
+  CPPUNIT_ASSERT(filter.domain(2) == vector<int>({0, 2}));
+
+  // Bounding the last cell to 1..4 then leaves it only 2.
+  filter.bound(2, 1, 4);
+  CPPUNIT_ASSERT(filter.propagate());
+  CPPUNIT_ASSERT(filter.domain(2) == vector<int>({2}));
+}
+
+void DomainFilterTest::testUnsatisfiable(void) {
+  // A triangle has no homomorphism to an edge.  Every arc on its own
+  // is consistent, so it takes a fixed cell to expose that.
+  DomainFilter filter(3, 2);
+  const int adjacent = filter.addRelation(path(2));
+  filter.relate(0, 1, adjacent);
+  filter.relate(1, 2, adjacent);
+  filter.relate(2, 0, adjacent);
+  filter.fix(0, 0);
+  CPPUNIT_ASSERT(!filter.propagate());
+
+  // A cell with no values at all is reported too.
+  DomainFilter empty(2, 3);
+  empty.restrict(1, {});
+  CPPUNIT_ASSERT(!empty.propagate());
+}
+
+void DomainFilterTest::testDirected(void) {
+  // The arc 0 -> 1 only: lhs must be 0 and rhs 1.
+  DomainFilter filter(2, 3);
+  const int arc = filter.addRelation(Graph(3, [] (int src, int dst) {
+	return src == 0 && dst == 1;
+      }).adjacency());
+  filter.relate(0, 1, arc);
+  CPPUNIT_ASSERT(filter.propagate());
+  CPPUNIT_ASSERT(filter.domain(0) == vector<int>({0}));
+  CPPUNIT_ASSERT(filter.domain(1) == vector<int>({1}));
+}
+
+void DomainFilterTest::testTwoRelations(void) {
+  // Two constraints on the same pair: x == y, and x -> y only from 0.
+  // The second removes x = 1, and then the first must remove y = 1.
+  DomainFilter filter(2, 2);
+  const int equal = filter.addRelation(Graph(2, [] (int src, int dst) {
+	return src == dst;
+      }).adjacency());
+  const int fromZero = filter.addRelation(Graph(2, [] (int src, int dst) {
+	return src == 0;
+      }).adjacency());
+  filter.relate(0, 1, equal);
+  filter.relate(0, 1, fromZero);
+  CPPUNIT_ASSERT(filter.propagate());
+  CPPUNIT_ASSERT(filter.domain(0) == vector<int>({0}));
+  CPPUNIT_ASSERT(filter.domain(1) == vector<int>({0}));
+}
+
+void DomainFilterTest::testWideDomains(void) {
+  // Domains of more than one word: along a path of 200 values, a chain
+  // of cells starting at 199 keeps to the top of the range.
+  DomainFilter filter(4, 200);
+  const int adjacent = filter.addRelation(path(200));
+  for ( int cell = 0; cell < 3; cell++ ) {
+    filter.relate(cell, cell+1, adjacent);
+  }
+  filter.fix(0, 199);
+  filter.bound(3, 0, 197);
+  CPPUNIT_ASSERT(filter.propagate());
+  CPPUNIT_ASSERT(filter.domain(1) == vector<int>({198}));
+  CPPUNIT_ASSERT(filter.domain(2) == vector<int>({197}));
+  CPPUNIT_ASSERT(filter.domain(3) == vector<int>({196}));
+  CPPUNIT_ASSERT_EQUAL(4ul*200 - 4, filter.numRemoved());
+}
+
+void DomainFilterTest::testSolutionsKept(void) {
+  // A 2 x 3 grid onto the 5-cycle with one corner fixed: every value
+  // the filter keeps appears in some homomorphism, and every value it
+  // removes appears in none.
+  const Graph cycle(5, [] (int src, int dst) {
+      return (src+1) % 5 == dst || (dst+1) % 5 == src;
+    });
+  GraphHomomorphism homomorphism(cycle);
+  DomainFilter filter(6, 5);
+  const int adjacent = filter.addRelation(homomorphism.neighborMatrix());
+  for ( int row = 0; row < 2; row++ ) {
+    for ( int col = 0; col < 3; col++ ) {
+      if ( col < 2 ) filter.relate(3*row + col, 3*row + col+1, adjacent);
+      if ( row < 1 ) filter.relate(3*row + col, 3*(row+1) + col, adjacent);
+    }
+  }
+  filter.fix(0, 0);
+  filter.fix(5, 2);
+  CPPUNIT_ASSERT(filter.propagate());
+
+  MinisatSolver solver;
+  vector<SparseCardinal> cells;
+  for ( int cell = 0; cell < 6; cell++ ) {
+    cells.push_back(SparseCardinal(&solver, vector<int>({0, 1, 2, 3, 4})));
+  }
+  auto cellAt = [&] (int row, int col) { return cells[3*row + col]; };
+  solver.require(homomorphism.grid(cellAt, 2, 3));
+  solver.require(cells[0] == 0);
+  solver.require(cells[5] == 2);
+  ASSERT_SAT(solver);
+
+  for ( int cell = 0; cell < 6; cell++ ) {
+    for ( int value = 0; value < 5; value++ ) {
+      if ( filter.contains(cell, value) ) {
+	ASSERT_SAT_ASSUMP(solver, cells[cell] == value);
+      } else {
+	ASSERT_UNSAT_ASSUMP(solver, cells[cell] == value, cells[cell]);
+      }
+    }
+  }
+}
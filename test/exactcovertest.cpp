@@ -0,0 +1,135 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Unit tests for ExactCover.
+
+#include <stdexcept>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "../src/exactcover.h"
+
+using namespace std;
+
+class ExactCoverTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(ExactCoverTest);
+  CPPUNIT_TEST(testKnuth);
+  CPPUNIT_TEST(testQueens);
+  CPPUNIT_TEST(testParallel);
+  CPPUNIT_TEST(testStop);
+  CPPUNIT_TEST(testEdgeCases);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testKnuth(void);
+  void testQueens(void);
+  void testParallel(void);
+  void testStop(void);
+  void testEdgeCases(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ExactCoverTest );
+
+namespace {
+  // n queens: ranks and files are primary columns, the diagonals
+  // secondary, and each square is a row.
+  ExactCover queens(int n) {
+    ExactCover problem(2*n, 2*(2*n-1));
+    for ( int rank = 0; rank < n; rank++ ) {
+      for ( int file = 0; file < n; file++ ) {
+	problem.addRow({ rank, n + file, 2*n + rank + file, 2*n + (2*n-1) + rank - file + n-1 });
+      }
+    }
+    return problem;
+  }
+}
+
+void ExactCoverTest::testKnuth(void) {
+  // The example from "Dancing Links": columns A-G, one solution.
+  ExactCover problem(7);
+  problem.addRow({2, 4, 5});
+  problem.addRow({0, 3, 6});
+  problem.addRow({1, 2, 5});
+  problem.addRow({0, 3});
+  problem.addRow({1, 6});
+  problem.addRow({3, 4, 6});
+  CPPUNIT_ASSERT_EQUAL(6, problem.numRows());
+  CPPUNIT_ASSERT_EQUAL(7, problem.numColumns());
+
+  vector<vector<int> > found = problem.solutions();
+  CPPUNIT_ASSERT_EQUAL(1, (int)found.size());
+  CPPUNIT_ASSERT(found[0] == vector<int>({0, 3, 4}));
+  CPPUNIT_ASSERT_EQUAL(1ul, problem.count());
+}
+
+void ExactCoverTest::testQueens(void) {
+  CPPUNIT_ASSERT_EQUAL(2ul, queens(4).count());
+  CPPUNIT_ASSERT_EQUAL(92ul, queens(8).count());
+  CPPUNIT_ASSERT_EQUAL(0ul, queens(3).count());
+
+  vector<vector<int> > found = queens(4).solutions();
+  CPPUNIT_ASSERT(found[0] == vector<int>({1, 7, 8, 14}) || found[0] == vector<int>({2, 4, 11, 13}));
+}
+
+void ExactCoverTest::testParallel(void) {
+  // Any number of threads gives the same solutions in the same order.
+  ExactCover problem = queens(8);
+  vector<vector<int> > sequential = problem.solutions();
+  CPPUNIT_ASSERT_EQUAL(92, (int)sequential.size());
+  for ( unsigned int numThreads : {2u, 3u, 8u, 0u} ) {
+    CPPUNIT_ASSERT(problem.solutions(numThreads) == sequential);
+    CPPUNIT_ASSERT_EQUAL(92ul, problem.count(numThreads));
+  }
+
+  vector<vector<int> > visited;
+  problem.solve([&] (const vector<int>& rows) { visited.push_back(rows); return true; });
+  CPPUNIT_ASSERT(visited == sequential);
+}
+
+void ExactCoverTest::testStop(void) {
+  int numVisited = 0;
+  unsigned long result = queens(8).solve([&] (const vector<int>& rows) {
+      CPPUNIT_ASSERT_EQUAL(8, (int)rows.size());
+      return ++numVisited < 5;
+    });
+  CPPUNIT_ASSERT_EQUAL(5, numVisited);
+  CPPUNIT_ASSERT_EQUAL(5ul, result);
+}
+
+void ExactCoverTest::testEdgeCases(void) {
+  // Nothing to cover: the empty set of rows is the one solution.
+  ExactCover empty(0, 2);
+  empty.addRow({0, 1});
+  CPPUNIT_ASSERT(empty.solutions() == vector<vector<int> >(1));
+  CPPUNIT_ASSERT_EQUAL(1ul, empty.count(4));
+
+  // A primary column no row covers
+  ExactCover uncoverable(2);
+  uncoverable.addRow({0});
+  CPPUNIT_ASSERT_EQUAL(0ul, uncoverable.count(4));
+  CPPUNIT_ASSERT(uncoverable.solutions(4).empty());
+
+  CPPUNIT_ASSERT_THROW(uncoverable.addRow({2}), out_of_range);
+  CPPUNIT_ASSERT_THROW(uncoverable.addRow({0, 0}), invalid_argument);
+  CPPUNIT_ASSERT_THROW(ExactCover(-1), invalid_argument);
+}
@@ -0,0 +1,199 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/cardinal.h"
+#include "../src/ordinal.h"
+#include "../src/sparsecardinal.h"
+#include "../src/matrix.h"
+#include "../src/compactmatrix.h"
+#include "../src/windowrule.h"
+#include "../src/graphhomomorphism.h"
+
+using namespace std;
+
+class GraphHomomorphismTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(GraphHomomorphismTest);
+  CPPUNIT_TEST(testNeighborLists);
+  CPPUNIT_TEST(testGridClauses);
+  CPPUNIT_TEST(testArc);
+  CPPUNIT_TEST(testGridColoring);
+  CPPUNIT_TEST(testSourceGraph);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testNeighborLists(void);
+  void testGridClauses(void);
+  void testArc(void);
+  void testGridColoring(void);
+  void testSourceGraph(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GraphHomomorphismTest );
+
+namespace {
+  // 0 -> 1 -> 2 -> 0, plus 1 -> 0
+  Graph directedTriangle() {
+    return Graph(3, [] (int src, int dst) {
+	return dst == (src+1) % 3 || (src == 1 && dst == 0);
+      });
+  }
+}
+
+void GraphHomomorphismTest::testNeighborLists(void) {
+  GraphHomomorphism homomorphism(directedTriangle());
+
+  CPPUNIT_ASSERT_EQUAL(3, homomorphism.order());
+  CPPUNIT_ASSERT(homomorphism.successors(1) == vector<int>({0, 2}));
+  CPPUNIT_ASSERT(homomorphism.predecessors(0) == vector<int>({1, 2}));
+  CPPUNIT_ASSERT(homomorphism.neighbors(0) == vector<int>({1}));
+  CPPUNIT_ASSERT(homomorphism.neighbors(2) == vector<int>());
+  CPPUNIT_ASSERT_THROW(homomorphism.neighbors(3), out_of_range);
+
+  // From a stored adjacency, the lists are the same.
+  GraphHomomorphism stored(directedTriangle().adjacency());
+  for ( int c = 0; c < 3; c++ ) {
+    CPPUNIT_ASSERT(stored.successors(c) == homomorphism.successors(c));
+    CPPUNIT_ASSERT(stored.predecessors(c) == homomorphism.predecessors(c));
+  }
+}
+
+void GraphHomomorphismTest::testGridClauses(void) {
+  // Into K_3, the support clauses are those of the "differ" window rules.
+  MockSolver solver;
+  Matrix<> matrix(&solver, 3, 4, 0, 3);
+  GraphHomomorphism homomorphism(Graph::complete(3));
+
+  vector<int> values = {0, 1, 2};
+  auto differ = [] (int lhs, int rhs) { return lhs != rhs; };
+  Requirement expected = WindowRule::horizontal(values, differ).stamp(matrix);
+  expected &= WindowRule::vertical(values, differ).stamp(matrix);
+  CPPUNIT_ASSERT_EQUAL(expected, homomorphism.grid(matrix));
+
+  Requirement byRows;
+  for ( int row = 0; row < 3; row++ ) {
+    byRows &= homomorphism.horizontalEdges([&] (int i, int j) { return matrix[i][j]; }, row, 4);
+    if ( row < 2 ) {
+      byRows &= homomorphism.verticalEdges([&] (int i, int j) { return matrix[i][j]; }, row, 4);
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL(expected, byRows);
+}
+
+void GraphHomomorphismTest::testArc(void) {
+  MinisatSolver solver;
+  Cardinal src(&solver, 0, 3);
+  Cardinal dst(&solver, 0, 3);
+  GraphHomomorphism homomorphism(directedTriangle());
+  solver.require(homomorphism.arc(src, dst));
+
+  ASSERT_SAT_ASSUMP(solver, src == 1 & dst == 0);
+  ASSERT_SAT_ASSUMP(solver, src == 2 & dst == 0);
+  ASSERT_UNSAT_ASSUMP(solver, src == 0 & dst == 2, src);
+  ASSERT_UNSAT_ASSUMP(solver, src == 0 & dst == 0, src);
+
+  // An undirected edge needs arcs both ways, and only 0 -- 1 has them.
+  Cardinal lhs(&solver, 0, 3);
+  Cardinal rhs(&solver, 0, 3);
+  solver.require(homomorphism.edge(lhs, rhs));
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(1, lhs.modelValue() + rhs.modelValue());
+  ASSERT_UNSAT_ASSUMP(solver, lhs == 2, lhs);
+}
+
+void GraphHomomorphismTest::testGridColoring(void) {
+  // A grid is bipartite: it maps onto an edge, but not onto a single
+  // vertex without a loop.
+  MinisatSolver solver;
+  CompactMatrix<Ordinal> morphism(&solver, 3, 5, 0, 3);
+  Graph path(3, [] (int src, int dst) { return src - dst == 1 || dst - src == 1; });
+  solver.require(GraphHomomorphism(path).grid(morphism));
+
+  ASSERT_SAT(solver);
+  for ( int row = 0; row < 3; row++ ) {
+    for ( int col = 0; col < 5; col++ ) {
+      int value = morphism[row][col].modelValue();
+      if ( col+1 < 5 ) {
+	CPPUNIT_ASSERT(path.hasEdge(value, morphism[row][col+1].modelValue()));
+      }
+      if ( row+1 < 3 ) {
+	CPPUNIT_ASSERT(path.hasEdge(value, morphism[row+1][col].modelValue()));
+      }
+    }
+  }
+  DualClause sameColor = (morphism[0][0] == 1) & (morphism[0][1] == 1);
+  ASSERT_UNSAT_ASSUMP(solver, sameColor, morphism);
+
+  // Sparse domains: a cell restricted to {0, 2} forces its neighbors to 1.
+  Matrix<SparseCardinal> sparse(&solver, 1, 3, [] (int row, int col) {
+      return col == 1 ? vector<int>({0, 2}) : vector<int>({1, 2});
+    });
+  solver.require(GraphHomomorphism(path).grid(sparse));
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(1, sparse[0][0].modelValue());
+  CPPUNIT_ASSERT_EQUAL(1, sparse[0][2].modelValue());
+}
+
+void GraphHomomorphismTest::testSourceGraph(void) {
+  MinisatSolver solver;
+  vector<Cardinal> triangle;
+  for ( int vertex = 0; vertex < 3; vertex++ ) {
+    triangle.push_back(Cardinal(&solver, 0, 3));
+  }
+
+  // K_3 maps into K_3 only by a permutation.
+  solver.require(GraphHomomorphism(Graph::complete(3)).graph(Graph::complete(3), triangle));
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(3, triangle[0].modelValue() + triangle[1].modelValue() + triangle[2].modelValue());
+  CPPUNIT_ASSERT(triangle[0].modelValue() != triangle[1].modelValue());
+
+  // ... and not into the directed triangle, which has a single mutual pair.
+  MinisatSolver other;
+  vector<Cardinal> vertices;
+  for ( int vertex = 0; vertex < 3; vertex++ ) {
+    vertices.push_back(Cardinal(&other, 0, 3));
+  }
+  other.require(GraphHomomorphism(directedTriangle()).graph(Graph::complete(3), vertices));
+  ASSERT_UNSAT(other, vertices[0]);
+
+  // The directed triangle maps to itself.
+  MinisatSolver self;
+  vector<Cardinal> image;
+  for ( int vertex = 0; vertex < 3; vertex++ ) {
+    image.push_back(Cardinal(&self, 0, 3));
+  }
+  self.require(GraphHomomorphism(directedTriangle()).graph(directedTriangle(), image));
+  self.require(image[0] == 0);
+  ASSERT_SAT(self);
+  CPPUNIT_ASSERT_EQUAL(1, image[1].modelValue());
+  CPPUNIT_ASSERT_EQUAL(2, image[2].modelValue());
+  CPPUNIT_ASSERT_THROW(GraphHomomorphism(directedTriangle()).graph(Graph::complete(2), image), 
+		       invalid_argument);
+}
@@ -0,0 +1,186 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "../src/graphml.h"
+
+using namespace std;
+
+class GraphMLTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(GraphMLTest);
+  CPPUNIT_TEST(testTriangle);
+  CPPUNIT_TEST(testEquivalences);
+  CPPUNIT_TEST(testNaturalOrder);
+  CPPUNIT_TEST(testXmlSyntax);
+  CPPUNIT_TEST(testOutput);
+  CPPUNIT_TEST(testErrors);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testTriangle(void);
+  void testEquivalences(void);
+  void testNaturalOrder(void);
+  void testXmlSyntax(void);
+  void testOutput(void);
+  void testErrors(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GraphMLTest );
+
+namespace {
+  const string header = 
+    "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>\n"
+    "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\" "
+    "xmlns:y=\"http://www.yworks.com/xml/graphml\">\n"
+    "  <key attr.name=\"Equivalence\" attr.type=\"int\" for=\"node\" id=\"d4\">\n"
+    "    <default>-1</default>\n"
+    "  </key>\n"
+    "  <key for=\"node\" id=\"d7\" yfiles.type=\"nodegraphics\"/>\n"
+    "  <graph edgedefault=\"directed\" id=\"G\">\n";
+  const string footer = "  </graph>\n</graphml>\n";
+
+  string node(const string& id, const string& color, const string& eq = "") {
+    string result = "    <node id=\"" + id + "\">\n";
+    if ( !eq.empty() ) {
+      result += "      <data key=\"d4\">" + eq + "</data>\n";
+    }
+    result += "      <data key=\"d7\"><y:ShapeNode><y:Fill color=\"#" + color + 
+      "\" transparent=\"false\"/></y:ShapeNode></data>\n"
+      "    </node>\n";
+    return result;
+  }
+
+  string edge(const string& source, const string& target) {
+    return "    <edge id=\"e\" source=\"" + source + "\" target=\"" + target + "\"/>\n";
+  }
+
+  GraphML parse(const string& text) {
+    istringstream in(text);
+    return GraphML(in);
+  }
+}
+
+void GraphMLTest::testTriangle(void) {
+  GraphML graph = parse(header + 
+			node("n0", "C00000") + node("n1", "00C000") + node("n2", "0000C0") + 
+			edge("n0", "n1") + edge("n1", "n2") + edge("n2", "n0") + 
+			footer);
+
+  CPPUNIT_ASSERT_EQUAL(3u, graph.order());
+  for ( int src = 0; src < 3; src++ ) {
+    for ( int dst = 0; dst < 3; dst++ ) {
+      CPPUNIT_ASSERT_EQUAL(src != dst, graph.adjacent(src, dst));
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL(1, graph.indexOf("n1"));
+  CPPUNIT_ASSERT_EQUAL(string("0x00C000"), graph.palette().at(1));
+}
+
+void GraphMLTest::testEquivalences(void) {
+  // n0 and n2 are one vertex; n1 and n3 keep their own.
+  GraphML graph = parse(header + 
+			node("n0", "C00000", "5") + node("n1", "00C000") + 
+			node("n2", "C00000", "5") + node("n3", "0000C0", "-2") + 
+			edge("n0", "n1") + edge("n3", "n2") + 
+			footer);
+
+  // The shared class "5" sorts before the ids "n1" and "n3".
+  CPPUNIT_ASSERT_EQUAL(3u, graph.order());
+  CPPUNIT_ASSERT_EQUAL(0, graph.indexOf("n0"));
+  CPPUNIT_ASSERT_EQUAL(0, graph.indexOf("n2"));
+  CPPUNIT_ASSERT_EQUAL(1, graph.indexOf("n1"));
+  CPPUNIT_ASSERT_EQUAL(2, graph.indexOf("n3"));
+  CPPUNIT_ASSERT(graph.adjacent(0, 1));
+  CPPUNIT_ASSERT(graph.adjacent(2, 0));
+  CPPUNIT_ASSERT(!graph.adjacent(1, 2));
+  CPPUNIT_ASSERT(!graph.adjacent(0, 0));
+}
+
+void GraphMLTest::testNaturalOrder(void) {
+  GraphML graph = parse(header + 
+			node("n10", "000000") + node("n2", "000000") + node("a9", "000000") + 
+			node("x", "000000", "12") + node("y", "000000", "012") + node("z", "000000", "3") + 
+			footer);
+
+  // Numbers first, by value; then text, with embedded numbers by value
+  CPPUNIT_ASSERT_EQUAL(5u, graph.order());
+  CPPUNIT_ASSERT_EQUAL(0, graph.indexOf("z"));
+  CPPUNIT_ASSERT_EQUAL(1, graph.indexOf("x"));
+  CPPUNIT_ASSERT_EQUAL(1, graph.indexOf("y"));
+  CPPUNIT_ASSERT_EQUAL(2, graph.indexOf("a9"));
+  CPPUNIT_ASSERT_EQUAL(3, graph.indexOf("n2"));
+  CPPUNIT_ASSERT_EQUAL(4, graph.indexOf("n10"));
+}
+
+void GraphMLTest::testXmlSyntax(void) {
+  GraphML graph = parse("<?xml version='1.0'?>\n"
+			"<!DOCTYPE graphml>\n"
+			"<!-- <node id=\"commented\"/> -->\n"
+			"<graphml>\n"
+			"  <key attr.name='Equivalence' for='node' id='eq'><default><![CDATA[-1]]></default></key>\n"
+			"  <graph id='G'>\n"
+			"    <node id='a&amp;b'><data key='eq'> 4 </data></node>\n"
+			"    <node id=\"c&#62;d\" ><data key=\"eq\">4</data></node>\n"
+			"    <node id='e'/>\n"
+			"    <edge source='e' target='a&amp;b'/>\n"
+			"  </graph>\n"
+			"  <graph id='ignored'><node id='f'/></graph>\n"
+			"</graphml>\n");
+
+  CPPUNIT_ASSERT_EQUAL(2u, graph.order());
+  CPPUNIT_ASSERT_EQUAL(0, graph.indexOf("a&b"));
+  CPPUNIT_ASSERT_EQUAL(0, graph.indexOf("c>d"));
+  CPPUNIT_ASSERT_EQUAL(1, graph.indexOf("e"));
+  CPPUNIT_ASSERT(graph.adjacent(0, 1));
+  CPPUNIT_ASSERT_THROW(graph.indexOf("f"), runtime_error);
+  CPPUNIT_ASSERT(graph.palette().empty());
+}
+
+void GraphMLTest::testOutput(void) {
+  GraphML graph = parse(header + 
+			node("n0", "C00000") + node("n1", "00C000") + 
+			edge("n0", "n1") + edge("n1", "n1") + 
+			footer);
+
+  ostringstream matrix;
+  graph.writeMatrix(matrix);
+  CPPUNIT_ASSERT_EQUAL(string("2\n0 1 \n1 1 \n"), matrix.str());
+
+  ostringstream palette;
+  graph.writePalette(palette);
+  CPPUNIT_ASSERT_EQUAL(string("0 0xC00000\n1 0x00C000\n"), palette.str());
+}
+
+void GraphMLTest::testErrors(void) {
+  CPPUNIT_ASSERT_THROW(parse(header + node("n0", "000000")), runtime_error);
+  CPPUNIT_ASSERT_THROW(parse(header + "<node id='n0'></edge>" + footer), runtime_error);
+  CPPUNIT_ASSERT_THROW(parse(header + node("n0", "000000") + edge("n0", "n9") + footer), runtime_error);
+  CPPUNIT_ASSERT_THROW(parse(header + node("n0", "000000", "many") + footer), runtime_error);
+  CPPUNIT_ASSERT_THROW(parse(header + "<node/>" + footer), runtime_error);
+  CPPUNIT_ASSERT_THROW(parse(header + "<node id=n0/>" + footer), runtime_error);
+  CPPUNIT_ASSERT_THROW(parse(header + "<node id='&bogus;'/>" + footer), runtime_error);
+}
@@ -0,0 +1,158 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "../src/graphs.h"
+
+using namespace std;
+
+class GraphsTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(GraphsTest);
+  CPPUNIT_TEST(testComplete);
+  CPPUNIT_TEST(testRead);
+  CPPUNIT_TEST(testTwistedTorus);
+  CPPUNIT_TEST(testOrientationReversal);
+  CPPUNIT_TEST(testCandidates);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testComplete(void);
+  void testRead(void);
+  void testTwistedTorus(void);
+  void testOrientationReversal(void);
+  void testCandidates(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( GraphsTest );
+
+namespace {
+  // Neighbors by scanning every vertex
+  vector<int> scanNeighbors(const Graph& graph, int src) {
+    vector<int> result;
+    for ( int dst = 0; dst < graph.order(); dst++ ) {
+      if ( graph.hasEdge(src, dst) ) {
+	result.push_back(dst);
+      }
+    }
+    return result;
+  }
+
+  bool symmetric(const Graph& graph) {
+    for ( int src = 0; src < graph.order(); src++ ) {
+      for ( int dst = 0; dst < graph.order(); dst++ ) {
+	if ( graph.hasEdge(src, dst) != graph.hasEdge(dst, src) ) {
+	  return false;
+	}
+      }
+    }
+    return true;
+  }
+}
+
+void GraphsTest::testComplete(void) {
+  Graph graph = Graph::complete(4);
+  CPPUNIT_ASSERT_EQUAL(4, graph.order());
+  CPPUNIT_ASSERT(!graph.hasEdge(2, 2));
+  CPPUNIT_ASSERT(graph.hasEdge(2, 3));
+  CPPUNIT_ASSERT(graph.neighbors(1) == vector<int>({0, 2, 3}));
+  CPPUNIT_ASSERT_EQUAL(3, graph.degree(0));
+  CPPUNIT_ASSERT_THROW(graph.hasEdge(0, 4), out_of_range);
+  CPPUNIT_ASSERT_THROW(graph.neighbors(-1), out_of_range);
+  CPPUNIT_ASSERT_THROW(Graph::complete(-1), invalid_argument);
+
+  // Materialized, the graph is the same
+  Adjacency adjacency = graph.adjacency();
+  CPPUNIT_ASSERT_EQUAL(4, adjacency.order());
+  CPPUNIT_ASSERT(adjacency.neighbors(1) == graph.neighbors(1));
+}
+
+void GraphsTest::testRead(void) {
+  istringstream in("3\n0 1 0\n0 0 1\n1 0 0\n");
+  Graph graph = Graph::read(in);
+  CPPUNIT_ASSERT_EQUAL(3, graph.order());
+  CPPUNIT_ASSERT(graph.hasEdge(0, 1));
+  CPPUNIT_ASSERT(!graph.hasEdge(1, 0));
+  CPPUNIT_ASSERT(graph.neighbors(2) == vector<int>({0}));
+
+  ostringstream out;
+  out << graph;
+  CPPUNIT_ASSERT_EQUAL(string("   0 1 2 \n\n"
+			      "0  0 1 0 \n"
+			      "1  0 0 1 \n"
+			      "2  1 0 0 \n\n\n"), out.str());
+}
+
+void GraphsTest::testTwistedTorus(void) {
+  Graph graph = Graph::twistedTorus(4);
+  CPPUNIT_ASSERT_EQUAL(12, graph.order());
+  CPPUNIT_ASSERT(symmetric(graph));
+
+  // Column 1 (vertices 3, 4, 5) is a triangle joined to columns 0 and 2
+  CPPUNIT_ASSERT(graph.neighbors(4) == vector<int>({1, 3, 5, 7}));
+  // The last column joins the first with rows 0 and 1 exchanged
+  CPPUNIT_ASSERT(graph.neighbors(0) == vector<int>({1, 2, 3, 10}));
+  CPPUNIT_ASSERT(graph.neighbors(11) == vector<int>({2, 8, 9, 10}));
+  for ( int vertex = 0; vertex < graph.order(); vertex++ ) {
+    CPPUNIT_ASSERT_EQUAL(4, graph.degree(vertex));
+  }
+  CPPUNIT_ASSERT_THROW(Graph::twistedTorus(0), invalid_argument);
+}
+
+void GraphsTest::testOrientationReversal(void) {
+  // The adjacency matrix worked out in graphs.cpp
+  const vector<vector<int> > expected = { {0, 1, 1, 1, 0, 0},
+					  {1, 0, 1, 0, 1, 1},
+					  {1, 1, 0, 0, 1, 1},
+					  {1, 0, 0, 0, 1, 0},
+					  {0, 1, 1, 1, 0, 1},
+					  {0, 1, 1, 0, 1, 0} };
+  Graph graph = Graph::orientationReversal(3, 2);
+  CPPUNIT_ASSERT_EQUAL(6, graph.order());
+  for ( int src = 0; src < 6; src++ ) {
+    for ( int dst = 0; dst < 6; dst++ ) {
+      CPPUNIT_ASSERT_EQUAL(expected[src][dst] == 1, graph.hasEdge(src, dst));
+    }
+  }
+
+  CPPUNIT_ASSERT_THROW(Graph::orientationReversal(4, 2), invalid_argument);
+  CPPUNIT_ASSERT_THROW(Graph::orientationReversal(3, 3), invalid_argument);
+}
+
+void GraphsTest::testCandidates(void) {
+  // The candidate lists never miss a neighbor.
+  vector<Graph> graphs = { Graph::twistedTorus(1),
+			   Graph::twistedTorus(2),
+			   Graph::twistedTorus(7),
+			   Graph::orientationReversal(3, 2),
+			   Graph::orientationReversal(5, 6),
+			   Graph(Graph::twistedTorus(5).adjacency()) };
+  for ( const Graph& graph : graphs ) {
+    for ( int src = 0; src < graph.order(); src++ ) {
+      CPPUNIT_ASSERT(graph.neighbors(src) == scanNeighbors(graph, src));
+    }
+  }
+}
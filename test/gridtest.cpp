@@ -37,10 +37,12 @@ class GridTest : public CPPUNIT_NS::TestFixture {
   CPPUNIT_TEST_SUITE(GridTest);
   CPPUNIT_TEST(testConstruction2d);
   CPPUNIT_TEST(testConstructionFailure);
+  CPPUNIT_TEST(testAt);
   CPPUNIT_TEST_SUITE_END();
 protected:
   void testConstruction2d(void);
   void testConstructionFailure(void);
+  void testAt(void);
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( GridTest );
@@ -93,3 +95,20 @@ void GridTest::testConstructionFailure(void) {
   CPPUNIT_ASSERT_THROW(auto list = makeList(-1, 4, builder2d), invalid_argument);
   CPPUNIT_ASSERT_THROW(auto list = makeList(-1, -1, builder2d), invalid_argument);
 }
+
+void GridTest::testAt(void) {
+  MockSolver solver;
+  auto list = makeList(3, 4, getBuilder(&solver));
+
+  for ( int row = 0; row < 3; row++ ) {
+    for ( int col = 0; col < 4; col++ ) {
+      CPPUNIT_ASSERT_EQUAL(&list[row][col], &list.at(row, col));
+      CPPUNIT_ASSERT_EQUAL(&list[row][col], &list.at_unchecked(row, col));
+    }
+  }
+
+  CPPUNIT_ASSERT_THROW(list.at(-1, 0), out_of_range);
+  CPPUNIT_ASSERT_THROW(list.at(3, 0), out_of_range);
+  CPPUNIT_ASSERT_THROW(list.at(1, -1), out_of_range);
+  CPPUNIT_ASSERT_THROW(list.at(1, 4), out_of_range);
+}
@@ -33,6 +33,8 @@
 #include "../src/matrix.h"
 #include "../src/matrixview.h"
 #include "../src/pairindexedscalar.h"
+#include "../src/sparsecardinal.h"
+#include "../src/ordinal.h"
 
 using namespace std;
 
@@ -52,6 +54,15 @@ class MatrixTest : public CPPUNIT_NS::TestFixture {
   CPPUNIT_TEST(testRotatePairIndex);
   CPPUNIT_TEST(testRestrictedTransposedView);
   CPPUNIT_TEST(testRotatedRestrictedView);
+  CPPUNIT_TEST(testSparseDomains);
+  CPPUNIT_TEST(testViewIterators);
+  CPPUNIT_TEST(testViewOutOfRange);
+  CPPUNIT_TEST(testPeriodicView);
+  CPPUNIT_TEST(testPeriodicTransforms);
+  CPPUNIT_TEST(testToroidalView);
+  CPPUNIT_TEST(testPairIndexedOrdering);
+  CPPUNIT_TEST(testPairIndexedElement);
+  CPPUNIT_TEST(testPairIndexedOrdinalScalar);
   CPPUNIT_TEST_SUITE_END();
 protected:
   void testIsMatrix(void);
@@ -68,6 +79,15 @@ protected:
   void testRotatePairIndex(void);
   void testRestrictedTransposedView(void);
   void testRotatedRestrictedView(void);
+  void testSparseDomains(void);
+  void testViewIterators(void);
+  void testViewOutOfRange(void);
+  void testPeriodicView(void);
+  void testPeriodicTransforms(void);
+  void testToroidalView(void);
+  void testPairIndexedOrdering(void);
+  void testPairIndexedElement(void);
+  void testPairIndexedOrdinalScalar(void);
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( MatrixTest );
@@ -302,3 +322,256 @@ void MatrixTest::testRotatedRestrictedView() {
   CPPUNIT_ASSERT_EQUAL(matrix[5][4] == 0, restrict2[3][1] == 0); 
 
 }
+
+void MatrixTest::testSparseDomains(void) {
+  MinisatSolver solver;
+
+  // A checkerboard: light cells are 0 or 2, dark cells are 1.
+  Matrix<SparseCardinal> matrix(&solver, 3, 3, [] (int row, int col) {
+      return (row+col) % 2 == 0 ? vector<int>({0, 2}) : vector<int>({1});
+    });
+  CPPUNIT_ASSERT_EQUAL(5u*2u + 4u*1u, matrix.numLiterals());
+  CPPUNIT_ASSERT_EQUAL(Atom::falsity, matrix[0][0] == 1);
+  CPPUNIT_ASSERT_EQUAL(Atom::truth, matrix[0][1] != 2);
+
+  SparseCardinal row(&solver, vector<int>({0, 2}));
+  SparseCardinal col(&solver, vector<int>({0, 1, 2}));
+  solver.require(matrix[row][col] == 1);
+  solver.require(row == 0);
+
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(1, col.modelValue());
+  ASSERT_UNSAT_ASSUMP(solver, col == 2, matrix);
+}
+
+void MatrixTest::testViewIterators(void) {
+  MockSolver solver;
+  Matrix<> matrix(&solver, 4, 3, 0, 3);
+
+  vector<MatrixView<> > views;
+  views.push_back(MatrixView<>(matrix));
+  views.push_back(matrix.rotCW());
+  views.push_back(matrix.rotCCW().reflectH());
+  views.push_back(matrix.transpose().restrict(1, 1, 3, 4));
+  views.push_back(matrix.reflectV().rotCW().restrict(0, 1, 2, 3));
+  views.push_back(matrix.restrict(1, 1, 1, 3));
+
+  for ( const MatrixView<>& view : views ) {
+    // Cells are visited in row-major order, and are the cells themselves.
+    auto cell = view.begin();
+    for ( int row = 0; row < view.height(); row++ ) {
+      for ( int col = 0; col < view.width(); col++ ) {
+	CPPUNIT_ASSERT(cell != view.end());
+	CPPUNIT_ASSERT_EQUAL(&view[row][col], &*cell);
+	++cell;
+      }
+    }
+    CPPUNIT_ASSERT(cell == view.end());
+
+    int row = 0;
+    for ( const auto& viewRow : view.rows() ) {
+      int col = 0;
+      for ( const Cardinal& element : viewRow ) {
+	CPPUNIT_ASSERT_EQUAL(&view[row][col], &element);
+	col++;
+      }
+      CPPUNIT_ASSERT_EQUAL((int)view.width(), col);
+      row++;
+    }
+    CPPUNIT_ASSERT_EQUAL((int)view.height(), row);
+  }
+}
+
+void MatrixTest::testViewOutOfRange(void) {
+  MockSolver solver;
+  Matrix<> matrix(&solver, 4, 3, 0, 3);
+  auto view = matrix.rotCW().restrict(1, 1, 3, 4);
+
+  CPPUNIT_ASSERT_EQUAL(2u, view.height());
+  CPPUNIT_ASSERT_EQUAL(3u, view.width());
+  CPPUNIT_ASSERT_THROW(view[-1][0], out_of_range);
+  CPPUNIT_ASSERT_THROW(view[2][0], out_of_range);
+  CPPUNIT_ASSERT_THROW(view[0][-1], out_of_range);
+  CPPUNIT_ASSERT_THROW(view[0][3], out_of_range);
+}
+
+void MatrixTest::testPeriodicView(void) {
+  MockSolver solver;
+  Matrix<> matrix(&solver, 2, 4, 0, 3);
+  unsigned int numVars = solver.newVars(0);
+
+  // Three columns repeated across ten, without new variables
+  auto view = matrix.periodicCols(3, 10);
+  CPPUNIT_ASSERT_EQUAL(2u, view.height());
+  CPPUNIT_ASSERT_EQUAL(10u, view.width());
+  CPPUNIT_ASSERT_EQUAL(numVars, solver.newVars(0));
+  for ( int row = 0; row < 2; row++ ) {
+    for ( int col = 0; col < 10; col++ ) {
+      CPPUNIT_ASSERT_EQUAL(&matrix[row][col % 3], &view[row][col]);
+    }
+  }
+  CPPUNIT_ASSERT_THROW(view[0][10], out_of_range);
+
+  auto rows = matrix.periodicRows(1, 3);
+  CPPUNIT_ASSERT_EQUAL(3u, rows.height());
+  CPPUNIT_ASSERT_EQUAL(&matrix[0][2], &rows[2][2]);
+
+  // Iteration follows the periodic mapping.
+  auto cell = view.begin();
+  for ( int row = 0; row < 2; row++ ) {
+    for ( int col = 0; col < 10; col++ ) {
+      CPPUNIT_ASSERT_EQUAL(&view[row][col], &*cell);
+      ++cell;
+    }
+  }
+  CPPUNIT_ASSERT(cell == view.end());
+
+  CPPUNIT_ASSERT_THROW(matrix.periodicCols(0, 10), invalid_argument);
+  CPPUNIT_ASSERT_THROW(matrix.periodicCols(5, 10), invalid_argument);
+  CPPUNIT_ASSERT_THROW(matrix.periodicRows(1, -1), invalid_argument);
+  CPPUNIT_ASSERT_THROW(view.periodicCols(2, 4), invalid_argument);
+}
+
+void MatrixTest::testPeriodicTransforms(void) {
+  MockSolver solver;
+  Matrix<> matrix(&solver, 3, 4, 0, 3);
+  auto view = matrix.restrict(1, 1, 3, 4).periodicCols(2, 7);
+
+  // Transformations of a periodic view act on the view's own indices.
+  auto reflected = view.reflectH();
+  auto transposed = view.transpose();
+  auto restricted = view.restrict(1, 3, 2, 7);
+  auto rotated = view.rotCW();
+  for ( int row = 0; row < 2; row++ ) {
+    for ( int col = 0; col < 7; col++ ) {
+      const Cardinal* expected = &matrix[1+row][1 + col % 2];
+      CPPUNIT_ASSERT_EQUAL(expected, &view[row][col]);
+      CPPUNIT_ASSERT_EQUAL(expected, &reflected[row][6-col]);
+      CPPUNIT_ASSERT_EQUAL(expected, &transposed[col][row]);
+      CPPUNIT_ASSERT_EQUAL(expected, &rotated[col][1-row]);
+      if ( row == 1 && col >= 3 ) {
+	CPPUNIT_ASSERT_EQUAL(expected, &restricted[0][col-3]);
+      }
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL(&matrix[2][1], &view.reflectV().reflectH()[0][2]);
+}
+
+void MatrixTest::testToroidalView(void) {
+  MockSolver solver;
+  Matrix<> matrix(&solver, 3, 4, 0, 3);
+  auto torus = matrix.toroidal();
+
+  CPPUNIT_ASSERT(torus.isToroidal());
+  CPPUNIT_ASSERT(!MatrixView<>(matrix).isToroidal());
+  CPPUNIT_ASSERT_EQUAL(&matrix[2][3], &torus[-1][-1]);
+  CPPUNIT_ASSERT_EQUAL(&matrix[0][0], &torus[3][4]);
+  CPPUNIT_ASSERT_EQUAL(&matrix[1][2], &torus[-5][14]);
+
+  // Derived views wrap around their own edges.
+  auto turned = torus.rotCW();
+  CPPUNIT_ASSERT(turned.isToroidal());
+  CPPUNIT_ASSERT_EQUAL(&matrix[0][1], &turned[1][-1]);
+  auto corner = torus.restrict(1, 1, 3, 3);
+  CPPUNIT_ASSERT_EQUAL(&matrix[1][1], &corner[2][-2]);
+
+  // A toroidal periodic row
+  auto ring = matrix.restrict(0, 0, 1, 4).periodicCols(2, 6).toroidal();
+  CPPUNIT_ASSERT_EQUAL(&matrix[0][1], &ring[0][-1]);
+  CPPUNIT_ASSERT_EQUAL(&matrix[0][0], &ring[0][6]);
+}
+
+namespace {
+  // Fixed cell values for the pair-indexed tests
+  const int cellValues[3][3] = { {0, 3, 1},
+				 {2, 2, 0},
+				 {1, 3, 3} };
+
+  template<class Scalar>
+  void fixCells(Solver& solver, const Matrix<Scalar>& matrix) {
+    for ( int i = 0; i < 3; i++ ) {
+      for ( int j = 0; j < 3; j++ ) {
+	solver.require(matrix[i][j] == cellValues[i][j]);
+      }
+    }
+  }
+}
+
+void MatrixTest::testPairIndexedOrdering(void) {
+  // One solver per operator: <, >=, >
+  for ( int op = 0; op < 3; op++ ) {
+    MinisatSolver solver;
+    Matrix<> matrix(&solver, 3, 3, 0, 4);
+    fixCells(solver, matrix);
+    Cardinal row(&solver, 0, 3);
+    Cardinal col(&solver, 0, 3);
+
+    Requirement req = 
+      op == 0 ? matrix[row][col] < 2 :
+      op == 1 ? matrix[row][col] >= 2 :
+                matrix[row][col] > 2;
+    solver.require(req);
+
+    for ( int i = 0; i < 3; i++ ) {
+      for ( int j = 0; j < 3; j++ ) {
+	int value = cellValues[i][j];
+	bool holds = op == 0 ? value < 2 : op == 1 ? value >= 2 : value > 2;
+	if ( holds ) {
+	  ASSERT_SAT_ASSUMP(solver, (row == i) & (col == j));
+	} else {
+	  ASSERT_UNSAT_ASSUMP(solver, (row == i) & (col == j), req);
+	}
+      }
+    }
+  }
+}
+
+void MatrixTest::testPairIndexedElement(void) {
+  MinisatSolver solver;
+  Matrix<> matrix(&solver, 3, 3, 0, 4);
+  fixCells(solver, matrix);
+  Cardinal row(&solver, 0, 3);
+  Cardinal col(&solver, 0, 3);
+  Cardinal value(&solver, 0, 4);
+  Cardinal other(&solver, 0, 4);
+
+  solver.require(matrix[row][col] == value);
+  solver.require(matrix[row][col] != other);
+
+  for ( int i = 0; i < 3; i++ ) {
+    for ( int j = 0; j < 3; j++ ) {
+      ASSERT_SAT_ASSUMP(solver, (row == i) & (col == j));
+      CPPUNIT_ASSERT_EQUAL(cellValues[i][j], value.modelValue());
+      CPPUNIT_ASSERT(cellValues[i][j] != other.modelValue());
+    }
+  }
+
+  // Only cell (1,2) is 0 in the middle row, so value 0 forces column 2.
+  ASSERT_SAT_ASSUMP(solver, (row == 1) & (value == 0));
+  CPPUNIT_ASSERT_EQUAL(2, col.modelValue());
+}
+
+void MatrixTest::testPairIndexedOrdinalScalar(void) {
+  MinisatSolver solver;
+  Matrix<Ordinal> matrix(&solver, 3, 3, 0, 4);
+  fixCells(solver, matrix);
+  Ordinal row(&solver, 0, 3);
+  Ordinal col(&solver, 0, 3);
+  Ordinal bound(&solver, 0, 4);
+
+  Requirement req = matrix[row][col] <= bound;
+  solver.require(req);
+
+  for ( int i = 0; i < 3; i++ ) {
+    for ( int j = 0; j < 3; j++ ) {
+      for ( int b = 0; b < 4; b++ ) {
+	DualClause assumptions = (row == i) & (col == j) & (bound == b);
+	if ( cellValues[i][j] <= b ) {
+	  ASSERT_SAT_ASSUMP(solver, assumptions);
+	} else {
+	  ASSERT_UNSAT_ASSUMP(solver, assumptions, req);
+	}
+      }
+    }
+  }
+}
@@ -0,0 +1,163 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/matrix.h"
+#include "../src/ordinal.h"
+#include "../src/ordinalminmax.h"
+
+using namespace std;
+
+class OrdinalMinMaxTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(OrdinalMinMaxTest);
+  CPPUNIT_TEST(testRange);
+  CPPUNIT_TEST(testMinimum);
+  CPPUNIT_TEST(testExhaustive);
+  CPPUNIT_TEST(testReuse);
+  CPPUNIT_TEST(testMatrixColumns);
+  CPPUNIT_TEST(testEmpty);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testRange(void);
+  void testMinimum(void);
+  void testExhaustive(void);
+  void testReuse(void);
+  void testMatrixColumns(void);
+  void testEmpty(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( OrdinalMinMaxTest );
+
+void OrdinalMinMaxTest::testRange(void) {
+  MockSolver solver;
+  vector<Ordinal> ords;
+  ords.push_back(Ordinal(&solver, 0, 3));
+  ords.push_back(Ordinal(&solver, -1, 2));
+  ords.push_back(Ordinal(&solver, 5, 9));
+
+  Ordinal least = min(ords);
+  CPPUNIT_ASSERT_EQUAL(-1, least.min());
+  CPPUNIT_ASSERT_EQUAL(2,  least.max());
+
+  Ordinal greatest = max(ords);
+  CPPUNIT_ASSERT_EQUAL(5, greatest.min());
+  CPPUNIT_ASSERT_EQUAL(9, greatest.max());
+}
+
+void OrdinalMinMaxTest::testMinimum(void) {
+  MockSolver solver;
+  Ordinal lhs(&solver, 0, 3);
+  Ordinal rhs(&solver, 1, 3);
+  Ordinal result(&solver, 0, 3);
+
+  Requirement expected;
+  expected &= implication(lhs <= 0, result <= 0);
+  expected &= ~(result <= 0) | (lhs <= 0);
+  expected &= implication(lhs <= 1, result <= 1);
+  expected &= implication(rhs <= 1, result <= 1);
+  expected &= ~(result <= 1) | (lhs <= 1) | (rhs <= 1);
+
+  CPPUNIT_ASSERT_EQUAL(expected, minimum(lhs, rhs, result));
+}
+
+void OrdinalMinMaxTest::testExhaustive(void) {
+  MinisatSolver solver;
+  vector<Ordinal> ords;
+  ords.push_back(Ordinal(&solver, 0, 3));
+  ords.push_back(Ordinal(&solver, -1, 2));
+  ords.push_back(Ordinal(&solver, 1, 4));
+
+  Ordinal least = min(ords);
+  Ordinal greatest = max(ords);
+
+  for ( int a = 0; a < 3; a++ ) {
+    for ( int b = -1; b < 2; b++ ) {
+      for ( int c = 1; c < 4; c++ ) {
+	DualClause assumptions = (ords[0] == a) & (ords[1] == b) & (ords[2] == c);
+	ASSERT_SAT_ASSUMP(solver, assumptions);
+	CPPUNIT_ASSERT_EQUAL(std::min(a, std::min(b, c)), least.modelValue());
+	CPPUNIT_ASSERT_EQUAL(std::max(a, std::max(b, c)), greatest.modelValue());
+      }
+    }
+  }
+}
+
+void OrdinalMinMaxTest::testReuse(void) {
+  MockSolver solver;
+  vector<Ordinal> ords;
+  for ( int i = 0; i < 8; i++ ) {
+    ords.push_back(Ordinal(&solver, 0, 10));
+  }
+
+  Ordinal least = min(ords);
+  unsigned int numVars = solver.newVars(0);
+  unsigned int numClauses = solver.getRequirements().size();
+
+  // Comparisons against the result are single atoms; nothing new is
+  // allocated or required.
+  CPPUNIT_ASSERT(least <= 4 != Atom::truth);
+  CPPUNIT_ASSERT(least >= 2 != Atom::falsity);
+  CPPUNIT_ASSERT_EQUAL(numVars, solver.newVars(0));
+  CPPUNIT_ASSERT_EQUAL(numClauses, (unsigned int)solver.getRequirements().size());
+}
+
+void OrdinalMinMaxTest::testMatrixColumns(void) {
+  MinisatSolver solver;
+  Matrix<Ordinal> matrix(&solver, 4, 3, 0, 5);
+
+  // Column minima are 1, 2, 3, and column maxima are 4.
+  for ( int col = 0; col < 3; col++ ) {
+    vector<Ordinal> cells;
+    for ( int row = 0; row < 4; row++ ) {
+      cells.push_back(matrix[row][col]);
+    }
+    solver.require(min(cells) == col+1);
+    solver.require(max(cells) == 4);
+  }
+
+  ASSERT_SAT(solver);
+  for ( int col = 0; col < 3; col++ ) {
+    int least = 5;
+    int greatest = -1;
+    for ( int row = 0; row < 4; row++ ) {
+      least = std::min(least, matrix[row][col].modelValue());
+      greatest = std::max(greatest, matrix[row][col].modelValue());
+    }
+    CPPUNIT_ASSERT_EQUAL(col+1, least);
+    CPPUNIT_ASSERT_EQUAL(4, greatest);
+  }
+}
+
+void OrdinalMinMaxTest::testEmpty(void) {
+  CPPUNIT_ASSERT_THROW(min(vector<Ordinal>()), invalid_argument);
+  CPPUNIT_ASSERT_THROW(max(vector<Ordinal>()), invalid_argument);
+}
@@ -0,0 +1,172 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/matrix.h"
+#include "../src/ordinal.h"
+#include "../src/ordinalsum.h"
+
+using namespace std;
+
+class OrdinalSumTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(OrdinalSumTest);
+  CPPUNIT_TEST(testSingleton);
+  CPPUNIT_TEST(testRange);
+  CPPUNIT_TEST(testTotalizer);
+  CPPUNIT_TEST(testExhaustive);
+  CPPUNIT_TEST(testCompareOrdinal);
+  CPPUNIT_TEST(testMatrixRow);
+  CPPUNIT_TEST(testEmpty);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testSingleton(void);
+  void testRange(void);
+  void testTotalizer(void);
+  void testExhaustive(void);
+  void testCompareOrdinal(void);
+  void testMatrixRow(void);
+  void testEmpty(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( OrdinalSumTest );
+
+void OrdinalSumTest::testSingleton(void) {
+  MockSolver solver;
+  Ordinal ord(&solver, -2, 3);
+
+  // Summing one ordinal allocates nothing new.
+  Ordinal total = sum({ord});
+  CPPUNIT_ASSERT_EQUAL(ord <= 1, total <= 1);
+  CPPUNIT_ASSERT_EQUAL(4u, solver.newVars(0));
+}
+
+void OrdinalSumTest::testRange(void) {
+  MockSolver solver;
+  vector<Ordinal> ords;
+  ords.push_back(Ordinal(&solver, 0, 3));
+  ords.push_back(Ordinal(&solver, -1, 2));
+  ords.push_back(Ordinal(&solver, 5, 6));
+  ords.push_back(Ordinal(&solver, 1, 10));
+
+  Ordinal total = sum(ords);
+  CPPUNIT_ASSERT_EQUAL(5, total.min());
+  CPPUNIT_ASSERT_EQUAL(18, total.max());
+}
+
+void OrdinalSumTest::testTotalizer(void) {
+  MockSolver solver;
+  Ordinal lhs(&solver, 0, 2);
+  Ordinal rhs(&solver, 0, 2);
+  Ordinal total(&solver, 0, 3);
+
+  Requirement expected;
+  expected &= ~(rhs >= 1) | (total >= 1);
+  expected &= ~(lhs >= 1) | (total >= 1);
+  expected &= ~(lhs >= 1) | ~(rhs >= 1) | (total >= 2);
+  expected &= ~(lhs <= 0) | ~(rhs <= 0) | (total <= 0);
+  expected &= ~(lhs <= 0) | (total <= 1);
+  expected &= ~(rhs <= 0) | (total <= 1);
+
+  CPPUNIT_ASSERT_EQUAL(expected, totalizer(lhs, rhs, total));
+}
+
+void OrdinalSumTest::testExhaustive(void) {
+  MinisatSolver solver;
+  vector<Ordinal> ords;
+  ords.push_back(Ordinal(&solver, 0, 3));
+  ords.push_back(Ordinal(&solver, -1, 2));
+  ords.push_back(Ordinal(&solver, 2, 4));
+
+  Ordinal total = sum(ords);
+
+  for ( int a = 0; a < 3; a++ ) {
+    for ( int b = -1; b < 2; b++ ) {
+      for ( int c = 2; c < 4; c++ ) {
+	DualClause assumptions = (ords[0] == a) & (ords[1] == b) & (ords[2] == c);
+	ASSERT_SAT_ASSUMP(solver, assumptions);
+	CPPUNIT_ASSERT_EQUAL(a+b+c, total.modelValue());
+
+	if ( a+b+c > total.min() ) {
+	  ASSERT_UNSAT_ASSUMP(solver, assumptions & (total < a+b+c), total);
+	}
+	if ( a+b+c < total.max()-1 ) {
+	  ASSERT_UNSAT_ASSUMP(solver, assumptions & (total > a+b+c), total);
+	}
+      }
+    }
+  }
+}
+
+void OrdinalSumTest::testCompareOrdinal(void) {
+  MinisatSolver solver;
+  vector<Ordinal> ords;
+  for ( int i = 0; i < 5; i++ ) {
+    ords.push_back(Ordinal(&solver, 0, 4));
+  }
+  Ordinal bound(&solver, 0, 5);
+
+  Ordinal total = sum(ords);
+  solver.require(total >= bound);
+  solver.require(bound >= 4);
+  solver.require(total <= 4);
+
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(4, total.modelValue());
+
+  ASSERT_UNSAT_ASSUMP(solver, (ords[0] == 3) & (ords[1] == 2), total);
+}
+
+void OrdinalSumTest::testMatrixRow(void) {
+  MinisatSolver solver;
+  Matrix<Ordinal> matrix(&solver, 3, 6, 0, 3);
+
+  for ( int row = 0; row < 3; row++ ) {
+    vector<Ordinal> cells;
+    for ( int col = 0; col < 6; col++ ) {
+      cells.push_back(matrix[row][col]);
+    }
+    solver.require(sum(cells) == 2*row + 5);
+  }
+
+  ASSERT_SAT(solver);
+  for ( int row = 0; row < 3; row++ ) {
+    int total = 0;
+    for ( int col = 0; col < 6; col++ ) {
+      total += matrix[row][col].modelValue();
+    }
+    CPPUNIT_ASSERT_EQUAL(2*row + 5, total);
+  }
+}
+
+void OrdinalSumTest::testEmpty(void) {
+  CPPUNIT_ASSERT_THROW(sum(vector<Ordinal>()), invalid_argument);
+}
@@ -0,0 +1,157 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/cardinal.h"
+#include "../src/matrix.h"
+#include "../src/windowrule.h"
+#include "../src/parallelencoding.h"
+
+using namespace std;
+
+class ParallelEncodingTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(ParallelEncodingTest);
+  CPPUNIT_TEST(testDeterministic);
+  CPPUNIT_TEST(testRequireRows);
+  CPPUNIT_TEST(testFewRows);
+  CPPUNIT_TEST(testErrors);
+  CPPUNIT_TEST(testSolve);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testDeterministic(void);
+  void testRequireRows(void);
+  void testFewRows(void);
+  void testErrors(void);
+  void testSolve(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( ParallelEncodingTest );
+
+namespace {
+  // Every packed literal, with clause lengths, in order
+  vector<int> flatten(const vector<ClauseBuffer>& buffers) {
+    vector<int> result;
+    for ( const ClauseBuffer& buffer : buffers ) {
+      buffer.forEachClause([&] (const int* lits, int size) {
+	  result.push_back(size);
+	  result.insert(result.end(), lits, lits+size);
+	});
+    }
+    return result;
+  }
+
+  bool differ(int lhs, int rhs) {
+    return lhs != rhs;
+  }
+}
+
+void ParallelEncodingTest::testDeterministic(void) {
+  MockSolver solver;
+  Matrix<> matrix(&solver, 9, 5, 0, 3);
+  WindowRule rule = WindowRule::vertical({0, 1, 2}, differ);
+  auto cell = [&] (int row, int col) { return matrix[row][col]; };
+  row_generator_type rows = [&] (int row) { return rule.stampRow(cell, row, 5); };
+
+  vector<int> single = flatten(encodeRows(8, rows, 1));
+  CPPUNIT_ASSERT(!single.empty());
+  for ( unsigned int numThreads = 2; numThreads <= 9; numThreads++ ) {
+    vector<ClauseBuffer> buffers = encodeRows(8, rows, numThreads);
+    CPPUNIT_ASSERT_EQUAL((size_t)min(numThreads, 8u), buffers.size());
+    CPPUNIT_ASSERT(single == flatten(buffers));
+  }
+  CPPUNIT_ASSERT(single == flatten(encodeRows(8, rows)));
+}
+
+void ParallelEncodingTest::testRequireRows(void) {
+  MockSolver parallelSolver;
+  MockSolver serialSolver;
+  Matrix<> parallelMatrix(&parallelSolver, 6, 4, 0, 3);
+  Matrix<> serialMatrix(&serialSolver, 6, 4, 0, 3);
+  WindowRule rule = WindowRule::horizontal({0, 1, 2}, differ);
+
+  requireRows(&parallelSolver, 6, [&] (int row) { 
+      return rule.stampRow([&] (int i, int j) { return parallelMatrix[i][j]; }, row, 4);
+    }, 3);
+  serialSolver.require(rule.stamp(serialMatrix));
+
+  CPPUNIT_ASSERT_EQUAL(serialSolver.getRequirements(), parallelSolver.getRequirements());
+}
+
+void ParallelEncodingTest::testFewRows(void) {
+  row_generator_type unit = [] (int row) { return Requirement(Clause(Literal(row))); };
+
+  CPPUNIT_ASSERT(flatten(encodeRows(0, unit, 4)).empty());
+  vector<ClauseBuffer> buffers = encodeRows(2, unit, 16);
+  CPPUNIT_ASSERT_EQUAL((size_t)2, buffers.size());
+  CPPUNIT_ASSERT(vector<int>({1, 1, 1, 2}) == flatten(buffers));
+}
+
+void ParallelEncodingTest::testErrors(void) {
+  row_generator_type failing = [] (int row) -> Requirement {
+    if ( row % 3 == 2 ) {
+      throw out_of_range("row " + to_string(row));
+    }
+    return Requirement();
+  };
+
+  try {
+    encodeRows(9, failing, 3);
+    CPPUNIT_FAIL("Generator exception not rethrown");
+  } catch ( const out_of_range& e ) {
+    CPPUNIT_ASSERT_EQUAL(string("row 2"), string(e.what()));
+  }
+}
+
+void ParallelEncodingTest::testSolve(void) {
+  MinisatSolver solver;
+  Matrix<> matrix(&solver, 6, 6, 0, 2);
+  WindowRule horizontal = WindowRule::horizontal({0, 1}, differ);
+  WindowRule vertical = WindowRule::vertical({0, 1}, differ);
+  auto cell = [&] (int row, int col) { return matrix[row][col]; };
+
+  // A checkerboard
+  requireRows(&solver, 6, [&] (int row) {
+      Requirement req = horizontal.stampRow(cell, row, 6);
+      if ( row < 5 ) {
+	req &= vertical.stampRow(cell, row, 6);
+      }
+      return req;
+    }, 4);
+  solver.require(matrix[0][0] == 1);
+
+  ASSERT_SAT(solver);
+  for ( int row = 0; row < 6; row++ ) {
+    for ( int col = 0; col < 6; col++ ) {
+      CPPUNIT_ASSERT_EQUAL((row + col + 1) % 2, matrix[row][col].modelValue());
+    }
+  }
+}
@@ -24,6 +24,8 @@
 
 #include <string>
 #include <sstream>
+#include <utility>
+#include <vector>
 #include <cppunit/TestFixture.h>
 #include <cppunit/extensions/HelperMacros.h>
 #include "testglue.h"
@@ -37,12 +39,16 @@ class PatternTest : public CPPUNIT_NS::TestFixture {
   CPPUNIT_TEST(testConstruction2);
   CPPUNIT_TEST(testConstructionStream);
   CPPUNIT_TEST(testBlank);
+  CPPUNIT_TEST(testCells);
+  CPPUNIT_TEST(testOrientations);
   CPPUNIT_TEST_SUITE_END();
 protected:
   void testConstruction(void);
   void testConstruction2(void);
   void testConstructionStream(void);
   void testBlank(void);
+  void testCells(void);
+  void testOrientations(void);
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION( PatternTest );
@@ -115,3 +121,33 @@ void PatternTest::testBlank(void) {
 
   CPPUNIT_ASSERT_EQUAL(true, pattern.isBlank);
 }
+
+void PatternTest::testCells(void) {
+  Pattern pattern(
+      " .  x  .    ; "
+      " . (x) x    ; ");
+
+  CPPUNIT_ASSERT((pattern.cells() == vector<pair<int, int> >({ {0, 1}, {1, 1}, {1, 2} })));
+
+  Array2d<bool> grid(2, 3);
+  grid[0][1] = grid[1][1] = grid[1][2] = true;
+  Pattern fromGrid(grid);
+  CPPUNIT_ASSERT(fromGrid == pattern);
+  CPPUNIT_ASSERT_EQUAL(-1, fromGrid.centerRow);
+  CPPUNIT_ASSERT_EQUAL(false, fromGrid.isBlank);
+  CPPUNIT_ASSERT(fromGrid != Pattern("x x x ; . x . ;"));
+}
+
+void PatternTest::testOrientations(void) {
+  // The free tetrominoes have 1, 2, 4, 4 and 8 distinct orientations.
+  CPPUNIT_ASSERT_EQUAL(1, (int)Pattern("x x ; x x ;").orientations().size());
+  CPPUNIT_ASSERT_EQUAL(2, (int)Pattern("x x x x ;").orientations().size());
+  CPPUNIT_ASSERT_EQUAL(4, (int)Pattern("x x x ; . x . ;").orientations().size());
+  CPPUNIT_ASSERT_EQUAL(4, (int)Pattern("x x . ; . x x ;").orientations().size());
+  CPPUNIT_ASSERT_EQUAL(8, (int)Pattern("x x x ; x . . ;").orientations().size());
+
+  // Orientations are trimmed, and the first is the pattern itself.
+  vector<Pattern> straight = Pattern(". . . ; x x x ; . . . ;").orientations();
+  CPPUNIT_ASSERT(straight[0] == Pattern("x x x ;"));
+  CPPUNIT_ASSERT(straight[1] == Pattern("x ; x ; x ;"));
+}
@@ -0,0 +1,169 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Unit tests for Placements.
+
+#include <set>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/cardinal.h"
+#include "../src/matrix.h"
+#include "../src/pattern.h"
+#include "../src/placements.h"
+
+using namespace std;
+
+class PlacementsTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(PlacementsTest);
+  CPPUNIT_TEST(testEnumeration);
+  CPPUNIT_TEST(testOpenCells);
+  CPPUNIT_TEST(testExactlyOne);
+  CPPUNIT_TEST(testTiling);
+  CPPUNIT_TEST(testCover);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testEnumeration(void);
+  void testOpenCells(void);
+  void testExactlyOne(void);
+  void testTiling(void);
+  void testCover(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( PlacementsTest );
+
+void PlacementsTest::testEnumeration(void) {
+  MinisatSolver solver;
+
+  // A straight tromino on a 3 x 4 grid: 6 placements lying down and 4
+  // standing up, and none hanging off the grid.
+  Placements straight(&solver, Pattern("x x x ;"), 3, 4);
+  CPPUNIT_ASSERT_EQUAL(2, (int)straight.orientations().size());
+  CPPUNIT_ASSERT_EQUAL(10, straight.size());
+  for ( int index = 0; index < straight.size(); index++ ) {
+    for ( auto cell : straight.placement(index).cells ) {
+      CPPUNIT_ASSERT(0 <= cell.first && cell.first < 3);
+      CPPUNIT_ASSERT(0 <= cell.second && cell.second < 4);
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL(2, (int)straight.covering(0, 0).size());
+  CPPUNIT_ASSERT_EQUAL(3, (int)straight.covering(1, 1).size());
+
+  const Placements::Placement& first = straight.placement(0);
+  CPPUNIT_ASSERT_EQUAL(0, first.orientation);
+  CPPUNIT_ASSERT((first.cells == vector<pair<int, int> >({ {0, 0}, {0, 1}, {0, 2} })));
+
+  // Kept as given, only the 6 placements lying down remain.
+  Placements fixed(&solver, Pattern("x x x ;"), 3, 4, false);
+  CPPUNIT_ASSERT_EQUAL(6, fixed.size());
+
+  CPPUNIT_ASSERT_THROW(straight.covering(3, 0), out_of_range);
+  CPPUNIT_ASSERT_THROW(straight.selector(10), out_of_range);
+  CPPUNIT_ASSERT_THROW(Placements(&solver, Pattern(". ;"), 3, 4), invalid_argument);
+}
+
+void PlacementsTest::testOpenCells(void) {
+  MinisatSolver solver;
+
+  // A domino on a 3 x 3 grid with the center blocked: of the 12
+  // placements, the 4 touching the center are dropped.
+  auto open = [] (int row, int col) { return row != 1 || col != 1; };
+  Placements domino(&solver, Pattern("x x ;"), 3, 3, true, open);
+  CPPUNIT_ASSERT_EQUAL(8, domino.size());
+  CPPUNIT_ASSERT(domino.covering(1, 1).empty());
+  CPPUNIT_ASSERT_EQUAL(Clause(), domino.covers(1, 1));
+}
+
+void PlacementsTest::testExactlyOne(void) {
+  MinisatSolver solver;
+  Placements ell(&solver, Pattern("x x ; x . ;"), 2, 3);
+  CPPUNIT_ASSERT_EQUAL(8, ell.size());
+  solver.require(ell.exactlyOne());
+
+  ASSERT_SAT(solver);
+  int chosen = ell.modelPlacement();
+  CPPUNIT_ASSERT(0 <= chosen && chosen < ell.size());
+  for ( int index = 0; index < ell.size(); index++ ) {
+    CPPUNIT_ASSERT_EQUAL(index == chosen, solver.modelValue(ell.selector(index).getVar()));
+  }
+  ASSERT_SAT_ASSUMP(solver, ell.selector(7));
+  ASSERT_UNSAT_ASSUMP(solver, ell.selector(0) & ell.selector(7), chosen);
+}
+
+void PlacementsTest::testTiling(void) {
+  // Two L trominoes tile a 2 x 3 grid in 2 ways, or 4 ways if the
+  // pieces are told apart.
+  MinisatSolver solver;
+  vector<Placements> pieces;
+  for ( int piece = 0; piece < 2; piece++ ) {
+    pieces.push_back(Placements(&solver, Pattern("x x ; x . ;"), 2, 3));
+    solver.require(pieces.back().exactlyOne());
+  }
+  solver.require(Placements::cellCoverage(pieces));
+
+  set<pair<int, int> > tilings;
+  while ( solver.solve() ) {
+    pair<int, int> tiling(pieces[0].modelPlacement(), pieces[1].modelPlacement());
+    CPPUNIT_ASSERT(tilings.insert(tiling).second);
+    solver.require(~pieces[0].selector(tiling.first) | ~pieces[1].selector(tiling.second));
+  }
+  CPPUNIT_ASSERT_EQUAL(4, (int)tilings.size());
+
+  // Leaving a cell uncovered leaves no room for the second piece.
+  MinisatSolver blocked;
+  auto open = [] (int row, int col) { return row != 0 || col != 0; };
+  vector<Placements> fewer;
+  for ( int piece = 0; piece < 2; piece++ ) {
+    fewer.push_back(Placements(&blocked, Pattern("x x ; x . ;"), 2, 3, true, open));
+    blocked.require(fewer.back().exactlyOne());
+  }
+  blocked.require(Placements::cellCoverage(fewer, open));
+  CPPUNIT_ASSERT(!blocked.solve());
+}
+
+void PlacementsTest::testCover(void) {
+  // A domino marks its cells with 1 in a row of Cardinals, and only
+  // those cells.
+  MinisatSolver solver;
+  Matrix<Cardinal> row(&solver, 1, 4, 0, 2);
+  Placements domino(&solver, Pattern("x x ;"), 1, 4);
+  CPPUNIT_ASSERT_EQUAL(3, domino.size());
+  solver.require(domino.exactlyOne());
+  solver.require(domino.cover([&] (int i, int j) -> const Cardinal& { return row[i][j]; }, 1));
+
+  ASSERT_SAT(solver);
+  const Placements::Placement& placed = domino.placement(domino.modelPlacement());
+  for ( int col = 0; col < 4; col++ ) {
+    bool covered = col == placed.cells[0].second || col == placed.cells[1].second;
+    CPPUNIT_ASSERT_EQUAL(covered ? 1 : 0, row[0][col].modelValue());
+  }
+
+  ASSERT_UNSAT_ASSUMP(solver, row[0][0] == 1 & row[0][2] == 1, row);
+  ASSERT_SAT_ASSUMP(solver, row[0][1] == 1 & row[0][2] == 1);
+  ASSERT_UNSAT_ASSUMP(solver, row[0][1] == 1 & row[0][2] == 0 & row[0][0] == 0, row);
+}
@@ -0,0 +1,213 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/matrix.h"
+#include "../src/pseudoboolean.h"
+
+using namespace std;
+
+class PseudoBooleanTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(PseudoBooleanTest);
+  CPPUNIT_TEST(testTrivialBounds);
+  CPPUNIT_TEST(testChooseEncoding);
+  CPPUNIT_TEST(testBDD);
+  CPPUNIT_TEST(testCounter);
+  CPPUNIT_TEST(testAdder);
+  CPPUNIT_TEST(testGreaterEqual);
+  CPPUNIT_TEST(testEquality);
+  CPPUNIT_TEST(testMatrixCosts);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testTrivialBounds(void);
+  void testChooseEncoding(void);
+  void testBDD(void);
+  void testCounter(void);
+  void testAdder(void);
+  void testGreaterEqual(void);
+  void testEquality(void);
+  void testMatrixCosts(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( PseudoBooleanTest );
+
+namespace {
+
+const vector<int> weights = {3, -2, 5, 1, 4, 3};
+
+// Require sum(weights[i]*x_i) (op) bound with a fresh solver, and check
+// the solver agrees with brute force on every assignment of the x_i.
+template<class Op>
+void checkExhaustively(PseudoBoolean::Encoding encoding, int bound, Op op) {
+  MinisatSolver solver;
+  PseudoBoolean sum(&solver, encoding);
+  unsigned int startingVar = solver.newVars(weights.size());
+  for ( int i = 0; i < weights.size(); i++ ) {
+    sum.add(weights[i], Literal(startingVar + i));
+  }
+
+  solver.require(op(sum, bound));
+
+  for ( int assignment = 0; assignment < (1 << weights.size()); assignment++ ) {
+    DualClause assumptions;
+    int value = 0;
+    for ( int i = 0; i < weights.size(); i++ ) {
+      bool isSet = (assignment >> i) & 1;
+      assumptions &= isSet ? Literal(startingVar + i) : ~Literal(startingVar + i);
+      value += isSet ? weights[i] : 0;
+    }
+
+    ostringstream sout;
+    sout << "encoding " << encoding << ", bound " << bound << ", assignment " << assignment;
+    CPPUNIT_ASSERT_EQUAL_MESSAGE(sout.str(), op(value, bound), solver.solve(assumptions));
+  }
+}
+
+template<class Op>
+void checkAllBounds(PseudoBoolean::Encoding encoding, Op op) {
+  for ( int bound = -4; bound <= 17; bound++ ) {
+    checkExhaustively(encoding, bound, op);
+  }
+}
+
+struct AtMost {
+  Requirement operator()(const PseudoBoolean& sum, int bound) { return sum <= bound; }
+  bool operator()(int value, int bound) { return value <= bound; }
+};
+
+struct AtLeast {
+  Requirement operator()(const PseudoBoolean& sum, int bound) { return sum >= bound; }
+  bool operator()(int value, int bound) { return value >= bound; }
+};
+
+struct Equals {
+  Requirement operator()(const PseudoBoolean& sum, int bound) { return sum == bound; }
+  bool operator()(int value, int bound) { return value == bound; }
+};
+
+} // namespace
+
+void PseudoBooleanTest::testTrivialBounds(void) {
+  MockSolver solver;
+  PseudoBoolean sum(&solver);
+  sum.add(2, Literal(solver.newVars(1)));
+  sum.add(3, Literal(solver.newVars(1)));
+
+  // Always satisfied; nothing to require, and no variables allocated.
+  CPPUNIT_ASSERT_EQUAL(Requirement(), sum <= 5);
+  CPPUNIT_ASSERT_EQUAL(2u, solver.newVars(0));
+
+  // Never satisfied.
+  CPPUNIT_ASSERT_EQUAL(Requirement(Clause()), sum <= -1);
+  CPPUNIT_ASSERT_EQUAL(Requirement(Clause()), sum >= 6);
+
+  // Truth and falsity are folded into the constant.
+  sum.add(4, Atom::truth);
+  sum.add(7, Atom::falsity);
+  CPPUNIT_ASSERT_EQUAL(4, sum.constant());
+  CPPUNIT_ASSERT_EQUAL(2u, sum.numTerms());
+  CPPUNIT_ASSERT_EQUAL(Requirement(), sum <= 9);
+}
+
+void PseudoBooleanTest::testChooseEncoding(void) {
+  MockSolver solver;
+
+  // Cardinality constraints (also after dividing out a common factor)
+  PseudoBoolean card(&solver);
+  for ( int i = 0; i < 10; i++ ) {
+    card.add(6, Literal(solver.newVars(1)));
+  }
+  CPPUNIT_ASSERT_EQUAL(PseudoBoolean::sequentialCounter, card.chooseEncoding(20));
+
+  // Few distinct weights
+  PseudoBoolean few(&solver);
+  for ( int i = 0; i < 10; i++ ) {
+    few.add(i % 2 ? 1000 : 3, Literal(solver.newVars(1)));
+  }
+  CPPUNIT_ASSERT_EQUAL(PseudoBoolean::bdd, few.chooseEncoding(2500));
+
+  // Many large, varied weights
+  PseudoBoolean many(&solver);
+  for ( int i = 0; i < 100; i++ ) {
+    many.add(100000 + 7919*i, Literal(solver.newVars(1)));
+  }
+  CPPUNIT_ASSERT_EQUAL(PseudoBoolean::adderNetwork, many.chooseEncoding(5000000));
+}
+
+void PseudoBooleanTest::testBDD(void) {
+  checkAllBounds(PseudoBoolean::bdd, AtMost());
+}
+
+void PseudoBooleanTest::testCounter(void) {
+  checkAllBounds(PseudoBoolean::sequentialCounter, AtMost());
+}
+
+void PseudoBooleanTest::testAdder(void) {
+  checkAllBounds(PseudoBoolean::adderNetwork, AtMost());
+}
+
+void PseudoBooleanTest::testGreaterEqual(void) {
+  checkAllBounds(PseudoBoolean::automatic, AtLeast());
+  checkAllBounds(PseudoBoolean::adderNetwork, AtLeast());
+}
+
+void PseudoBooleanTest::testEquality(void) {
+  checkAllBounds(PseudoBoolean::automatic, Equals());
+}
+
+void PseudoBooleanTest::testMatrixCosts(void) {
+  MinisatSolver solver;
+  Matrix<> matrix(&solver, 2, 2, 0, 3);
+
+  // Cost of a cell is the square of its value
+  PseudoBoolean cost(&solver);
+  cost.addCosts(matrix, [](int value) { return value*value; });
+
+  ASSERT_SAT(solver);
+
+  solver.require(cost == 10);
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(10, cost.modelValue());
+
+  int total = 0;
+  for ( int row = 0; row < 2; row++ ) {
+    for ( int col = 0; col < 2; col++ ) {
+      total += matrix[row][col].modelValue() * matrix[row][col].modelValue();
+    }
+  }
+  CPPUNIT_ASSERT_EQUAL(10, total);
+
+  // 10 = 4 + 4 + 1 + 1 is the only way to make 10 from four squares of
+  // 0, 1 and 2.  So no cell can be 0.
+  ASSERT_UNSAT_ASSUMP(solver, DualClause(matrix[0][0] == 0), matrix);
+  ASSERT_SAT_ASSUMP(solver, DualClause(matrix[0][0] == 1));
+}
@@ -0,0 +1,131 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/sparsecardinal.h"
+#include "../src/graphs.h"
+#include "../src/graphhomomorphism.h"
+#include "../src/quotient.h"
+
+using namespace std;
+
+class QuotientTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(QuotientTest);
+  CPPUNIT_TEST(testCycle);
+  CPPUNIT_TEST(testNoMerges);
+  CPPUNIT_TEST(testDirected);
+  CPPUNIT_TEST(testWideRows);
+  CPPUNIT_TEST(testHomomorphism);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testCycle(void);
+  void testNoMerges(void);
+  void testDirected(void);
+  void testWideRows(void);
+  void testHomomorphism(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( QuotientTest );
+
+namespace {
+  Graph cycle(int order) {
+    return Graph(order, [=] (int src, int dst) {
+	return (src+1) % order == dst || (dst+1) % order == src;
+      });
+  }
+}
+
+void QuotientTest::testCycle(void) {
+  // Opposite vertices of C_4 share their neighbors; the quotient is K_2.
+  NeighborhoodQuotient classes(cycle(4).adjacency());
+
+  CPPUNIT_ASSERT_EQUAL(2, classes.order());
+  CPPUNIT_ASSERT(classes.representatives() == vector<int>({0, 1}));
+  CPPUNIT_ASSERT(classes.members(0) == vector<int>({0, 2}));
+  CPPUNIT_ASSERT(classes.members(1) == vector<int>({1, 3}));
+  CPPUNIT_ASSERT_EQUAL(0, classes.representative(2));
+  CPPUNIT_ASSERT_EQUAL(1, classes.classOf(3));
+  CPPUNIT_ASSERT(classes.lift(vector<int>({1, 0, 1})) == vector<int>({1, 0, 1}));
+
+  const Adjacency& quotient = classes.quotient();
+  CPPUNIT_ASSERT_EQUAL(2, quotient.order());
+  CPPUNIT_ASSERT(quotient.adjacent(0, 1));
+  CPPUNIT_ASSERT(!quotient.adjacent(0, 0));
+
+  CPPUNIT_ASSERT_THROW(classes.lift(2), out_of_range);
+  CPPUNIT_ASSERT_THROW(classes.classOf(4), out_of_range);
+}
+
+void QuotientTest::testNoMerges(void) {
+  NeighborhoodQuotient classes(cycle(5).adjacency());
+  CPPUNIT_ASSERT_EQUAL(5, classes.order());
+  CPPUNIT_ASSERT(classes.quotient().incidences() == cycle(5).adjacency().incidences());
+}
+
+void QuotientTest::testDirected(void) {
+  // 0 and 1 both point at 2, but only 0 is pointed at (by 3).
+  Graph graph(4, [] (int src, int dst) {
+      return (dst == 2 && src < 2) || (src == 3 && dst == 0);
+    });
+  NeighborhoodQuotient classes(graph.adjacency());
+  CPPUNIT_ASSERT_EQUAL(4, classes.order());
+
+  // Without 3 -> 0, they merge.
+  Graph merged(4, [] (int src, int dst) { return dst == 2 && src < 2; });
+  NeighborhoodQuotient mergedClasses(merged.adjacency());
+  CPPUNIT_ASSERT_EQUAL(3, mergedClasses.order());
+  CPPUNIT_ASSERT_EQUAL(0, mergedClasses.representative(1));
+  // 3 is isolated, as 2 has no successors and no one points at 3.
+  CPPUNIT_ASSERT(mergedClasses.members(2) == vector<int>({3}));
+}
+
+void QuotientTest::testWideRows(void) {
+  // The complete bipartite graph K_{70,80} quotients to a single edge.
+  Graph bipartite(150, [] (int src, int dst) { return (src < 70) != (dst < 70); });
+  NeighborhoodQuotient classes(bipartite.adjacency());
+  CPPUNIT_ASSERT_EQUAL(2, classes.order());
+  CPPUNIT_ASSERT_EQUAL(80u, (unsigned int)classes.members(1).size());
+  CPPUNIT_ASSERT_EQUAL(70, classes.lift(1));
+}
+
+void QuotientTest::testHomomorphism(void) {
+  // C_6 is bipartite: it maps into C_4 through representatives alone.
+  NeighborhoodQuotient classes(cycle(4).adjacency());
+  MinisatSolver solver;
+  vector<SparseCardinal> image;
+  for ( int vertex = 0; vertex < 6; vertex++ ) {
+    image.push_back(SparseCardinal(&solver, classes.representatives()));
+  }
+  solver.require(GraphHomomorphism(cycle(4)).graph(cycle(6), image));
+
+  ASSERT_SAT(solver);
+  for ( int vertex = 0; vertex < 6; vertex++ ) {
+    CPPUNIT_ASSERT(cycle(4).hasEdge(image[vertex].modelValue(), image[(vertex+1) % 6].modelValue()));
+  }
+}
@@ -0,0 +1,199 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/cardinal.h"
+#include "../src/matrix.h"
+#include "../src/solutionfile.h"
+
+using namespace std;
+
+class SolutionFileTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(SolutionFileTest);
+  CPPUNIT_TEST(testRoundTrip);
+  CPPUNIT_TEST(testStraddlingCells);
+  CPPUNIT_TEST(testMatrix);
+  CPPUNIT_TEST(testIncomplete);
+  CPPUNIT_TEST(testErrors);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testRoundTrip(void);
+  void testStraddlingCells(void);
+  void testMatrix(void);
+  void testIncomplete(void);
+  void testErrors(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SolutionFileTest );
+
+namespace {
+  // A file in /tmp, removed when the TempFile goes out of scope
+  class TempFile {
+  public:
+    TempFile() {
+      char name[] = "/tmp/solutionfiletestXXXXXX";
+      close(mkstemp(name));
+      mPath = name;
+    }
+    ~TempFile() { remove(mPath.c_str()); }
+    const string& path() const { return mPath; }
+  private:
+    string mPath;
+  };
+
+  string contents(const string& path) {
+    ifstream in(path, ios::binary);
+    ostringstream sout;
+    sout << in.rdbuf();
+    return sout.str();
+  }
+}
+
+void SolutionFileTest::testRoundTrip(void) {
+  TempFile file;
+  {
+    SolutionWriter writer(file.path(), 2, 3, 1);
+    writer.write(vector<int>({1, 0, 1, 0, 0, 1}));
+    writer.writeCells([] (int row, int col) { return (row + col) % 2; });
+    CPPUNIT_ASSERT_EQUAL(2u, writer.numSolutions());
+  }
+
+  SolutionReader reader(file.path());
+  CPPUNIT_ASSERT(reader.complete());
+  CPPUNIT_ASSERT_EQUAL(2, reader.height());
+  CPPUNIT_ASSERT_EQUAL(3, reader.width());
+  CPPUNIT_ASSERT_EQUAL(2u, reader.size());
+  CPPUNIT_ASSERT(reader.solution(0) == vector<int>({1, 0, 1, 0, 0, 1}));
+  CPPUNIT_ASSERT(reader.solution(1) == vector<int>({0, 1, 0, 1, 0, 1}));
+  CPPUNIT_ASSERT_EQUAL(1, reader.at(1, 1, 0));
+
+  ostringstream text;
+  reader.writeText(text, 0);
+  CPPUNIT_ASSERT_EQUAL(string("2 3\n    1 0 1 \n    0 0 1 \n\n\n"), text.str());
+}
+
+void SolutionFileTest::testStraddlingCells(void) {
+  // 5-bit cells cross word boundaries every few cells.
+  TempFile file;
+  const int height = 20;
+  const int width = 50;
+  vector<vector<int> > written;
+  {
+    SolutionWriter writer(file.path(), height, width, 27);
+    for ( int index = 0; index < 100; index++ ) {
+      vector<int> values;
+      for ( int cell = 0; cell < height*width; cell++ ) {
+	values.push_back((cell*7 + index*13) % 28);
+      }
+      writer.write(values);
+      written.push_back(values);
+    }
+  }
+
+  SolutionReader reader(file.path());
+  CPPUNIT_ASSERT_EQUAL(100u, reader.size());
+  for ( unsigned int index = 0; index < 100; index += 7 ) {
+    CPPUNIT_ASSERT(reader.solution(index) == written[index]);
+  }
+  CPPUNIT_ASSERT_EQUAL(written[99][13*width + 12], reader.at(99, 13, 12));
+
+  // 1000 cells of 5 bits: 79 words a record
+  CPPUNIT_ASSERT_EQUAL((size_t)24 + 100*79*8 + 16, contents(file.path()).size());
+}
+
+void SolutionFileTest::testMatrix(void) {
+  MinisatSolver solver;
+  Matrix<> matrix(&solver, 2, 2, 0, 4);
+  solver.require(matrix[0][0] == 3);
+  solver.require(matrix[1][1] == 2);
+  ASSERT_SAT(solver);
+
+  TempFile file;
+  {
+    SolutionWriter writer(file.path(), 2, 2, 3);
+    writer.write(matrix);
+
+    Matrix<> wrongSize(&solver, 1, 2, 0, 4);
+    CPPUNIT_ASSERT_THROW(writer.write(wrongSize), invalid_argument);
+  }
+  SolutionReader reader(file.path());
+  CPPUNIT_ASSERT_EQUAL(1u, reader.size());
+  CPPUNIT_ASSERT_EQUAL(3, reader.at(0, 0, 0));
+  CPPUNIT_ASSERT_EQUAL(matrix[0][1].modelValue(), reader.at(0, 0, 1));
+  CPPUNIT_ASSERT_EQUAL(2, reader.at(0, 1, 1));
+}
+
+void SolutionFileTest::testIncomplete(void) {
+  TempFile file;
+  SolutionWriter writer(file.path(), 3, 3, 2);
+  writer.write(vector<int>(9, 2));
+  writer.write(vector<int>(9, 1));
+
+  // Before close, every written solution is already readable.
+  SolutionReader open(file.path());
+  CPPUNIT_ASSERT(!open.complete());
+  CPPUNIT_ASSERT_EQUAL(2u, open.size());
+  CPPUNIT_ASSERT(open.solution(1) == vector<int>(9, 1));
+
+  // A partial record is dropped.
+  string partial = contents(file.path()) + "abc";
+  istringstream in(partial);
+  SolutionReader truncated(in);
+  CPPUNIT_ASSERT(!truncated.complete());
+  CPPUNIT_ASSERT_EQUAL(2u, truncated.size());
+
+  writer.close();
+  CPPUNIT_ASSERT(SolutionReader(file.path()).complete());
+  CPPUNIT_ASSERT_THROW(writer.write(vector<int>(9, 0)), logic_error);
+}
+
+void SolutionFileTest::testErrors(void) {
+  TempFile file;
+  SolutionWriter writer(file.path(), 2, 2, 3);
+  CPPUNIT_ASSERT_THROW(writer.write(vector<int>({0, 1, 2})), invalid_argument);
+  CPPUNIT_ASSERT_THROW(writer.write(vector<int>({0, 1, 2, 4})), out_of_range);
+  CPPUNIT_ASSERT_THROW(writer.write(vector<int>({0, -1, 2, 3})), out_of_range);
+  CPPUNIT_ASSERT_THROW(SolutionWriter(file.path(), 0, 2, 3), invalid_argument);
+  CPPUNIT_ASSERT_THROW(SolutionWriter(file.path(), -2, 2, 3), invalid_argument);
+  CPPUNIT_ASSERT_THROW(SolutionWriter("/nonexistent/solutions.sltb", 2, 2, 3), runtime_error);
+  writer.close();
+
+  SolutionReader reader(file.path());
+  CPPUNIT_ASSERT_EQUAL(0u, reader.size());
+  CPPUNIT_ASSERT_THROW(reader.solution(0), out_of_range);
+
+  istringstream text("2 2\n    0 1 \n    1 0 \n");
+  CPPUNIT_ASSERT_THROW(SolutionReader reader(text), runtime_error);
+  CPPUNIT_ASSERT_THROW(SolutionReader("/nonexistent/solutions.sltb"), runtime_error);
+}
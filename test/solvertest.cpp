@@ -0,0 +1,146 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/cardinal.h"
+#include "../src/clausebuffer.h"
+
+using namespace std;
+
+class SolverTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(SolverTest);
+  CPPUNIT_TEST(testFixedByUnits);
+  CPPUNIT_TEST(testFolding);
+  CPPUNIT_TEST(testFoldingConflict);
+  CPPUNIT_TEST(testFoldedBuffer);
+  CPPUNIT_TEST(testFoldingOff);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testFixedByUnits(void);
+  void testFolding(void);
+  void testFoldingConflict(void);
+  void testFoldedBuffer(void);
+  void testFoldingOff(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SolverTest );
+
+void SolverTest::testFixedByUnits(void) {
+  MinisatSolver solver;
+  Literal a(solver.newVars(3));
+  Literal b(a.getVar()+1);
+  Literal c(a.getVar()+2);
+
+  CPPUNIT_ASSERT(solver.folding());
+  solver.require(a);
+  solver.require(~b);
+  CPPUNIT_ASSERT(solver.isFixed(a.getVar()));
+  CPPUNIT_ASSERT(solver.fixedValue(a.getVar()));
+  CPPUNIT_ASSERT(solver.isFixed(b.getVar()));
+  CPPUNIT_ASSERT(!solver.fixedValue(b.getVar()));
+  CPPUNIT_ASSERT(!solver.isFixed(c.getVar()));
+  CPPUNIT_ASSERT(!solver.isFixed(1000));
+
+  // A clause left with one free literal fixes it too.
+  solver.require(b | ~c);
+  CPPUNIT_ASSERT(solver.isFixed(c.getVar()));
+  CPPUNIT_ASSERT(!solver.fixedValue(c.getVar()));
+  CPPUNIT_ASSERT_EQUAL(1u, solver.numStrippedLiterals());
+}
+
+void SolverTest::testFolding(void) {
+  MinisatSolver solver;
+  Cardinal card(&solver, 0, 5);
+
+  // Givens first, as in sudoku: the type requirement then mostly folds.
+  solver.require(card == 3);
+  solver.require(card.typeRequirement());
+  CPPUNIT_ASSERT(solver.numDroppedClauses() > 0);
+  CPPUNIT_ASSERT(solver.numStrippedLiterals() > 0);
+  for ( int value = 0; value < 5; value++ ) {
+    CPPUNIT_ASSERT(solver.isFixed((card == value).getLiteral().getVar()));
+  }
+
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(3, card.modelValue());
+  DualClause other = card == 1;
+  ASSERT_UNSAT_ASSUMP(solver, other, card);
+}
+
+void SolverTest::testFoldingConflict(void) {
+  MinisatSolver solver;
+  Literal a(solver.newVars(2));
+  Literal b(a.getVar()+1);
+
+  solver.require(a);
+  solver.require(b);
+  ASSERT_SAT(solver);
+
+  // Every literal false: the clause folds to falsity.
+  Clause clause = ~a | ~b;
+  solver.require(clause);
+  ASSERT_UNSAT(solver, clause);
+}
+
+void SolverTest::testFoldedBuffer(void) {
+  MinisatSolver solver;
+  Literal a(solver.newVars(3));
+  Literal b(a.getVar()+1);
+  Literal c(a.getVar()+2);
+
+  ClauseBuffer buffer;
+  buffer &= Clause(~a);
+  buffer &= a | b;
+  buffer &= a | ~b | c;
+  buffer &= ~a | ~c;
+  solver.require(buffer);
+
+  CPPUNIT_ASSERT(solver.isFixed(b.getVar()));
+  CPPUNIT_ASSERT(solver.isFixed(c.getVar()));
+  CPPUNIT_ASSERT_EQUAL(1u, solver.numDroppedClauses());
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT(!solver.modelValue(a.getVar()));
+  CPPUNIT_ASSERT(solver.modelValue(b.getVar()));
+  CPPUNIT_ASSERT(solver.modelValue(c.getVar()));
+}
+
+void SolverTest::testFoldingOff(void) {
+  MinisatSolver solver;
+  Literal a(solver.newVars(2));
+  Literal b(a.getVar()+1);
+
+  solver.setFolding(false);
+  CPPUNIT_ASSERT(!solver.folding());
+  solver.require(a);
+  solver.require(a | b);
+  CPPUNIT_ASSERT(!solver.isFixed(a.getVar()));
+  CPPUNIT_ASSERT_EQUAL(0u, solver.numDroppedClauses());
+  ASSERT_SAT(solver);
+}
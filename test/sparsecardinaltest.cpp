@@ -0,0 +1,183 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/sparsecardinal.h"
+
+using namespace std;
+
+class SparseCardinalTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(SparseCardinalTest);
+  CPPUNIT_TEST(testIsSparseCardinal);
+  CPPUNIT_TEST(testEqualsValue);
+  CPPUNIT_TEST(testOrdering);
+  CPPUNIT_TEST(testArithmetic);
+  CPPUNIT_TEST(testEqualsSparseCardinal);
+  CPPUNIT_TEST(testNotEqualSparseCardinal);
+  CPPUNIT_TEST(testModelValue);
+  CPPUNIT_TEST(testDomainError);
+  CPPUNIT_TEST(testRequireOutsideDomain);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testIsSparseCardinal(void);
+  void testEqualsValue(void);
+  void testOrdering(void);
+  void testArithmetic(void);
+  void testEqualsSparseCardinal(void);
+  void testNotEqualSparseCardinal(void);
+  void testModelValue(void);
+  void testDomainError(void);
+  void testRequireOutsideDomain(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SparseCardinalTest );
+
+void SparseCardinalTest::testIsSparseCardinal(void) {
+  MockSolver solver;
+  SparseCardinal card(&solver, vector<int>({10, -3, 4, 10}));
+
+  CPPUNIT_ASSERT_EQUAL(3u, card.numLiterals());
+  CPPUNIT_ASSERT_EQUAL(3u, solver.newVars(0));
+  CPPUNIT_ASSERT_EQUAL(-3, card.min());
+  CPPUNIT_ASSERT_EQUAL(11, card.max());
+
+  Requirement expected;
+  expected &= Literal(0) | Literal(1) | Literal(2);
+  expected &= ~Literal(0) | ~Literal(1);
+  expected &= ~Literal(0) | ~Literal(2);
+  expected &= ~Literal(1) | ~Literal(2);
+  CPPUNIT_ASSERT_EQUAL(expected, card.typeRequirement());
+}
+
+void SparseCardinalTest::testEqualsValue(void) {
+  MockSolver solver;
+  SparseCardinal card(&solver, vector<int>({-3, 4, 10}));
+
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(0)), card == -3);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(1)), card == 4);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(2)), card == 10);
+  CPPUNIT_ASSERT_EQUAL(Atom::falsity, card == 0);
+  CPPUNIT_ASSERT_EQUAL(Atom::falsity, card == 11);
+  CPPUNIT_ASSERT_EQUAL(Atom::truth, card != 5);
+  CPPUNIT_ASSERT_EQUAL(Atom(~Literal(1)), 4 != card);
+  CPPUNIT_ASSERT(card.contains(4));
+  CPPUNIT_ASSERT(!card.contains(5));
+}
+
+void SparseCardinalTest::testOrdering(void) {
+  MockSolver solver;
+  SparseCardinal card(&solver, vector<int>({-3, 4, 10}));
+
+  CPPUNIT_ASSERT_EQUAL(Clause(Literal(1) | Literal(2)), card >= 0);
+  CPPUNIT_ASSERT_EQUAL(Clause(Literal(1) | Literal(2)), card > -3);
+  CPPUNIT_ASSERT_EQUAL(Clause(Literal(0) | Literal(1)), card <= 4);
+  CPPUNIT_ASSERT_EQUAL(Clause(Literal(0)), card < 4);
+  CPPUNIT_ASSERT_EQUAL(Clause(), card > 10);
+}
+
+void SparseCardinalTest::testArithmetic(void) {
+  MockSolver solver;
+  SparseCardinal card(&solver, vector<int>({-3, 4, 10}));
+
+  SparseCardinal shifted = card + 2;
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(0)), shifted == -1);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(2)), shifted == 12);
+  CPPUNIT_ASSERT_EQUAL(-1, shifted.min());
+
+  SparseCardinal negated = 1 - card;
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(0)), negated == 4);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(2)), negated == -9);
+  CPPUNIT_ASSERT_EQUAL(-9, negated.min());
+  CPPUNIT_ASSERT_EQUAL(5, negated.max());
+  CPPUNIT_ASSERT(negated.values() == vector<int>({-9, -3, 4}));
+  CPPUNIT_ASSERT_EQUAL(Clause(Literal(1) | Literal(2)), negated < 0);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(1)), -negated == 3);
+  CPPUNIT_ASSERT_EQUAL(3u, solver.newVars(0));
+}
+
+void SparseCardinalTest::testEqualsSparseCardinal(void) {
+  MinisatSolver solver;
+  SparseCardinal lhs(&solver, vector<int>({0, 2, 4, 6}));
+  SparseCardinal rhs(&solver, vector<int>({1, 2, 3, 6, 7}));
+  Requirement equal = lhs == rhs;
+  solver.require(equal);
+
+  ASSERT_SAT_ASSUMP(solver, lhs == 2);
+  CPPUNIT_ASSERT_EQUAL(2, rhs.modelValue());
+  ASSERT_SAT_ASSUMP(solver, rhs == 6);
+  CPPUNIT_ASSERT_EQUAL(6, lhs.modelValue());
+  ASSERT_UNSAT_ASSUMP(solver, lhs == 4, equal);
+  ASSERT_UNSAT_ASSUMP(solver, rhs == 7, equal);
+}
+
+void SparseCardinalTest::testNotEqualSparseCardinal(void) {
+  MockSolver solver;
+  SparseCardinal lhs(&solver, vector<int>({0, 2, 4}));
+  SparseCardinal rhs(&solver, vector<int>({1, 2, 3, 4}));
+
+  Requirement expected;
+  expected &= lhs != 2 | rhs != 2;
+  expected &= lhs != 4 | rhs != 4;
+  CPPUNIT_ASSERT_EQUAL(expected, lhs != rhs);
+}
+
+void SparseCardinalTest::testModelValue(void) {
+  MinisatSolver solver;
+  SparseCardinal card(&solver, vector<int>({-3, 4, 10}));
+  SparseCardinal negated = 5 - card;
+
+  for ( int value : card.values() ) {
+    ASSERT_SAT_ASSUMP(solver, card == value);
+    CPPUNIT_ASSERT_EQUAL(value, card.modelValue());
+    CPPUNIT_ASSERT_EQUAL(5-value, negated.modelValue());
+    CPPUNIT_ASSERT_EQUAL((card == value).getLiteral(), card.currSolnReq());
+  }
+}
+
+void SparseCardinalTest::testDomainError(void) {
+  MockSolver solver;
+  CPPUNIT_ASSERT_THROW(SparseCardinal(&solver, vector<int>()), domain_error);
+}
+
+void SparseCardinalTest::testRequireOutsideDomain(void) {
+  MinisatSolver solver;
+  SparseCardinal card(&solver, vector<int>({0, 2}));
+
+  // Implications from values outside the domain hold trivially.
+  Clause clause = implication(card == 1, card == 2);
+  CPPUNIT_ASSERT_EQUAL(Clause::truth, clause);
+  solver.require(clause);
+  ASSERT_SAT(solver);
+
+  solver.require(card != 1);
+  ASSERT_SAT(solver);
+}
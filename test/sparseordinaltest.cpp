@@ -0,0 +1,168 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/sparseordinal.h"
+
+using namespace std;
+
+class SparseOrdinalTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(SparseOrdinalTest);
+  CPPUNIT_TEST(testIsSparseOrdinal);
+  CPPUNIT_TEST(testLessThanValue);
+  CPPUNIT_TEST(testEqualsValue);
+  CPPUNIT_TEST(testNegation);
+  CPPUNIT_TEST(testOrderingExhaustive);
+  CPPUNIT_TEST(testModelValue);
+  CPPUNIT_TEST(testDomainError);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testIsSparseOrdinal(void);
+  void testLessThanValue(void);
+  void testEqualsValue(void);
+  void testNegation(void);
+  void testOrderingExhaustive(void);
+  void testModelValue(void);
+  void testDomainError(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( SparseOrdinalTest );
+
+void SparseOrdinalTest::testIsSparseOrdinal(void) {
+  MockSolver solver;
+  SparseOrdinal ord(&solver, vector<int>({100, 0, 50, 7}));
+
+  CPPUNIT_ASSERT_EQUAL(3u, ord.numLiterals());
+  CPPUNIT_ASSERT_EQUAL(3u, solver.newVars(0));
+  CPPUNIT_ASSERT_EQUAL(0, ord.min());
+  CPPUNIT_ASSERT_EQUAL(101, ord.max());
+
+  Requirement expected;
+  expected &= implication(Literal(0), Literal(1));
+  expected &= implication(Literal(1), Literal(2));
+  CPPUNIT_ASSERT_EQUAL(expected, ord.typeRequirement());
+}
+
+void SparseOrdinalTest::testLessThanValue(void) {
+  MockSolver solver;
+  SparseOrdinal ord(&solver, vector<int>({0, 7, 50, 100}));
+
+  CPPUNIT_ASSERT_EQUAL(Atom::falsity,     ord < 0);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(0)),  ord <= 0);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(0)),  ord < 7);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(1)),  ord <= 49);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(2)),  ord < 100);
+  CPPUNIT_ASSERT_EQUAL(Atom::truth,       ord <= 100);
+  CPPUNIT_ASSERT_EQUAL(Atom(~Literal(1)), ord >= 8);
+  CPPUNIT_ASSERT_EQUAL(Atom(~Literal(1)), 8 <= ord);
+}
+
+void SparseOrdinalTest::testEqualsValue(void) {
+  MockSolver solver;
+  SparseOrdinal ord(&solver, vector<int>({0, 7, 50, 100}));
+
+  CPPUNIT_ASSERT_EQUAL(DualClause(Literal(0)), ord == 0);
+  CPPUNIT_ASSERT_EQUAL(Literal(1) & ~Literal(0), ord == 7);
+  CPPUNIT_ASSERT_EQUAL(DualClause(~Literal(2)), ord == 100);
+  CPPUNIT_ASSERT_EQUAL(DualClause::falsity, ord == 8);
+}
+
+void SparseOrdinalTest::testNegation(void) {
+  MockSolver solver;
+  SparseOrdinal ord(&solver, vector<int>({0, 7, 50}));
+  SparseOrdinal neg = 10 - ord;
+
+  CPPUNIT_ASSERT_EQUAL(-40, neg.min());
+  CPPUNIT_ASSERT_EQUAL(11, neg.max());
+  CPPUNIT_ASSERT(neg.values() == vector<int>({-40, 3, 10}));
+
+  // neg <= 3 iff ord >= 7
+  CPPUNIT_ASSERT_EQUAL(Atom(~Literal(0)), neg <= 3);
+  CPPUNIT_ASSERT_EQUAL(Atom(~Literal(1)), neg < 3);
+  CPPUNIT_ASSERT_EQUAL(Atom::truth, neg <= 10);
+  CPPUNIT_ASSERT_EQUAL(Atom::falsity, neg < -40);
+  CPPUNIT_ASSERT_EQUAL(Atom(Literal(0)), -neg <= -10);
+}
+
+void SparseOrdinalTest::testOrderingExhaustive(void) {
+  vector<int> lhsValues({-2, 1, 3, 8});
+  vector<int> rhsValues({0, 1, 5, 8, 9});
+
+  // One solver per relation: <=, <, ==, !=
+  for ( int relation = 0; relation < 4; relation++ ) {
+    MinisatSolver solver;
+    SparseOrdinal lhs(&solver, lhsValues);
+    SparseOrdinal rhs(&solver, rhsValues);
+
+    Requirement required =
+      relation == 0 ? lhs <= rhs :
+      relation == 1 ? lhs < rhs :
+      relation == 2 ? lhs == rhs :
+                      lhs != rhs;
+    solver.require(required);
+
+    for ( int a : lhsValues ) {
+      for ( int b : rhsValues ) {
+	bool holds =
+	  relation == 0 ? a <= b :
+	  relation == 1 ? a < b :
+	  relation == 2 ? a == b :
+	                  a != b;
+	DualClause assumptions = (lhs == a) & (rhs == b);
+	if ( holds ) {
+	  ASSERT_SAT_ASSUMP(solver, assumptions);
+	  CPPUNIT_ASSERT_EQUAL(a, lhs.modelValue());
+	  CPPUNIT_ASSERT_EQUAL(b, rhs.modelValue());
+	} else {
+	  ASSERT_UNSAT_ASSUMP(solver, assumptions, required);
+	}
+      }
+    }
+  }
+}
+
+void SparseOrdinalTest::testModelValue(void) {
+  MinisatSolver solver;
+  SparseOrdinal ord(&solver, vector<int>({0, 7, 50, 100}));
+  SparseOrdinal neg = -ord + 1;
+
+  for ( int value : ord.values() ) {
+    ASSERT_SAT_ASSUMP(solver, ord == value);
+    CPPUNIT_ASSERT_EQUAL(value, ord.modelValue());
+    CPPUNIT_ASSERT_EQUAL(1-value, neg.modelValue());
+  }
+}
+
+void SparseOrdinalTest::testDomainError(void) {
+  MockSolver solver;
+  CPPUNIT_ASSERT_THROW(SparseOrdinal(&solver, vector<int>()), domain_error);
+}
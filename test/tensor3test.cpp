@@ -0,0 +1,212 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/matrix.h"
+#include "../src/matrixview.h"
+#include "../src/tensor3.h"
+
+using namespace std;
+
+class Tensor3Test : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(Tensor3Test);
+  CPPUNIT_TEST(testContiguous);
+  CPPUNIT_TEST(testSlices);
+  CPPUNIT_TEST(testPermute);
+  CPPUNIT_TEST(testReflect);
+  CPPUNIT_TEST(testLayerEquality);
+  CPPUNIT_TEST(testModelValues);
+  CPPUNIT_TEST(testOutOfRange);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testContiguous(void);
+  void testSlices(void);
+  void testPermute(void);
+  void testReflect(void);
+  void testLayerEquality(void);
+  void testModelValues(void);
+  void testOutOfRange(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( Tensor3Test );
+
+void Tensor3Test::testContiguous(void) {
+  MockSolver tensorSolver;
+  MockSolver matrixSolver;
+  Tensor3<> tensor(&tensorSolver, 2, 3, 4, 0, 3);
+  Matrix<> matrix(&matrixSolver, 6, 4, 0, 3);
+
+  // Layers are stacked rows of one Matrix.
+  CPPUNIT_ASSERT_EQUAL(2u, tensor.depth());
+  CPPUNIT_ASSERT_EQUAL(3u, tensor.height());
+  CPPUNIT_ASSERT_EQUAL(4u, tensor.width());
+  CPPUNIT_ASSERT_EQUAL(matrix.numLiterals(), tensor.numLiterals());
+  CPPUNIT_ASSERT_EQUAL(matrixSolver.newVars(0), tensorSolver.newVars(0));
+  CPPUNIT_ASSERT_EQUAL(matrix.typeRequirement(), tensor.typeRequirement());
+  CPPUNIT_ASSERT_EQUAL(matrix[4][2] == 1, tensor.at(1, 1, 2) == 1);
+}
+
+void Tensor3Test::testSlices(void) {
+  MockSolver solver;
+  Tensor3<> tensor(&solver, 2, 3, 4, 0, 3);
+
+  MatrixView<> layer = tensor[1];
+  CPPUNIT_ASSERT_EQUAL(3u, layer.height());
+  CPPUNIT_ASSERT_EQUAL(4u, layer.width());
+  MatrixView<> rows = tensor.slice(1, 2);
+  CPPUNIT_ASSERT_EQUAL(2u, rows.height());
+  CPPUNIT_ASSERT_EQUAL(4u, rows.width());
+  MatrixView<> cols = tensor.slice(2, 3);
+  CPPUNIT_ASSERT_EQUAL(2u, cols.height());
+  CPPUNIT_ASSERT_EQUAL(3u, cols.width());
+
+  for ( int k = 0; k < 2; k++ ) {
+    for ( int i = 0; i < 3; i++ ) {
+      for ( int j = 0; j < 4; j++ ) {
+	CPPUNIT_ASSERT_EQUAL(tensor.at(k, i, j) == 2, tensor[k][i][j] == 2);
+	CPPUNIT_ASSERT_EQUAL(tensor.at(k, i, j) == 2, tensor.slice(1, i)[k][j] == 2);
+	CPPUNIT_ASSERT_EQUAL(tensor.at(k, i, j) == 2, tensor.slice(2, j)[k][i] == 2);
+      }
+    }
+  }
+
+  // Slices are ordinary views.
+  MatrixView<> turned = tensor.slice(2, 1).transpose();
+  CPPUNIT_ASSERT_EQUAL(tensor.at(1, 2, 1) == 0, turned[2][1] == 0);
+}
+
+void Tensor3Test::testPermute(void) {
+  MockSolver solver;
+  Tensor3<> tensor(&solver, 2, 3, 4, 0, 3);
+
+  Tensor3View<> permuted = tensor.permute(2, 0, 1);
+  CPPUNIT_ASSERT_EQUAL(4u, permuted.depth());
+  CPPUNIT_ASSERT_EQUAL(2u, permuted.height());
+  CPPUNIT_ASSERT_EQUAL(3u, permuted.width());
+  for ( int k = 0; k < 2; k++ ) {
+    for ( int i = 0; i < 3; i++ ) {
+      for ( int j = 0; j < 4; j++ ) {
+	CPPUNIT_ASSERT_EQUAL(tensor.at(k, i, j) == 1, permuted.at(j, k, i) == 1);
+	CPPUNIT_ASSERT_EQUAL(tensor.at(k, i, j) == 1, permuted[j][k][i] == 1);
+      }
+    }
+  }
+
+  // Permutations compose.
+  Tensor3View<> back = permuted.permute(1, 2, 0);
+  CPPUNIT_ASSERT_EQUAL(tensor.at(1, 2, 3) == 1, back.at(1, 2, 3) == 1);
+
+  CPPUNIT_ASSERT_THROW(tensor.permute(0, 0, 1), invalid_argument);
+  CPPUNIT_ASSERT_THROW(tensor.permute(0, 1, 3), invalid_argument);
+}
+
+void Tensor3Test::testReflect(void) {
+  MockSolver solver;
+  Tensor3<> tensor(&solver, 2, 3, 4, 0, 3);
+
+  Tensor3View<> reflected = tensor.reflect(0).reflect(2);
+  for ( int k = 0; k < 2; k++ ) {
+    for ( int i = 0; i < 3; i++ ) {
+      for ( int j = 0; j < 4; j++ ) {
+	CPPUNIT_ASSERT_EQUAL(tensor.at(k, i, j) == 1, reflected.at(1-k, i, 3-j) == 1);
+      }
+    }
+  }
+
+  // Reflection after permutation acts on the permuted axis.
+  Tensor3View<> mixed = tensor.permute(1, 2, 0).reflect(0);
+  CPPUNIT_ASSERT_EQUAL(tensor.at(1, 0, 3) == 1, mixed.at(2, 3, 1) == 1);
+  CPPUNIT_ASSERT_EQUAL(tensor.at(1, 0, 3) == 1, mixed.slice(2, 1)[2][3] == 1);
+}
+
+void Tensor3Test::testLayerEquality(void) {
+  MinisatSolver solver;
+  Tensor3<> tensor(&solver, 3, 2, 2, 0, 3);
+
+  // Layer 1 copies layer 0, and layer 2 mirrors it.
+  solver.require(tensor[1] == tensor[0]);
+  solver.require(tensor.slice(0, 2) == tensor[0].reflectH());
+  solver.require(tensor.at(0, 0, 0) == 1);
+  solver.require(tensor.at(0, 0, 1) == 2);
+
+  ASSERT_SAT(solver);
+  CPPUNIT_ASSERT_EQUAL(1, tensor.at(1, 0, 0).modelValue());
+  CPPUNIT_ASSERT_EQUAL(2, tensor.at(1, 0, 1).modelValue());
+  CPPUNIT_ASSERT_EQUAL(2, tensor.at(2, 0, 0).modelValue());
+  CPPUNIT_ASSERT_EQUAL(1, tensor.at(2, 0, 1).modelValue());
+
+  // Whole views compare too.
+  Requirement symmetric = tensor.view() == tensor.reflect(0);
+  solver.require(symmetric);
+  ASSERT_UNSAT(solver, symmetric);
+}
+
+void Tensor3Test::testModelValues(void) {
+  MinisatSolver solver;
+  Tensor3<> tensor(&solver, 2, 2, 3, 0, 6);
+
+  for ( int k = 0; k < 2; k++ ) {
+    for ( int i = 0; i < 2; i++ ) {
+      for ( int j = 0; j < 3; j++ ) {
+	solver.require(tensor.at(k, i, j) == (k*6 + i*3 + j) % 6);
+      }
+    }
+  }
+  ASSERT_SAT(solver);
+
+  vector<int> values = tensor.modelValues();
+  CPPUNIT_ASSERT_EQUAL((size_t)12, values.size());
+  for ( int index = 0; index < 12; index++ ) {
+    CPPUNIT_ASSERT_EQUAL(index % 6, values[index]);
+  }
+
+  // A view decodes in its own order.
+  vector<int> permuted = tensor.permute(2, 1, 0).modelValues();
+  CPPUNIT_ASSERT_EQUAL((size_t)12, permuted.size());
+  CPPUNIT_ASSERT_EQUAL(tensor.at(1, 0, 0).modelValue(), permuted[1]);
+  CPPUNIT_ASSERT_EQUAL(tensor.at(0, 1, 2).modelValue(), permuted[10]);
+}
+
+void Tensor3Test::testOutOfRange(void) {
+  MockSolver solver;
+  Tensor3<> tensor(&solver, 2, 3, 4, 0, 3);
+
+  CPPUNIT_ASSERT_THROW(tensor.at(2, 0, 0), out_of_range);
+  CPPUNIT_ASSERT_THROW(tensor.at(0, -1, 0), out_of_range);
+  CPPUNIT_ASSERT_THROW(tensor.at(0, 0, 4), out_of_range);
+  CPPUNIT_ASSERT_THROW(tensor[2], out_of_range);
+  CPPUNIT_ASSERT_THROW(tensor.slice(2, 4), out_of_range);
+  CPPUNIT_ASSERT_THROW(tensor.slice(3, 0), invalid_argument);
+  CPPUNIT_ASSERT_THROW(tensor.reflect(-1), invalid_argument);
+  CPPUNIT_ASSERT_THROW(tensor.permute(1, 0, 2).at(3, 0, 0), out_of_range);
+  CPPUNIT_ASSERT_THROW(Tensor3<>(&solver, -1, -1, 3, 0, 3), invalid_argument);
+}
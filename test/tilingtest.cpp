@@ -0,0 +1,171 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+//
+// Unit tests for Tiling.
+
+#include <set>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include "../src/minisatsolver.h"
+#include "../src/placements.h"
+#include "../src/tiling.h"
+
+using namespace std;
+
+class TilingTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(TilingTest);
+  CPPUNIT_TEST(testDominoes);
+  CPPUNIT_TEST(testLabels);
+  CPPUNIT_TEST(testOpenCells);
+  CPPUNIT_TEST(testTetrominoes);
+  CPPUNIT_TEST(testAgainstSat);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testDominoes(void);
+  void testLabels(void);
+  void testOpenCells(void);
+  void testTetrominoes(void);
+  void testAgainstSat(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( TilingTest );
+
+void TilingTest::testDominoes(void) {
+  // A 2 x n strip has Fibonacci(n+1) domino tilings; with n
+  // distinguishable dominoes, n! times as many.
+  vector<Pattern> dominoes(4, Pattern("x x ;"));
+  Tiling tiling(dominoes, 2, 4);
+  CPPUNIT_ASSERT_EQUAL(4, tiling.numPieces());
+  CPPUNIT_ASSERT_EQUAL(4 + 8, tiling.problem().numColumns());
+  CPPUNIT_ASSERT_EQUAL(4*10, tiling.problem().numRows());
+  CPPUNIT_ASSERT_EQUAL(5ul*24, tiling.problem().count());
+}
+
+void TilingTest::testLabels(void) {
+  Tiling tiling(vector<Pattern>({ Pattern("x x ; x . ;"), Pattern("x x ; x . ;") }), 2, 3);
+  vector<vector<int> > found = tiling.problem().solutions();
+  CPPUNIT_ASSERT_EQUAL(4, (int)found.size());
+
+  for ( auto& rows : found ) {
+    Array2d<int> labels = tiling.labels(rows);
+    int count[2] = {0, 0};
+    for ( int row = 0; row < 2; row++ ) {
+      for ( int col = 0; col < 3; col++ ) {
+	CPPUNIT_ASSERT(labels[row][col] == 0 || labels[row][col] == 1);
+	count[labels[row][col]]++;
+      }
+    }
+    CPPUNIT_ASSERT_EQUAL(3, count[0]);
+    CPPUNIT_ASSERT_EQUAL(3, count[1]);
+    for ( int row : rows ) {
+      for ( auto cell : tiling.placement(row).cells ) {
+	CPPUNIT_ASSERT_EQUAL(tiling.piece(row), labels[cell.first][cell.second]);
+      }
+    }
+  }
+}
+
+void TilingTest::testOpenCells(void) {
+  // A 3 x 3 square with its center removed is a ring of 8 cells, which
+  // 4 identical dominoes cover in 2 ways (times 4! labelings).
+  auto open = [] (int row, int col) { return row != 1 || col != 1; };
+  Tiling tiling(vector<Pattern>(4, Pattern("x x ;")), 3, 3, true, open);
+  CPPUNIT_ASSERT_EQUAL(4 + 8, tiling.problem().numColumns());
+  CPPUNIT_ASSERT_EQUAL(2ul*24, tiling.problem().count());
+
+  vector<vector<int> > found = tiling.problem().solutions();
+  CPPUNIT_ASSERT_EQUAL(-1, tiling.labels(found.front())[1][1]);
+}
+
+void TilingTest::testTetrominoes(void) {
+  // The tetrominoes scenario: two of each free tetromino on 5 x 8.
+  // Every solution is a 5 x 8 tiling; boxes, tees and skews are
+  // interchangeable in pairs, so the count is a multiple of 2^5.
+  const char* shapes[] = { "x x ; x x ;", "x x x ; . x . ;", "x x x x ;", "x x x ; x . . ;", "x x . ; . x x ;" };
+  vector<Pattern> pieces;
+  for ( int piece = 0; piece < 10; piece++ ) {
+    pieces.push_back(Pattern(shapes[piece/2]));
+  }
+  Tiling tiling(pieces, 5, 8);
+
+  unsigned long count = tiling.problem().count(0);
+  CPPUNIT_ASSERT(count > 0);
+  CPPUNIT_ASSERT_EQUAL(0ul, count % 32);
+
+  int numChecked = 0;
+  tiling.problem().solve([&] (const vector<int>& rows) {
+      CPPUNIT_ASSERT_EQUAL(10, (int)rows.size());
+      Array2d<int> labels = tiling.labels(rows);
+      for ( int row = 0; row < 5; row++ ) {
+	for ( int col = 0; col < 8; col++ ) {
+	  CPPUNIT_ASSERT(0 <= labels[row][col] && labels[row][col] < 10);
+	}
+      }
+      return ++numChecked < 20;
+    });
+  CPPUNIT_ASSERT_EQUAL(20, numChecked);
+}
+
+void TilingTest::testAgainstSat(void) {
+  // The same tilings as enumerating SAT solutions over Placements
+  const Pattern ell("x x ; x . ;");
+  Tiling tiling(vector<Pattern>(4, ell), 3, 4);
+  set<vector<int> > byCover;
+  for ( auto& rows : tiling.problem().solutions() ) {
+    Array2d<int> labels = tiling.labels(rows);
+    vector<int> cells;
+    for ( int row = 0; row < 3; row++ ) {
+      for ( int col = 0; col < 4; col++ ) {
+	cells.push_back(labels[row][col]);
+      }
+    }
+    byCover.insert(cells);
+  }
+
+  MinisatSolver solver;
+  vector<Placements> pieces;
+  for ( int piece = 0; piece < 4; piece++ ) {
+    pieces.push_back(Placements(&solver, ell, 3, 4));
+    solver.require(pieces.back().exactlyOne());
+  }
+  solver.require(Placements::cellCoverage(pieces));
+  set<vector<int> > bySat;
+  while ( solver.solve() ) {
+    vector<int> cells(12, -1);
+    Clause different;
+    for ( int piece = 0; piece < 4; piece++ ) {
+      int chosen = pieces[piece].modelPlacement();
+      for ( auto cell : pieces[piece].placement(chosen).cells ) {
+	cells[cell.first*4 + cell.second] = piece;
+      }
+      different |= ~pieces[piece].selector(chosen);
+    }
+    bySat.insert(cells);
+    solver.require(different);
+  }
+
+  CPPUNIT_ASSERT(!byCover.empty());
+  CPPUNIT_ASSERT(byCover == bySat);
+}
@@ -0,0 +1,187 @@
+// -*- Mode: C++ -*-
+////////////////////////////////////////////////////////////////////////////
+//
+//  satcolors -- for writably and readably building problems for SAT-solving
+//  Copyright (C) 2014 Edward W. Krohne III
+//
+//  The research that led to this product was partially supported by the
+//  U.S. NSF grants DMS-0943870 and DMS-1201290.
+//
+//  This program is free software: you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License as published by
+//  the Free Software Foundation, either version 3 of the License, or
+//  (at your option) any later version.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+//
+////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <sstream>
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <stdexcept>
+#include "mocksolver.h"
+#include "testglue.h"
+#include "../src/minisatsolver.h"
+#include "../src/cardinal.h"
+#include "../src/sparsecardinal.h"
+#include "../src/matrix.h"
+#include "../src/matrixview.h"
+#include "../src/windowrule.h"
+
+using namespace std;
+
+class WindowRuleTest : public CPPUNIT_NS::TestFixture {
+  CPPUNIT_TEST_SUITE(WindowRuleTest);
+  CPPUNIT_TEST(testPairClauses);
+  CPPUNIT_TEST(testStamp);
+  CPPUNIT_TEST(testViews);
+  CPPUNIT_TEST(testSparseDomains);
+  CPPUNIT_TEST(testLargeWindow);
+  CPPUNIT_TEST(testErrors);
+  CPPUNIT_TEST_SUITE_END();
+protected:
+  void testPairClauses(void);
+  void testStamp(void);
+  void testViews(void);
+  void testSparseDomains(void);
+  void testLargeWindow(void);
+  void testErrors(void);
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION( WindowRuleTest );
+
+namespace {
+  const vector<int> threeValues = {0, 1, 2};
+
+  bool differ(int lhs, int rhs) {
+    return lhs != rhs;
+  }
+}
+
+void WindowRuleTest::testPairClauses(void) {
+  MockSolver solver;
+  Matrix<> matrix(&solver, 1, 2, 0, 3);
+  WindowRule rule = WindowRule::horizontal(threeValues, differ);
+
+  // The support clauses, written out by hand
+  Requirement expected;
+  for ( int value = 0; value < 3; value++ ) {
+    Clause right = ~(matrix[0][0] == value);
+    Clause left  = ~(matrix[0][1] == value);
+    for ( int other = 0; other < 3; other++ ) {
+      if ( other != value ) {
+	right |= matrix[0][1] == other;
+	left  |= matrix[0][0] == other;
+      }
+    }
+    expected &= right;
+    expected &= left;
+  }
+
+  CPPUNIT_ASSERT_EQUAL(1, rule.height());
+  CPPUNIT_ASSERT_EQUAL(2, rule.width());
+  CPPUNIT_ASSERT_EQUAL(6u, rule.numClauses());
+  CPPUNIT_ASSERT_EQUAL(expected, rule.stamp(matrix));
+
+  // Values compatible with everything need no clauses.
+  WindowRule anything = WindowRule::vertical(threeValues, [] (int top, int bottom) { return true; });
+  CPPUNIT_ASSERT_EQUAL(0u, anything.numClauses());
+}
+
+void WindowRuleTest::testStamp(void) {
+  MockSolver solver;
+  Matrix<> matrix(&solver, 3, 4, 0, 3);
+  WindowRule rule = WindowRule::horizontal(threeValues, differ);
+
+  Requirement expected;
+  for ( int row = 0; row < 3; row++ ) {
+    for ( int col = 0; col < 3; col++ ) {
+      expected &= rule.apply([&] (int i, int j) { return matrix[i][j]; }, row, col);
+    }
+  }
+  Requirement stamped = rule.stamp(matrix);
+  CPPUNIT_ASSERT_EQUAL(expected, stamped);
+  CPPUNIT_ASSERT_EQUAL(rule.numClauses()*9, (unsigned int)stamped.size());
+
+  // Windows that don't fit place nothing.
+  Matrix<> narrow(&solver, 3, 1, 0, 3);
+  CPPUNIT_ASSERT_EQUAL(Requirement(), rule.stamp(narrow));
+}
+
+void WindowRuleTest::testViews(void) {
+  MockSolver solver;
+  Matrix<> matrix(&solver, 3, 4, 0, 3);
+  auto lessThan = [] (int lhs, int rhs) { return lhs < rhs; };
+
+  // A horizontal rule on the transpose is a vertical rule on the matrix.
+  CPPUNIT_ASSERT_EQUAL(WindowRule::vertical(threeValues, lessThan).stamp(matrix), 
+		       WindowRule::horizontal(threeValues, lessThan).stamp(matrix.transpose()));
+
+  // A stamp through an accessor
+  Requirement byAccessor = WindowRule::horizontal(threeValues, lessThan).stamp([&] (int row, int col) { 
+      return matrix[2-row][col]; 
+    }, 3, 4);
+  CPPUNIT_ASSERT_EQUAL(WindowRule::horizontal(threeValues, lessThan).stamp(matrix.reflectV()), byAccessor);
+}
+
+void WindowRuleTest::testSparseDomains(void) {
+  MinisatSolver solver;
+  Matrix<SparseCardinal> matrix(&solver, 2, 3, [] (int row, int col) {
+      return row == 0 ? vector<int>({0, 2}) : vector<int>({1, 2, 3});
+    });
+
+  // Vertical neighbors differ by exactly one.
+  vector<int> values = {0, 1, 2, 3};
+  solver.require(WindowRule::vertical(values, [] (int top, int bottom) {
+	return top - bottom == 1 || bottom - top == 1;
+      }).stamp(matrix));
+  solver.require(matrix[0][1] == 0);
+
+  ASSERT_SAT(solver);
+  for ( int col = 0; col < 3; col++ ) {
+    int top = matrix[0][col].modelValue();
+    int bottom = matrix[1][col].modelValue();
+    CPPUNIT_ASSERT(top - bottom == 1 || bottom - top == 1);
+  }
+  CPPUNIT_ASSERT_EQUAL(1, matrix[1][1].modelValue());
+}
+
+void WindowRuleTest::testLargeWindow(void) {
+  MinisatSolver solver;
+  Matrix<> matrix(&solver, 3, 4, 0, 2);
+
+  // Each 2 x 2 window holds exactly two ones.
+  WindowRule rule(2, 2, {0, 1}, [] (const vector<int>& cells) {
+      return cells[0] + cells[1] + cells[2] + cells[3] == 2;
+    });
+  CPPUNIT_ASSERT_EQUAL(10u, rule.numClauses());
+  solver.require(rule.stamp(matrix));
+
+  ASSERT_SAT(solver);
+  for ( int row = 0; row < 2; row++ ) {
+    for ( int col = 0; col < 3; col++ ) {
+      CPPUNIT_ASSERT_EQUAL(2, matrix[row][col].modelValue() + matrix[row][col+1].modelValue() + 
+			   matrix[row+1][col].modelValue() + matrix[row+1][col+1].modelValue());
+    }
+  }
+
+  // Three ones in a window are impossible.
+  DualClause threeOnes = (matrix[0][0] == 1) & (matrix[0][1] == 1) & (matrix[1][0] == 1);
+  ASSERT_UNSAT_ASSUMP(solver, threeOnes, matrix);
+}
+
+void WindowRuleTest::testErrors(void) {
+  CPPUNIT_ASSERT_THROW(WindowRule(0, 2, threeValues, [] (const vector<int>&) { return true; }), 
+		       invalid_argument);
+  CPPUNIT_ASSERT_THROW(WindowRule(2, -1, threeValues, [] (const vector<int>&) { return true; }), 
+		       invalid_argument);
+}
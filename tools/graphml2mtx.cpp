@@ -0,0 +1,50 @@
+// graphml2mtx.cpp
+//
+// Converts a GraphML file into the incidence matrix (.mtx, or binary
+// .mtxb) and palette (.palette) files read by the scenarios.  The
+// palette is optional.
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "../src/adjacency.h"
+#include "../src/graphml.h"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+  if ( argc < 3 ) {
+    cerr << "Insufficient arguments." << endl;
+    cerr << argv[0] << " <graphml file> <incidence matrix file> [palette file]" << endl;
+    return 2;
+  }
+
+  ifstream fin(argv[1]);
+  if ( !fin ) {
+    cerr << "Cannot open " << argv[1] << endl;
+    return 1;
+  }
+
+  try {
+    GraphML graph(fin);
+    string matrixPath(argv[2]);
+    const string binarySuffix(".mtxb");
+    if ( matrixPath.size() >= binarySuffix.size() && 
+	 matrixPath.compare(matrixPath.size() - binarySuffix.size(), binarySuffix.size(), binarySuffix) == 0 ) {
+      ofstream matrixOut(matrixPath, ios::binary);
+      Adjacency(graph.incidences()).write(matrixOut);
+    } else {
+      ofstream matrixOut(matrixPath);
+      graph.writeMatrix(matrixOut);
+    }
+    if ( argc > 3 ) {
+      ofstream paletteOut(argv[3]);
+      graph.writePalette(paletteOut);
+    }
+  } catch ( const runtime_error& e ) {
+    cerr << argv[1] << ": " << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}
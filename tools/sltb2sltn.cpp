@@ -0,0 +1,36 @@
+// sltb2sltn.cpp
+//
+// Converts a binary solution file (.sltb) into the text format (.sltn)
+// read by python/visualize.py.
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include "../src/solutionfile.h"
+
+using namespace std;
+
+int main(int argc, char** argv) {
+  if ( argc < 3 ) {
+    cerr << "Insufficient arguments." << endl;
+    cerr << argv[0] << " <binary solution file> <text solution file>" << endl;
+    return 2;
+  }
+
+  try {
+    SolutionReader solutions(argv[1]);
+    if ( !solutions.complete() ) {
+      cerr << argv[1] << ": not closed properly; converting its " 
+	   << solutions.size() << " complete solutions" << endl;
+    }
+    ofstream fout(argv[2]);
+    for ( unsigned int index = 0; index < solutions.size(); index++ ) {
+      solutions.writeText(fout, index);
+    }
+  } catch ( const runtime_error& e ) {
+    cerr << e.what() << endl;
+    return 1;
+  }
+
+  return 0;
+}